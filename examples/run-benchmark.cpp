@@ -0,0 +1,953 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Microbenchmarks for the performance sensitive parts of the audio processing
+// module. Run without arguments to run all the benchmarks, or pass the names
+// of the benchmarks to run.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "common_audio/signal_processing/include/real_fft.h"
+}
+#include "api/audio/echo_canceller3_config.h"
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/comfort_noise_generator.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/fft_matched_filter.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "modules/audio_processing/aecm/aecm_core.h"
+#include "modules/audio_processing/aecm/echo_control_mobile.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/limiter.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_control_impl.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "modules/audio_processing/utility/multi_channel_cascaded_biquad_filter.h"
+#include "modules/audio_processing/utility/real_fft.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "system_wrappers/include/field_trial.h"
+
+namespace {
+
+// Runs `f` `iterations` times and reports the average time per iteration, or
+// per item if each iteration processes `items_per_iteration` items.
+template <typename F>
+void Measure(const std::string& label, int iterations, F f,
+	     size_t items_per_iteration = 1) {
+    // Warm up caches and lazily initialized state.
+    for (int i = 0; i < iterations / 10 + 1; ++i)
+	f();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+	f();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns =
+	std::chrono::duration<double, std::nano>(end - start).count() /
+	iterations / items_per_iteration;
+    std::cout << "  " << label << ": " << ns << " ns" << std::endl;
+}
+
+void FillWithNoise(std::vector<float>& v) {
+    unsigned int seed = 42;
+    for (float& x : v) {
+	seed = seed * 1103515245u + 12345u;
+	x = static_cast<float>(static_cast<int>(seed >> 16) % 32768 - 16384);
+    }
+}
+
+// Per-block cost of the forward and inverse real FFTs used by AEC3 (128
+// points) and NS (256 points), for each backend and in batches of channels.
+// The input is restored before each transform, which is included in the
+// reported times.
+void BenchmarkFft() {
+    using webrtc::RealFft;
+    const struct {
+	RealFft::Backend backend;
+	const char* name;
+    } kBackends[] = {
+	{RealFft::Backend::kOoura, "ooura"},
+	{RealFft::Backend::kPffft, "pffft"},
+    };
+    constexpr int kIterations = 200000;
+    constexpr size_t kNumChannels = 8;
+
+    for (size_t fft_size : {128, 256}) {
+	for (const auto& b : kBackends) {
+	    auto fft = RealFft::Create(fft_size, b.backend);
+	    std::vector<float> input(fft_size * kNumChannels);
+	    FillWithNoise(input);
+	    std::vector<float> x = input;
+	    std::vector<float*> channels(kNumChannels);
+	    for (size_t ch = 0; ch < kNumChannels; ++ch)
+		channels[ch] = &x[ch * fft_size];
+	    rtc::ArrayView<float> x0(x.data(), fft_size);
+
+	    const std::string prefix =
+		std::string(b.name) + " " + std::to_string(fft_size);
+	    Measure(prefix + " forward", kIterations, [&] {
+		std::copy(input.begin(), input.begin() + fft_size, x.begin());
+		fft->Forward(x0);
+	    });
+	    Measure(prefix + " inverse", kIterations, [&] {
+		std::copy(input.begin(), input.begin() + fft_size, x.begin());
+		fft->Inverse(x0);
+	    });
+	    Measure(prefix + " forward x" + std::to_string(kNumChannels) +
+			" batched",
+		    kIterations / kNumChannels, [&] {
+		std::copy(input.begin(), input.end(), x.begin());
+		fft->ForwardBatch(channels);
+	    });
+	}
+    }
+}
+
+// Per-frame cost of the adaptive digital AGC1 analysis and gain application
+// on a band split 48 kHz stereo frame, for the float and the fixed-point
+// digital gain computations. The split bands are restored before each frame,
+// which is included in the reported times.
+void BenchmarkAgc1() {
+    const struct {
+	const char* trials;
+	const char* name;
+    } kPaths[] = {
+	{"", "float"},
+	{"WebRTC-Agc1FloatDigitalPathKillSwitch/Enabled/", "fixed"},
+    };
+    constexpr int kSampleRateHz = 48000;
+    constexpr size_t kNumChannels = 2;
+    constexpr size_t kFrameSize = kSampleRateHz / 100;
+    constexpr int kIterations = 100000;
+
+    std::vector<float> input(kFrameSize * kNumChannels);
+    FillWithNoise(input);
+    for (float& x : input)
+	x /= 32768.f;
+    std::vector<const float*> channels(kNumChannels);
+    for (size_t ch = 0; ch < kNumChannels; ++ch)
+	channels[ch] = &input[ch * kFrameSize];
+
+    webrtc::AudioBuffer audio(kSampleRateHz, kNumChannels, kSampleRateHz,
+			      kNumChannels, kSampleRateHz, kNumChannels);
+    audio.CopyFrom(channels.data(),
+		   webrtc::StreamConfig(kSampleRateHz, kNumChannels));
+    audio.SplitIntoFrequencyBands();
+    std::vector<std::vector<float>> bands;
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+	for (size_t b = 0; b < audio.num_bands(); ++b) {
+	    const float* band = audio.split_bands_const(ch)[b];
+	    bands.emplace_back(band, band + audio.num_frames_per_band());
+	}
+    }
+
+    for (const auto& path : kPaths) {
+	webrtc::field_trial::InitFieldTrialsFromString(path.trials);
+	webrtc::GainControlImpl agc;
+	agc.Initialize(kNumChannels, kSampleRateHz);
+	agc.set_mode(webrtc::GainControl::kAdaptiveDigital);
+	Measure(path.name, kIterations, [&] {
+	    for (size_t ch = 0, i = 0; ch < kNumChannels; ++ch) {
+		for (size_t b = 0; b < audio.num_bands(); ++b, ++i) {
+		    std::copy(bands[i].begin(), bands[i].end(),
+			      audio.split_bands(ch)[b]);
+		}
+	    }
+	    agc.AnalyzeCaptureAudio(audio);
+	    agc.ProcessCaptureAudio(&audio, /*stream_has_echo=*/false);
+	});
+    }
+    webrtc::field_trial::InitFieldTrialsFromString("");
+}
+
+// Per-block cost of the AECM channel kernels for each available
+// implementation, and of the fixed-point real FFT used by AECM. The outputs of
+// the optimized kernels are checked against the generic ones.
+void BenchmarkAecm() {
+    const struct {
+	const char* name;
+	bool available;
+	webrtc::CalcLinearEnergies calc_linear_energies;
+	webrtc::StoreAdaptiveChannel store_adaptive_channel;
+	webrtc::ResetAdaptiveChannel reset_adaptive_channel;
+    } kImplementations[] = {
+	{"c", true, webrtc::WebRtcAecm_CalcLinearEnergiesC,
+	 webrtc::WebRtcAecm_StoreAdaptiveChannelC,
+	 webrtc::WebRtcAecm_ResetAdaptiveChannelC},
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+	{"sse2", webrtc::GetCPUInfo(webrtc::kSSE2) != 0,
+	 webrtc::WebRtcAecm_CalcLinearEnergiesSse2,
+	 webrtc::WebRtcAecm_StoreAdaptiveChannelSse2,
+	 webrtc::WebRtcAecm_ResetAdaptiveChannelSse2},
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(WEBRTC_ENABLE_AVX2)
+	{"avx2", webrtc::GetCPUInfo(webrtc::kAVX2) != 0,
+	 webrtc::WebRtcAecm_CalcLinearEnergiesAvx2,
+	 webrtc::WebRtcAecm_StoreAdaptiveChannelAvx2,
+	 webrtc::WebRtcAecm_ResetAdaptiveChannelAvx2},
+#endif
+    };
+    constexpr int kIterations = 1000000;
+
+    webrtc::AecmCore* aecm = webrtc::WebRtcAecm_CreateCore();
+    webrtc::WebRtcAecm_InitCore(aecm, 16000);
+    std::vector<float> noise(3 * PART_LEN1);
+    FillWithNoise(noise);
+    uint16_t far_spectrum[PART_LEN1];
+    int16_t channel[PART_LEN1];
+    for (int i = 0; i < PART_LEN1; ++i) {
+	far_spectrum[i] = static_cast<uint16_t>(noise[i] + 16384.f) * 2;
+	channel[i] = static_cast<int16_t>(noise[PART_LEN1 + i]);
+	aecm->channelAdapt16[i] = static_cast<int16_t>(noise[2 * PART_LEN1 + i]);
+    }
+
+    int32_t reference_echo_est[PART_LEN1];
+    uint32_t reference_energies[3] = {0, 0, 0};
+    std::copy(channel, channel + PART_LEN1, aecm->channelStored);
+    webrtc::WebRtcAecm_CalcLinearEnergiesC(
+	aecm, far_spectrum, reference_echo_est, &reference_energies[0],
+	&reference_energies[1], &reference_energies[2]);
+
+    for (const auto& impl : kImplementations) {
+	if (!impl.available)
+	    continue;
+
+	int32_t echo_est[PART_LEN1];
+	uint32_t energies[3] = {0, 0, 0};
+	std::copy(channel, channel + PART_LEN1, aecm->channelStored);
+	impl.calc_linear_energies(aecm, far_spectrum, echo_est, &energies[0],
+				  &energies[1], &energies[2]);
+	if (!std::equal(echo_est, echo_est + PART_LEN1, reference_echo_est) ||
+	    !std::equal(energies, energies + 3, reference_energies))
+	    std::cout << "  " << impl.name << ": output mismatch" << std::endl;
+
+	const std::string prefix = impl.name;
+	Measure(prefix + " CalcLinearEnergies", kIterations, [&] {
+	    uint32_t far_energy = 0, echo_energy_adapt = 0,
+		     echo_energy_stored = 0;
+	    impl.calc_linear_energies(aecm, far_spectrum, echo_est,
+				      &far_energy, &echo_energy_adapt,
+				      &echo_energy_stored);
+	});
+	Measure(prefix + " StoreAdaptiveChannel", kIterations, [&] {
+	    impl.store_adaptive_channel(aecm, far_spectrum, echo_est);
+	});
+	Measure(prefix + " ResetAdaptiveChannel", kIterations, [&] {
+	    impl.reset_adaptive_channel(aecm);
+	});
+    }
+    webrtc::WebRtcAecm_FreeCore(aecm);
+
+    // AECM uses a 128 point real FFT, i.e., order 7.
+    constexpr int kFftOrder = 7;
+    constexpr size_t kFftSize = 1 << kFftOrder;
+    RealFFT* real_fft = WebRtcSpl_CreateRealFFT(kFftOrder);
+    int16_t time_signal[kFftSize];
+    int16_t freq_signal[kFftSize + 2];
+    for (size_t i = 0; i < kFftSize; ++i)
+	time_signal[i] = static_cast<int16_t>(noise[i] / 2);
+    WebRtcSpl_RealForwardFFT(real_fft, time_signal, freq_signal);
+    Measure("spl 128 forward", kIterations,
+	    [&] { WebRtcSpl_RealForwardFFT(real_fft, time_signal, freq_signal); });
+    int16_t inverse_signal[kFftSize];
+    Measure("spl 128 inverse", kIterations, [&] {
+	WebRtcSpl_RealInverseFFT(real_fft, freq_signal, inverse_signal);
+    });
+    WebRtcSpl_FreeRealFFT(real_fft);
+}
+
+// Cost of running 64 independent 16 kHz AECM instances with one call per
+// instance versus one batched call.
+void BenchmarkAecmBatch() {
+    constexpr int kSampleRateHz = 16000;
+    constexpr size_t kNumInstances = 64;
+    constexpr size_t kFrameSize = kSampleRateHz / 100;
+    constexpr int kIterations = 2000;
+
+    std::vector<float> noise(2 * kNumInstances * kFrameSize);
+    FillWithNoise(noise);
+    std::vector<int16_t> far(kNumInstances * kFrameSize);
+    std::vector<int16_t> near(kNumInstances * kFrameSize);
+    for (size_t i = 0; i < far.size(); ++i) {
+	far[i] = static_cast<int16_t>(noise[i]);
+	near[i] = static_cast<int16_t>(noise[far.size() + i] / 4 + far[i] / 2);
+    }
+    const std::vector<int16_t> delays(kNumInstances, 20);
+
+    const auto create = [&] {
+	std::vector<void*> instances(kNumInstances);
+	for (void*& instance : instances) {
+	    instance = webrtc::WebRtcAecm_Create();
+	    webrtc::WebRtcAecm_Init(instance, kSampleRateHz);
+	}
+	return instances;
+    };
+    std::vector<void*> single = create();
+    std::vector<void*> batch = create();
+    std::vector<int16_t> single_out(near.size());
+    std::vector<int16_t> batch_out(near.size());
+    std::vector<int32_t> errors(kNumInstances);
+
+    const auto run_single = [&] {
+	for (size_t k = 0; k < kNumInstances; ++k) {
+	    const size_t offset = k * kFrameSize;
+	    webrtc::WebRtcAecm_BufferFarend(single[k], &far[offset],
+					    kFrameSize);
+	    webrtc::WebRtcAecm_Process(single[k], &near[offset], nullptr,
+				       &single_out[offset], kFrameSize,
+				       delays[k]);
+	}
+    };
+    const auto run_batch = [&] {
+	webrtc::WebRtcAecm_BufferFarendBatch(batch.data(), kNumInstances,
+					     far.data(), kFrameSize,
+					     errors.data());
+	webrtc::WebRtcAecm_ProcessBatch(batch.data(), kNumInstances,
+					near.data(), nullptr, batch_out.data(),
+					kFrameSize, delays.data(),
+					errors.data());
+    };
+
+    // Both ways of calling must give the same output.
+    for (int i = 0; i < 100; ++i) {
+	run_single();
+	run_batch();
+    }
+    if (single_out != batch_out)
+	std::cout << "  output mismatch" << std::endl;
+
+    Measure("one call per instance", kIterations, run_single);
+    Measure("batched", kIterations, run_batch);
+
+    for (void* instance : single)
+	webrtc::WebRtcAecm_Free(instance);
+    for (void* instance : batch)
+	webrtc::WebRtcAecm_Free(instance);
+}
+
+// Per-block cost of the AEC3 delay search with the time-domain matched
+// filters and with the FFT based correlator, for lag ranges from the default
+// (~0.5 s) up to ~3 s.
+void BenchmarkAec3Delay() {
+    constexpr size_t kDownSamplingFactor = 4;
+    constexpr size_t kSubBlockSize = webrtc::kBlockSize / kDownSamplingFactor;
+    constexpr int kIterations = 2000;
+    webrtc::ApmDataDumper data_dumper(0);
+
+    for (int num_filters : {5, 10, 30}) {
+	webrtc::DownsampledRenderBuffer render_buffer(
+	    webrtc::GetDownSampledBufferSize(kDownSamplingFactor,
+					     num_filters));
+	FillWithNoise(render_buffer.buffer);
+	std::vector<float> capture(kSubBlockSize);
+	FillWithNoise(capture);
+
+	webrtc::MatchedFilter matched_filter(
+	    &data_dumper, webrtc::DetectOptimization(), kSubBlockSize,
+	    webrtc::kMatchedFilterWindowSizeSubBlocks, num_filters,
+	    webrtc::kMatchedFilterAlignmentShiftSizeSubBlocks, 150.f, 0.7f,
+	    0.7f, 0.2f, /*detect_pre_echo=*/true);
+	webrtc::FftMatchedFilter fft_matched_filter(
+	    &data_dumper, kSubBlockSize,
+	    webrtc::kMatchedFilterWindowSizeSubBlocks, num_filters,
+	    webrtc::kMatchedFilterAlignmentShiftSizeSubBlocks,
+	    webrtc::kFftMatchedFilterHopSizeSubBlocks, 150.f);
+
+	// Advance the read position like the render delay buffer does, so that
+	// each block sees new render data.
+	const auto advance = [&] {
+	    render_buffer.read =
+		render_buffer.OffsetIndex(render_buffer.read,
+					   -static_cast<int>(kSubBlockSize));
+	};
+	const std::string suffix =
+	    ", " + std::to_string(num_filters) + " filters (" +
+	    std::to_string(fft_matched_filter.GetMaxFilterLag() *
+			   kDownSamplingFactor / 16) +
+	    " ms)";
+	Measure("matched filter" + suffix, kIterations, [&] {
+	    matched_filter.Update(render_buffer, capture, false);
+	    advance();
+	});
+	Measure("fft matched filter" + suffix, kIterations, [&] {
+	    fft_matched_filter.Update(render_buffer, capture);
+	    advance();
+	});
+    }
+}
+
+// Per-block cost of the AEC3 comfort noise generator for 1 to 8 capture
+// channels, for the generic and the detected implementation. The outputs of
+// the two are checked against each other.
+void BenchmarkAec3ComfortNoise() {
+    const struct {
+	const char* name;
+	webrtc::Aec3Optimization optimization;
+    } kImplementations[] = {
+	{"generic", webrtc::Aec3Optimization::kNone},
+	{"optimized", webrtc::DetectOptimization()},
+    };
+    constexpr int kIterations = 100000;
+    const webrtc::EchoCanceller3Config config;
+
+    for (size_t num_channels : {1, 2, 8}) {
+	std::vector<std::array<float, webrtc::kFftLengthBy2Plus1>> Y2(
+	    num_channels);
+	for (auto& Y2_ch : Y2) {
+	    std::vector<float> noise(Y2_ch.size());
+	    FillWithNoise(noise);
+	    for (size_t k = 0; k < Y2_ch.size(); ++k)
+		Y2_ch[k] = noise[k] * noise[k];
+	}
+
+	std::vector<std::vector<webrtc::FftData>> outputs;
+	for (const auto& impl : kImplementations) {
+	    webrtc::ComfortNoiseGenerator cng(config, impl.optimization,
+					      num_channels);
+	    std::vector<webrtc::FftData> lower_band_noise(num_channels);
+	    std::vector<webrtc::FftData> upper_band_noise(num_channels);
+	    cng.Compute(false, Y2, lower_band_noise, upper_band_noise);
+	    outputs.push_back(lower_band_noise);
+
+	    Measure(std::string(impl.name) + ", " +
+			std::to_string(num_channels) + " channels",
+		    kIterations, [&] {
+			cng.Compute(false, Y2, lower_band_noise,
+				    upper_band_noise);
+		    });
+	}
+	for (size_t ch = 0; ch < num_channels; ++ch) {
+	    if (outputs[0][ch].re != outputs[1][ch].re ||
+		outputs[0][ch].im != outputs[1][ch].im)
+		std::cout << "  output mismatch" << std::endl;
+	}
+    }
+}
+
+// Per-frame cost of the AGC2 limiter at 48 kHz for mono and stereo, without
+// and with SIMD. The level of the input varies from frame to frame so that
+// the gain curve is looked up in all its regions. The input is restored
+// before each call, which is included in the reported times.
+void BenchmarkAgc2Limiter() {
+    const struct {
+	const char* name;
+	webrtc::AvailableCpuFeatures cpu_features;
+    } kImplementations[] = {
+	{"generic", webrtc::NoAvailableCpuFeatures()},
+	{"optimized", webrtc::GetAvailableCpuFeatures()},
+    };
+    constexpr size_t kFrameSize = 480;
+    constexpr size_t kNumFrames = 100;
+    constexpr int kIterations = 100000;
+
+    for (size_t num_channels : {1, 2}) {
+	std::vector<float> input(kFrameSize * num_channels * kNumFrames);
+	FillWithNoise(input);
+	for (size_t frame = 0; frame < kNumFrames; ++frame) {
+	    const float gain = 0.25f + 0.05f * (frame % 10);
+	    for (size_t k = 0; k < kFrameSize * num_channels; ++k)
+		input[frame * kFrameSize * num_channels + k] *= gain * 8.f;
+	}
+
+	std::vector<std::vector<float>> outputs;
+	for (const auto& impl : kImplementations) {
+	    webrtc::ApmDataDumper data_dumper(0);
+	    webrtc::Limiter limiter(&data_dumper, kFrameSize, "Benchmark",
+				    impl.cpu_features);
+	    std::vector<float> output = input;
+	    for (size_t frame = 0; frame < kNumFrames; ++frame) {
+		limiter.Process(webrtc::DeinterleavedView<float>(
+		    &output[frame * kFrameSize * num_channels], kFrameSize,
+		    num_channels));
+	    }
+	    outputs.push_back(output);
+
+	    std::vector<float> frame_data(kFrameSize * num_channels);
+	    size_t frame = 0;
+	    Measure(std::string(impl.name) + ", " +
+			std::to_string(num_channels) + " channels",
+		    kIterations, [&] {
+			const auto begin =
+			    input.begin() + frame * frame_data.size();
+			std::copy(begin, begin + frame_data.size(),
+				  frame_data.begin());
+			limiter.Process(webrtc::DeinterleavedView<float>(
+			    frame_data.data(), kFrameSize, num_channels));
+			frame = (frame + 1) % kNumFrames;
+		    });
+	}
+	if (outputs[0] != outputs[1])
+	    std::cout << "  output mismatch" << std::endl;
+    }
+}
+
+// Per-frame cost of AGC2 for one 48 kHz stereo participant of a mixer, when
+// the frame is copied into an AudioBuffer, processed and copied back before
+// being added to the mix, and when only the gains are computed and applied
+// while adding the frame to the mix. The speech probability is given, as by
+// an external VAD, so that the cost of the internal VAD is left out.
+void BenchmarkAgc2AnalysisOnly() {
+    constexpr int kSampleRateHz = 48000;
+    constexpr size_t kNumChannels = 2;
+    constexpr size_t kFrameSize = kSampleRateHz / 100;
+    constexpr int kIterations = 20000;
+
+    webrtc::AudioProcessing::Config::GainController2 config;
+    config.enabled = true;
+    config.adaptive_digital.enabled = true;
+    std::vector<float> input(kFrameSize * kNumChannels);
+    FillWithNoise(input);
+    std::vector<float> mix(input.size(), 0.f);
+
+    constexpr float kSpeechProbability = 1.f;
+    webrtc::GainController2 processing(config, {}, kSampleRateHz,
+				       kNumChannels,
+				       /*use_internal_vad=*/false);
+    webrtc::AudioBuffer audio(kSampleRateHz, kNumChannels, kSampleRateHz,
+			      kNumChannels, kSampleRateHz, kNumChannels);
+    Measure("Process()", kIterations, [&] {
+	for (size_t ch = 0; ch < kNumChannels; ++ch) {
+	    std::copy(input.begin() + ch * kFrameSize,
+		      input.begin() + (ch + 1) * kFrameSize,
+		      audio.channels()[ch]);
+	}
+	processing.Process(kSpeechProbability, false, &audio);
+	for (size_t ch = 0; ch < kNumChannels; ++ch) {
+	    for (size_t k = 0; k < kFrameSize; ++k)
+		mix[ch * kFrameSize + k] += audio.channels()[ch][k];
+	}
+    });
+
+    webrtc::GainController2 analysis(config, {}, kSampleRateHz, kNumChannels,
+				     /*use_internal_vad=*/false);
+    constexpr size_t kSubFrameSize = kFrameSize / webrtc::kSubFramesInFrame;
+    Measure("ComputeGains()", kIterations, [&] {
+	const webrtc::GainController2::FrameGains gains =
+	    analysis.ComputeGains(kSpeechProbability, false,
+				  webrtc::DeinterleavedView<const float>(
+				      input.data(), kFrameSize, kNumChannels));
+	for (size_t ch = 0; ch < kNumChannels; ++ch) {
+	    for (size_t k = 0; k < gains.size(); ++k) {
+		const float step =
+		    (gains[k].end - gains[k].start) / kSubFrameSize;
+		const size_t offset = ch * kFrameSize + k * kSubFrameSize;
+		for (int j = 0; j < static_cast<int>(kSubFrameSize); ++j) {
+		    mix[offset + j] +=
+			input[offset + j] * (gains[k].start + step * j);
+		}
+	    }
+	}
+    });
+}
+
+// Average per-frame cost of AGC2 with the internal VAD at 48 kHz mono, for
+// analysis periods of 1 to 10 frames.
+void BenchmarkAgc2AnalysisPeriod() {
+    constexpr int kSampleRateHz = 48000;
+    constexpr size_t kFrameSize = kSampleRateHz / 100;
+    constexpr int kIterations = 4000;
+
+    std::vector<float> input(kFrameSize);
+    FillWithNoise(input);
+    webrtc::AudioBuffer audio(kSampleRateHz, 1, kSampleRateHz, 1,
+			      kSampleRateHz, 1);
+    for (int period : {1, 2, 4, 10}) {
+	webrtc::AudioProcessing::Config::GainController2 config;
+	config.enabled = true;
+	config.adaptive_digital.enabled = true;
+	config.analysis_period_frames = period;
+	webrtc::GainController2 agc2(config, {}, kSampleRateHz, 1,
+				     /*use_internal_vad=*/true);
+	Measure("period " + std::to_string(period), kIterations, [&] {
+	    std::copy(input.begin(), input.end(), audio.channels()[0]);
+	    agc2.Process(std::nullopt, false, &audio);
+	});
+    }
+}
+
+// Per-sample cost of ProcessReverseStream() and ProcessStream() at 48 kHz
+// mono for frames of 10 to 60 ms, which are processed in 10 ms chunks but pay
+// the fixed per-call costs once. This is measured without any submodule,
+// where the fixed costs dominate, and with the echo canceller, noise
+// suppressor, AGC2 and high-pass filter.
+void BenchmarkApmFrameSize() {
+    constexpr int kSampleRateHz = 48000;
+    constexpr int kIterations = 2000;
+    constexpr int kMaxFrameSizeMs = 60;
+
+    std::vector<float> noise(kSampleRateHz * kMaxFrameSizeMs / 1000);
+    FillWithNoise(noise);
+    std::vector<int16_t> render(noise.begin(), noise.end());
+    std::vector<int16_t> capture(render.size());
+    for (size_t i = 0; i < capture.size(); ++i)
+	capture[i] = render[i] / 4;
+
+    for (bool submodules : {false, true}) {
+	webrtc::AudioProcessing::Config config;
+	config.echo_canceller.enabled = submodules;
+	config.noise_suppression.enabled = submodules;
+	config.gain_controller2.enabled = submodules;
+	config.high_pass_filter.enabled = submodules;
+
+	for (int frame_size_ms : {10, 20, 40, 60}) {
+	    rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+		webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+	    webrtc::StreamConfig stream_config(kSampleRateHz, 1, frame_size_ms);
+	    const size_t num_frames = stream_config.num_frames();
+	    std::vector<int16_t> render_frame(num_frames);
+	    std::vector<int16_t> capture_frame(num_frames);
+
+	    const std::string label =
+		std::string(submodules ? "aec+ns+agc2+hpf" : "no submodules") +
+		", " + std::to_string(frame_size_ms) + " ms frames, per sample";
+	    // The same duration of audio is processed for each frame size.
+	    const int iterations =
+		(submodules ? 1 : 10) * kIterations * 10 / frame_size_ms;
+	    Measure(label, iterations, [&] {
+		std::copy(render.begin(), render.begin() + num_frames,
+			  render_frame.begin());
+		std::copy(capture.begin(), capture.begin() + num_frames,
+			  capture_frame.begin());
+		apm->ProcessReverseStream(render_frame.data(), stream_config,
+					  stream_config, render_frame.data());
+		apm->ProcessStream(capture_frame.data(), stream_config,
+				   stream_config, capture_frame.data());
+	    }, num_frames);
+	}
+    }
+}
+
+// Per-frame cost of the echo canceller at 48 kHz stereo, with the delay
+// estimated and with the delay pinned to the actual echo path delay. The
+// capture signal is the render signal delayed by 40 ms.
+void BenchmarkAec3PinnedDelay() {
+    const struct {
+	const char* trials;
+	const char* name;
+    } kModes[] = {
+	{"", "estimated delay"},
+	{"WebRTC-Aec3PinnedDelayOverride/640/", "pinned delay"},
+    };
+    constexpr int kSampleRateHz = 48000;
+    constexpr size_t kNumChannels = 2;
+    constexpr size_t kFrameSize = kSampleRateHz / 100;
+    constexpr size_t kDelayFrames = 4;
+    constexpr size_t kNumFrames = 200;
+    constexpr int kIterations = 2000;
+
+    std::vector<float> noise(kFrameSize * kNumFrames);
+    FillWithNoise(noise);
+    std::vector<int16_t> render(kNumChannels * noise.size());
+    std::vector<int16_t> capture(render.size(), 0);
+    for (size_t i = 0; i < noise.size(); ++i) {
+	for (size_t ch = 0; ch < kNumChannels; ++ch) {
+	    render[i * kNumChannels + ch] = static_cast<int16_t>(noise[i]);
+	    if (i >= kDelayFrames * kFrameSize) {
+		capture[i * kNumChannels + ch] = static_cast<int16_t>(
+		    noise[i - kDelayFrames * kFrameSize] / 4);
+	    }
+	}
+    }
+
+    webrtc::AudioProcessing::Config config;
+    config.echo_canceller.enabled = true;
+    const webrtc::StreamConfig stream_config(kSampleRateHz, kNumChannels);
+    std::vector<int16_t> output(kFrameSize * kNumChannels);
+    for (const auto& mode : kModes) {
+	webrtc::field_trial::InitFieldTrialsFromString(mode.trials);
+	rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+	    webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+	size_t frame = 0;
+	Measure(mode.name, kIterations, [&] {
+	    const size_t offset = frame * kFrameSize * kNumChannels;
+	    apm->ProcessReverseStream(&render[offset], stream_config,
+				      stream_config, output.data());
+	    apm->ProcessStream(&capture[offset], stream_config, stream_config,
+			       output.data());
+	    frame = (frame + 1) % kNumFrames;
+	});
+    }
+    webrtc::field_trial::InitFieldTrialsFromString("");
+}
+
+// Per-frame cost of the high-pass filter biquad at 48 kHz for 1 to 16
+// channels, with one CascadedBiQuadFilter per channel and with the channels
+// filtered together, and per-block cost of a cascade of four biquads, as in
+// the AEC3 decimators, applied as one cascade and as four separate filters.
+// The input is restored before each call, which is included in the reported
+// times.
+void BenchmarkBiQuad() {
+    using webrtc::CascadedBiQuadFilter;
+    constexpr CascadedBiQuadFilter::BiQuadCoefficients kCoefficients = {
+	{0.99079f, -1.98157f, 0.99079f}, {-1.98149f, 0.98166f}};
+    constexpr size_t kFrameSize = 480;
+    constexpr int kIterations = 20000;
+
+    for (size_t num_channels : {1, 2, 4, 8, 16}) {
+	std::vector<std::vector<float>> input(num_channels,
+					      std::vector<float>(kFrameSize));
+	for (auto& channel : input)
+	    FillWithNoise(channel);
+
+	std::vector<std::vector<float>> per_channel_output = input;
+	std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters;
+	for (size_t ch = 0; ch < num_channels; ++ch)
+	    filters.emplace_back(new CascadedBiQuadFilter(kCoefficients, 1));
+	Measure("per channel, " + std::to_string(num_channels) + " channels",
+		kIterations, [&] {
+		    for (size_t ch = 0; ch < num_channels; ++ch) {
+			per_channel_output[ch] = input[ch];
+			filters[ch]->Process(per_channel_output[ch]);
+		    }
+		});
+
+	std::vector<std::vector<float>> output = input;
+	std::vector<float*> channels(num_channels);
+	for (size_t ch = 0; ch < num_channels; ++ch)
+	    channels[ch] = output[ch].data();
+	webrtc::MultiChannelCascadedBiQuadFilter multi_channel_filter(
+	    kCoefficients, 1, num_channels);
+	Measure("multi-channel, " + std::to_string(num_channels) + " channels",
+		kIterations, [&] {
+		    for (size_t ch = 0; ch < num_channels; ++ch)
+			std::copy(input[ch].begin(), input[ch].end(),
+				  output[ch].begin());
+		    multi_channel_filter.Process(channels, kFrameSize);
+		});
+
+	// Both have processed the same input the same number of times.
+	if (output != per_channel_output)
+	    std::cout << "  output mismatch" << std::endl;
+    }
+
+    // signal.ellip(6, 1, 40, 1800/8000, btype='lowpass', analog=False)
+    // followed by signal.butter(2, 1000/8000.0, 'highpass', analog=False).
+    const std::vector<CascadedBiQuadFilter::BiQuadParam> kParams = {
+	{{-0.08873842f, 0.99605496f}, {0.75916227f, 0.23841065f},
+	 0.26250696827f},
+	{{0.62273832f, 0.78243018f}, {0.74892112f, 0.5410152f},
+	 0.26250696827f},
+	{{0.71107693f, 0.70311421f}, {0.74895534f, 0.63924616f},
+	 0.26250696827f},
+	{{1.f, 0.f}, {0.72712179f, 0.21296904f}, 0.7570763753338849f}};
+    constexpr int kBlockIterations = 200000;
+    std::vector<float> block(webrtc::kBlockSize);
+    FillWithNoise(block);
+
+    CascadedBiQuadFilter cascade(kParams);
+    std::vector<float> cascade_output(block.size());
+    Measure("4 biquads, one cascade", kBlockIterations,
+	    [&] { cascade.Process(block, cascade_output); });
+
+    std::vector<std::unique_ptr<CascadedBiQuadFilter>> separate;
+    for (size_t k = 0; k < kParams.size(); ++k) {
+	separate.emplace_back(new CascadedBiQuadFilter(
+	    std::vector<CascadedBiQuadFilter::BiQuadParam>(
+		kParams.begin() + k, kParams.begin() + k + 1)));
+    }
+    std::vector<float> separate_output(block.size());
+    Measure("4 biquads, separate filters", kBlockIterations, [&] {
+	separate[0]->Process(block, separate_output);
+	for (size_t k = 1; k < separate.size(); ++k)
+	    separate[k]->Process(separate_output);
+    });
+
+    if (cascade_output != separate_output)
+	std::cout << "  output mismatch" << std::endl;
+}
+
+// Per-frame cost of the S16/FloatS16 conversions and of the interleaving of
+// 48 kHz audio with 2, 4 and 8 channels, with plain loops as they were used
+// before the vectorization and with the audio_util.h functions.
+void BenchmarkAudioUtil() {
+    constexpr size_t kFrameSize = 480;
+    constexpr int kIterations = 100000;
+
+    for (size_t num_channels : {2, 4, 8}) {
+	const std::string suffix =
+	    ", " + std::to_string(num_channels) + " channels";
+	const size_t size = kFrameSize * num_channels;
+	std::vector<float> interleaved(size);
+	FillWithNoise(interleaved);
+	std::vector<int16_t> interleaved_s16(size);
+	for (size_t i = 0; i < size; ++i)
+	    interleaved_s16[i] = static_cast<int16_t>(interleaved[i]);
+	std::vector<float> deinterleaved(size);
+	webrtc::DeinterleavedView<float> view(deinterleaved.data(),
+					      kFrameSize, num_channels);
+
+	Measure("S16ToFloatS16() loop" + suffix, kIterations, [&] {
+	    for (size_t i = 0; i < size; ++i)
+		deinterleaved[i] = interleaved_s16[i];
+	});
+	Measure("S16ToFloatS16()" + suffix, kIterations, [&] {
+	    webrtc::S16ToFloatS16(interleaved_s16.data(), size,
+				  deinterleaved.data());
+	});
+	Measure("FloatS16ToS16() loop" + suffix, kIterations, [&] {
+	    for (size_t i = 0; i < size; ++i)
+		interleaved_s16[i] = webrtc::FloatS16ToS16(interleaved[i]);
+	});
+	Measure("FloatS16ToS16()" + suffix, kIterations, [&] {
+	    webrtc::FloatS16ToS16(interleaved.data(), size,
+				  interleaved_s16.data());
+	});
+
+	Measure("Deinterleave() loop" + suffix, kIterations, [&] {
+	    for (size_t ch = 0; ch < num_channels; ++ch) {
+		for (size_t k = 0; k < kFrameSize; ++k)
+		    view[ch][k] = interleaved[k * num_channels + ch];
+	    }
+	});
+	Measure("Deinterleave()" + suffix, kIterations, [&] {
+	    webrtc::Deinterleave(
+		webrtc::InterleavedView<const float>(
+		    interleaved.data(), kFrameSize, num_channels),
+		view);
+	});
+	Measure("Interleave() loop" + suffix, kIterations, [&] {
+	    for (size_t ch = 0; ch < num_channels; ++ch) {
+		for (size_t k = 0; k < kFrameSize; ++k)
+		    interleaved[k * num_channels + ch] = view[ch][k];
+	    }
+	});
+	Measure("Interleave()" + suffix, kIterations, [&] {
+	    webrtc::Interleave<float>(
+		view, webrtc::InterleavedView<float>(
+			  interleaved.data(), kFrameSize, num_channels));
+	});
+
+	Measure("DeinterleaveS16ToFloatS16() loop" + suffix, kIterations, [&] {
+	    for (size_t ch = 0; ch < num_channels; ++ch) {
+		for (size_t k = 0; k < kFrameSize; ++k)
+		    view[ch][k] = interleaved_s16[k * num_channels + ch];
+	    }
+	});
+	Measure("DeinterleaveS16ToFloatS16()" + suffix, kIterations, [&] {
+	    webrtc::DeinterleaveS16ToFloatS16(
+		webrtc::InterleavedView<const int16_t>(
+		    interleaved_s16.data(), kFrameSize, num_channels),
+		view);
+	});
+	Measure("InterleaveFloatS16ToS16() loop" + suffix, kIterations, [&] {
+	    for (size_t ch = 0; ch < num_channels; ++ch) {
+		for (size_t k = 0; k < kFrameSize; ++k) {
+		    interleaved_s16[k * num_channels + ch] =
+			webrtc::FloatS16ToS16(view[ch][k]);
+		}
+	    }
+	});
+	Measure("InterleaveFloatS16ToS16()" + suffix, kIterations, [&] {
+	    webrtc::InterleaveFloatS16ToS16(
+		view, webrtc::InterleavedView<int16_t>(
+			  interleaved_s16.data(), kFrameSize, num_channels));
+	});
+    }
+}
+
+// Per-frame cost of the capture AudioBuffer input stage for 48 kHz int16 and
+// float audio with 2, 4 and 6 channels downmixed by averaging to mono, with
+// and without resampling to 16 kHz.
+void BenchmarkAudioBufferDownmix() {
+    constexpr int kInputRateHz = 48000;
+    constexpr int kIterations = 100000;
+
+    for (int buffer_rate_hz : {48000, 16000}) {
+	for (size_t num_channels : {2, 4, 6}) {
+	    const std::string suffix =
+		", " + std::to_string(num_channels) + " channels to mono at " +
+		std::to_string(buffer_rate_hz / 1000) + " kHz";
+	    webrtc::AudioBuffer buffer(kInputRateHz, num_channels,
+				       buffer_rate_hz, 1, buffer_rate_hz, 1);
+	    buffer.set_downmixing_by_averaging();
+	    const webrtc::StreamConfig stream_config(kInputRateHz,
+						     num_channels);
+	    const size_t num_frames = stream_config.num_frames();
+
+	    std::vector<float> stacked(num_frames * num_channels);
+	    FillWithNoise(stacked);
+	    std::vector<int16_t> interleaved(stacked.begin(), stacked.end());
+	    std::vector<float*> channels(num_channels);
+	    for (size_t ch = 0; ch < num_channels; ++ch) {
+		channels[ch] = &stacked[ch * num_frames];
+		for (size_t k = 0; k < num_frames; ++k)
+		    channels[ch][k] /= 32768.f;
+	    }
+
+	    Measure("int16" + suffix, kIterations,
+		    [&] { buffer.CopyFrom(interleaved.data(), stream_config); });
+	    Measure("float" + suffix, kIterations,
+		    [&] { buffer.CopyFrom(channels.data(), stream_config); });
+	}
+    }
+}
+
+const struct {
+    const char* name;
+    void (*run)();
+} kBenchmarks[] = {
+    {"fft", BenchmarkFft},
+    {"audio-util", BenchmarkAudioUtil},
+    {"audio-buffer-downmix", BenchmarkAudioBufferDownmix},
+    {"agc1", BenchmarkAgc1},
+    {"aecm", BenchmarkAecm},
+    {"aecm-batch", BenchmarkAecmBatch},
+    {"aec3-delay", BenchmarkAec3Delay},
+    {"aec3-pinned-delay", BenchmarkAec3PinnedDelay},
+    {"aec3-comfort-noise", BenchmarkAec3ComfortNoise},
+    {"biquad", BenchmarkBiQuad},
+    {"agc2-limiter", BenchmarkAgc2Limiter},
+    {"agc2-analysis-only", BenchmarkAgc2AnalysisOnly},
+    {"agc2-analysis-period", BenchmarkAgc2AnalysisPeriod},
+    {"apm-frame-size", BenchmarkApmFrameSize},
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int num_run = 0;
+    for (const auto& benchmark : kBenchmarks) {
+	bool selected = argc == 1;
+	for (int i = 1; i < argc; ++i)
+	    selected |= strcmp(argv[i], benchmark.name) == 0;
+	if (!selected)
+	    continue;
+
+	std::cout << benchmark.name << ":" << std::endl;
+	benchmark.run();
+	++num_run;
+    }
+
+    if (num_run == 0) {
+	std::cerr << "Usage: " << argv[0] << " [benchmark...]" << std::endl;
+	std::cerr << "Available benchmarks:";
+	for (const auto& benchmark : kBenchmarks)
+	    std::cerr << " " << benchmark.name;
+	std::cerr << std::endl;
+	return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -10,19 +10,97 @@
  */
 
 #include "api/scoped_refptr.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include <webrtc/modules/audio_processing/include/audio_processing.h>
 
 #define DEFAULT_BLOCK_MS 10
 #define DEFAULT_RATE 32000
 #define DEFAULT_CHANNELS 1
+#define FRAME_SAMPLES (DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS)
+
+static std::vector<int16_t> read_file(const char *name) {
+    std::ifstream file(name, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<int16_t> samples(bytes.size() / sizeof(int16_t));
+    memcpy(samples.data(), bytes.data(), samples.size() * sizeof(int16_t));
+    return samples;
+}
+
+/*
+ * Runs the echo canceller alone over the first `num_frames` frames and returns
+ * the adapted state. As the whole recording is available, this lets the actual
+ * processing start with the delay and the echo path already known.
+ */
+static std::vector<uint8_t> converge_echo_canceller(const webrtc::AudioProcessing::Config &config,
+						    const std::vector<int16_t> &play,
+						    const std::vector<int16_t> &rec,
+						    size_t num_frames) {
+    webrtc::AudioProcessing::Config aec_config;
+    aec_config.echo_canceller = config.echo_canceller;
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = webrtc::AudioProcessingBuilder().SetConfig(aec_config).Create();
+
+    webrtc::StreamConfig stream_config(DEFAULT_RATE, DEFAULT_CHANNELS);
+    int16_t frame[FRAME_SAMPLES];
+
+    for (size_t i = 0; i < num_frames; i++) {
+	memcpy(frame, &play[i * FRAME_SAMPLES], sizeof(frame));
+	apm->ProcessReverseStream(frame, stream_config, stream_config, frame);
+	memcpy(frame, &rec[i * FRAME_SAMPLES], sizeof(frame));
+	apm->ProcessStream(frame, stream_config, stream_config, frame);
+    }
+
+    return apm->GetEchoControllerState();
+}
+
+static void print_usage(const char *name) {
+    std::cerr << "Usage: " << name << " [--lookahead <seconds>|all] <play_file> <rec_file> <out_file>" << std::endl;
+}
+
+/*
+ * Parses a --lookahead value into `lookahead_s`, where "all" maps to -1.
+ * Returns false if the value is not a non-negative number of seconds.
+ */
+static bool parse_lookahead(const char *value, double *lookahead_s) {
+    if (strcmp(value, "all") == 0) {
+	*lookahead_s = -1;
+	return true;
+    }
+
+    char *end;
+    double seconds = strtod(value, &end);
+    if (end == value || *end != '\0' || !std::isfinite(seconds) || seconds < 0)
+	return false;
+
+    *lookahead_s = seconds;
+    return true;
+}
 
 int main(int argc, char **argv) {
+    const char *name = argv[0];
+    /* Lookahead in seconds, where a negative value means the whole file. */
+    double lookahead_s = 0;
+
+    if (argc == 6 && strcmp(argv[1], "--lookahead") == 0) {
+	if (!parse_lookahead(argv[2], &lookahead_s)) {
+	    std::cerr << "Invalid lookahead: " << argv[2] << std::endl;
+	    print_usage(name);
+	    return EXIT_FAILURE;
+	}
+	argv += 2;
+	argc -= 2;
+    }
+
     if (argc != 4) {
-	std::cerr << "Usage: " << argv[0] << " <play_file> <rec_file> <out_file>" << std::endl;
+	print_usage(name);
 	return EXIT_FAILURE;
     }
 
@@ -46,9 +124,26 @@ int main(int argc, char **argv) {
 
     webrtc::StreamConfig stream_config(DEFAULT_RATE, DEFAULT_CHANNELS);
 
+    if (lookahead_s != 0) {
+	/* Offline mode: converge on the lookahead first, then process the
+	 * recording from the start with the converged echo canceller. */
+	std::vector<int16_t> play = read_file(argv[1]);
+	std::vector<int16_t> rec = read_file(argv[2]);
+	size_t num_frames = std::min(play.size(), rec.size()) / FRAME_SAMPLES;
+	if (lookahead_s > 0)
+	    num_frames = std::min(num_frames, static_cast<size_t>(lookahead_s * 1000 / DEFAULT_BLOCK_MS));
+
+	std::vector<uint8_t> state = converge_echo_canceller(config, play, rec, num_frames);
+
+	/* Create the echo canceller for the stream format before restoring. */
+	apm->Initialize({stream_config, stream_config, stream_config, stream_config});
+	if (!apm->SetEchoControllerState(state))
+	    std::cerr << "Could not restore the echo canceller state, processing causally" << std::endl;
+    }
+
     while (!play_file.eof() && !rec_file.eof()) {
-	int16_t play_frame[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS];
-	int16_t rec_frame[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS];
+	int16_t play_frame[FRAME_SAMPLES];
+	int16_t rec_frame[FRAME_SAMPLES];
 
 	play_file.read(reinterpret_cast<char *>(play_frame), sizeof(play_frame));
 	rec_file.read(reinterpret_cast<char *>(rec_frame), sizeof(rec_frame));
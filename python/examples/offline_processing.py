@@ -7,9 +7,11 @@ Audio Processing library. It reads playback and recorded audio files, applies
 echo cancellation and other processing, and writes the processed output.
 
 Usage:
-    python offline_processing.py <play_file> <rec_file> <out_file>
+    python offline_processing.py [--lookahead <seconds>|all] <play_file> <rec_file> <out_file>
 
 Arguments:
+    --lookahead: Converge the echo canceller on the first seconds (or all) of
+                 the recording before processing it from the start
     play_file: Raw 16-bit PCM audio file (far-end/render audio)
     rec_file: Raw 16-bit PCM audio file (near-end/capture audio)
     out_file: Output file for processed audio
@@ -21,6 +23,7 @@ The audio files should be:
 - Raw format (no headers)
 """
 
+import math
 import sys
 import os
 import struct
@@ -62,12 +65,8 @@ def write_audio_file(filename, audio_data):
         sys.exit(1)
 
 
-def create_audio_processor():
-    """Create and configure the audio processor."""
-    # Create audio processing builder
-    builder = webrtc_apm.AudioProcessingBuilder()
-
-    # Create configuration
+def create_config():
+    """Create the processing configuration."""
     config = webrtc_apm.Config()
 
     # Enable echo cancellation
@@ -84,7 +83,12 @@ def create_audio_processor():
     # Enable high-pass filter
     config.high_pass_filter.enabled = True
 
-    # Apply configuration
+    return config
+
+
+def create_audio_processor(config):
+    """Create the audio processor for the configuration."""
+    builder = webrtc_apm.AudioProcessingBuilder()
     builder.SetConfig(config)
 
     # Create the audio processor
@@ -93,7 +97,30 @@ def create_audio_processor():
     return apm
 
 
-def process_audio_files(play_file, rec_file, out_file):
+def converge_echo_canceller(config, play_audio, rec_audio, num_frames, frame_size):
+    """Run the echo canceller alone over the first frames and return its state.
+
+    The echo canceller is configured as in `config`. As the whole recording is
+    available offline, the actual processing can then start with the delay and
+    the echo path already known.
+    """
+    aec_config = webrtc_apm.Config()
+    aec_config.echo_canceller = config.echo_canceller
+    apm = create_audio_processor(aec_config)
+
+    stream_config = webrtc_apm.StreamConfig(DEFAULT_RATE, DEFAULT_CHANNELS)
+    for i in range(num_frames):
+        start_idx = i * frame_size
+        end_idx = start_idx + frame_size
+        play_frame = np.ascontiguousarray(play_audio[start_idx:end_idx], dtype=np.int16)
+        rec_frame = np.ascontiguousarray(rec_audio[start_idx:end_idx], dtype=np.int16)
+        apm.ProcessReverseStream(play_frame, stream_config, stream_config, play_frame)
+        apm.ProcessStream(rec_frame, stream_config, stream_config, rec_frame)
+
+    return apm.GetEchoControllerState()
+
+
+def process_audio_files(play_file, rec_file, out_file, lookahead_s=0):
     """Process the audio files using WebRTC Audio Processing."""
     print(f"Processing audio files:")
     print(f"  Play file: {play_file}")
@@ -110,7 +137,8 @@ def process_audio_files(play_file, rec_file, out_file):
 
     # Create audio processor
     print("Creating audio processor...")
-    apm = create_audio_processor()
+    config = create_config()
+    apm = create_audio_processor(config)
 
     # Configure stream parameters
     stream_config = webrtc_apm.StreamConfig(DEFAULT_RATE, DEFAULT_CHANNELS)
@@ -123,6 +151,19 @@ def process_audio_files(play_file, rec_file, out_file):
     max_frames = min(len(play_audio), len(rec_audio)) // frame_size
     print(f"Processing {max_frames} frames...")
 
+    # In offline mode, converge on the lookahead (negative means the whole
+    # recording) and restore the converged state before processing.
+    if lookahead_s != 0:
+        num_frames = max_frames
+        if lookahead_s > 0:
+            num_frames = min(max_frames, int(lookahead_s * 1000 / DEFAULT_BLOCK_MS))
+        print(f"Converging the echo canceller on {num_frames} frames...")
+        state = converge_echo_canceller(config, play_audio, rec_audio, num_frames,
+                                        frame_size)
+        apm.Initialize(stream_config, stream_config, stream_config, stream_config)
+        if not apm.SetEchoControllerState(state):
+            print("Warning: could not restore the echo canceller state, processing causally")
+
     # Initialize output array
     processed_audio = np.zeros(max_frames * frame_size, dtype=np.int16)
 
@@ -168,24 +209,55 @@ def process_audio_files(play_file, rec_file, out_file):
     print(f"Processed {max_frames} frames ({max_frames * DEFAULT_BLOCK_MS / 1000:.2f} seconds)")
 
 
+def parse_lookahead(value):
+    """Parse a --lookahead value; returns -1 for "all" and None if invalid."""
+    if value == "all":
+        return -1
+    try:
+        lookahead_s = float(value)
+    except ValueError:
+        return None
+    # Negative values are rejected, as -1 stands for "all".
+    if not math.isfinite(lookahead_s) or lookahead_s < 0:
+        return None
+    return lookahead_s
+
+
+def print_usage():
+    """Print the command line usage."""
+    print("Usage: python offline_processing.py [--lookahead <seconds>|all] <play_file> <rec_file> <out_file>")
+    print("")
+    print("Arguments:")
+    print("  --lookahead: Converge the echo canceller on the first seconds (or all)")
+    print("               of the recording before processing it from the start")
+    print("  play_file: Raw 16-bit PCM audio file (far-end/render audio)")
+    print("  rec_file: Raw 16-bit PCM audio file (near-end/capture audio)")
+    print("  out_file: Output file for processed audio")
+    print("")
+    print("Audio files should be:")
+    print("  - 16-bit signed PCM format")
+    print("  - 32 kHz sample rate")
+    print("  - Mono (1 channel)")
+    print("  - Raw format (no headers)")
+
+
 def main():
     """Main function."""
-    if len(sys.argv) != 4:
-        print("Usage: python offline_processing.py <play_file> <rec_file> <out_file>")
-        print("")
-        print("Arguments:")
-        print("  play_file: Raw 16-bit PCM audio file (far-end/render audio)")
-        print("  rec_file: Raw 16-bit PCM audio file (near-end/capture audio)")
-        print("  out_file: Output file for processed audio")
-        print("")
-        print("Audio files should be:")
-        print("  - 16-bit signed PCM format")
-        print("  - 32 kHz sample rate")
-        print("  - Mono (1 channel)")
-        print("  - Raw format (no headers)")
+    args = sys.argv[1:]
+    lookahead_s = 0
+    if len(args) == 5 and args[0] == "--lookahead":
+        lookahead_s = parse_lookahead(args[1])
+        if lookahead_s is None:
+            print(f"Error: invalid lookahead '{args[1]}'.")
+            print_usage()
+            sys.exit(1)
+        args = args[2:]
+
+    if len(args) != 3:
+        print_usage()
         sys.exit(1)
 
-    play_file, rec_file, out_file = sys.argv[1:4]
+    play_file, rec_file, out_file = args
 
     # Verify input files exist
     if not os.path.exists(play_file):
@@ -198,7 +270,7 @@ def main():
 
     # Process the files
     try:
-        process_audio_files(play_file, rec_file, out_file)
+        process_audio_files(play_file, rec_file, out_file, lookahead_s)
     except KeyboardInterrupt:
         print("\nProcessing interrupted by user.")
         sys.exit(1)
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Real-time echo cancellation on the native processing thread of DuplexEngine
+
+This example plays the processed microphone signal back through the speakers,
+like realtime_echo_cancellation.py, but the audio callback only cuts the device
+blocks into 10 ms frames and queues them: the render/capture pairing, the stream
+delay and the processing itself all run on the real-time thread of the engine.
+
+Requirements:
+    pip install sounddevice numpy webrtc-audio-processing
+
+Usage:
+    python realtime_duplex_engine.py
+"""
+
+import time
+
+import numpy as np
+import sounddevice as sd
+import webrtc_audio_processing as webrtc_apm
+
+
+SAMPLE_RATE = 48000
+CHANNELS = 1
+BLOCK_SIZE = 0  # Let the audio backend choose
+
+
+class DuplexEchoCanceller:
+    def __init__(self):
+        config = webrtc_apm.Config()
+        config.echo_canceller.enabled = True
+        config.noise_suppression.enabled = True
+        config.noise_suppression.level = webrtc_apm.NoiseSuppressionLevel.MODERATE
+        config.high_pass_filter.enabled = True
+
+        self.engine = webrtc_apm.DuplexEngine(config, SAMPLE_RATE, CHANNELS)
+        self.pending = np.zeros((0, CHANNELS), dtype=np.int16)
+        self.stream = None
+
+    def audio_callback(self, in_data, out_data, frame_count, time_info, status):
+        """Full-duplex callback: queue the device audio, never process it."""
+        if status:
+            print(f"Audio callback status: {status}")
+
+        # Map the PortAudio stream times onto the clock of the engine.
+        now_us = webrtc_apm.DuplexEngine.now_us()
+        current_time = time_info.currentTime
+        capture_us = now_us + int((time_info.inputBufferAdcTime - current_time) * 1e6)
+        playout_us = now_us + int((time_info.outputBufferDacTime - current_time) * 1e6)
+
+        self.engine.on_capture(in_data, capture_us)
+
+        # Play whatever the engine has processed so far, padded with silence.
+        processed, _ = self.engine.read()
+        self.pending = np.concatenate((self.pending, processed))
+        available = min(frame_count, len(self.pending))
+        out_data[:available] = self.pending[:available]
+        out_data[available:] = 0
+        self.pending = self.pending[available:]
+
+        # The played audio is the echo reference.
+        self.engine.on_render(out_data, playout_us)
+
+    def run(self):
+        self.engine.start()
+        self.stream = sd.Stream(
+            samplerate=SAMPLE_RATE,
+            channels=CHANNELS,
+            dtype="int16",
+            blocksize=BLOCK_SIZE,
+            callback=self.audio_callback,
+        )
+        self.stream.start()
+        print("Real-time processing started, press Ctrl+C to stop")
+
+        while True:
+            time.sleep(5)
+            print(f"Engine stats: {self.engine.stats()}")
+
+    def stop(self):
+        if self.stream:
+            self.stream.stop()
+            self.stream.close()
+            self.stream = None
+        self.engine.stop()
+
+
+def main():
+    canceller = DuplexEchoCanceller()
+    try:
+        canceller.run()
+    except KeyboardInterrupt:
+        print("\nShutdown requested by user")
+    finally:
+        canceller.stop()
+
+
+if __name__ == "__main__":
+    main()
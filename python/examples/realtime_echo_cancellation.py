@@ -22,8 +22,6 @@ The script will:
 
 import sys
 import numpy as np
-import threading
-import queue
 import time
 
 
@@ -35,41 +33,32 @@ import webrtc_audio_processing as webrtc_apm
 SAMPLE_RATE = 24000  # WebRTC Audio Processing works best at 32kHz
 CHANNELS = 1         # Mono audio
 FRAME_SIZE_MS = 10   # 10ms frames (WebRTC standard)
-FRAME_SIZE = SAMPLE_RATE * FRAME_SIZE_MS // 1000  # 320 samples per frame
-CHUNK_SIZE = FRAME_SIZE  # PyAudio chunk size
+FRAME_SIZE = SAMPLE_RATE * FRAME_SIZE_MS // 1000  # 240 samples per frame
 
-# Buffer configuration
-BUFFER_SIZE = 10  # Number of frames to buffer
+# The device block size does not need to match the 10 ms frames: the stream
+# processor buffers partial frames natively.
+BLOCK_SIZE = 0  # Let the audio backend choose
 
 
 class RealTimeEchoCanceller:
     def __init__(self):
-        self.apm = None
-        self.stream_config = None
-
-        # Queues for audio data
-        self.mic_queue = queue.Queue(maxsize=BUFFER_SIZE)
-        self.speaker_queue = queue.Queue(maxsize=BUFFER_SIZE)
-        self.output_queue = queue.Queue(maxsize=BUFFER_SIZE)
+        self.processor = None
 
         # Streams
         self.stream = None
 
         # Control flags
         self.running = False
-        self.processing_thread = None
 
         # Statistics
-        self.frames_processed = 0
+        self.samples_processed = 0
         self.start_time = None
+        self.last_report_time = None
 
     def setup_webrtc_processor(self):
         """Initialize and configure the WebRTC Audio Processor."""
         print("Setting up WebRTC Audio Processor...")
 
-        # Create audio processing builder
-        builder = webrtc_apm.AudioProcessingBuilder()
-
         # Create configuration
         config = webrtc_apm.Config()
 
@@ -88,14 +77,14 @@ class RealTimeEchoCanceller:
         # Enable high-pass filter to remove low-frequency noise
         config.high_pass_filter.enabled = True
 
-        # Apply configuration and create processor
-        builder.SetConfig(config)
-        self.apm = builder.Create()
-
-        # Configure stream parameters
-        self.stream_config = webrtc_apm.StreamConfig(SAMPLE_RATE, CHANNELS)
+        # The stream processor accepts blocks of any length, processes the
+        # complete 10 ms frames natively and returns as many samples as it is
+        # given, delayed by a fixed latency.
+        self.processor = webrtc_apm.StreamProcessor(config, SAMPLE_RATE, CHANNELS)
 
-        print("WebRTC Audio Processor configured successfully")
+        latency_ms = 1000 * self.processor.latency_frames() / SAMPLE_RATE
+        print(f"WebRTC Audio Processor configured successfully "
+              f"(added latency: {latency_ms:.2f} ms)")
 
     def audio_callback(self, in_data, out_data, frame_count, time_info, status):
         """Full-duplex callback for microphone input and speaker output."""
@@ -103,102 +92,30 @@ class RealTimeEchoCanceller:
             print(f"Audio callback status: {status}")
 
         if in_data is None or len(in_data) == 0:
-            mic_frame = np.zeros(frame_count, dtype=np.int16)
+            mic_block = np.zeros((frame_count, CHANNELS), dtype=np.int16)
         else:
-            mic_frame = np.ascontiguousarray(in_data[:, 0], dtype=np.int16)
+            mic_block = in_data
 
         try:
-            # Add to microphone queue (non-blocking)
-            self.mic_queue.put_nowait(mic_frame.copy())
-        except queue.Full:
-            # Drop frame if queue is full
-            pass
+            processed = self.processor.process_capture(mic_block)
 
-        try:
-            # Get processed audio from output queue
-            audio_data = self.output_queue.get_nowait()
-
-            # Also add to speaker queue for echo cancellation reference
-            self.speaker_queue.put_nowait(audio_data.copy())
-
-            if len(audio_data) != frame_count:
-                if len(audio_data) < frame_count:
-                    audio_data = np.pad(audio_data, (0, frame_count - len(audio_data)))
-                else:
-                    audio_data = audio_data[:frame_count]
-            out_data[:] = audio_data.reshape(-1, 1)
-        except queue.Empty:
-            # Return silence if no processed audio available
+            # The played audio is the echo reference.
+            self.processor.process_render(processed)
+            out_data[:] = processed
+        except Exception as e:
+            print(f"Error in audio callback: {e}")
             out_data[:] = 0
+            return
+
+        self.samples_processed += frame_count
 
-    def process_audio(self):
-        """Audio processing thread - applies WebRTC processing."""
-        print("Starting audio processing thread...")
-
-        while self.running:
-            try:
-                # Get microphone input (with timeout)
-                mic_frame = self.mic_queue.get(timeout=0.1)
-
-                # Get speaker reference (use zeros if not available)
-                try:
-                    speaker_frame = self.speaker_queue.get_nowait()
-                except queue.Empty:
-                    speaker_frame = np.zeros(FRAME_SIZE, dtype=np.int16)
-
-                # Ensure frames are the correct size and contiguous
-                if len(mic_frame) != FRAME_SIZE:
-                    # Pad or truncate to correct size
-                    if len(mic_frame) < FRAME_SIZE:
-                        mic_frame = np.pad(mic_frame, (0, FRAME_SIZE - len(mic_frame)))
-                    else:
-                        mic_frame = mic_frame[:FRAME_SIZE]
-
-                if len(speaker_frame) != FRAME_SIZE:
-                    if len(speaker_frame) < FRAME_SIZE:
-                        speaker_frame = np.pad(speaker_frame, (0, FRAME_SIZE - len(speaker_frame)))
-                    else:
-                        speaker_frame = speaker_frame[:FRAME_SIZE]
-
-                # Make arrays contiguous
-                mic_frame = np.ascontiguousarray(mic_frame, dtype=np.int16)
-                speaker_frame = np.ascontiguousarray(speaker_frame, dtype=np.int16)
-
-                # Process reverse stream (speaker/playback audio for echo reference)
-                result = self.apm.ProcessReverseStream(
-                    speaker_frame, self.stream_config, self.stream_config, speaker_frame
-                )
-                if result != webrtc_apm.Error.NO_ERROR:
-                    print(f"ProcessReverseStream error: {result}")
-
-                # Process forward stream (microphone audio)
-                processed_frame = mic_frame.copy()
-                result = self.apm.ProcessStream(
-                    mic_frame, self.stream_config, self.stream_config, processed_frame
-                )
-                if result != webrtc_apm.Error.NO_ERROR:
-                    print(f"ProcessStream error: {result}")
-
-                # Add processed audio to output queue
-                try:
-                    self.output_queue.put_nowait(processed_frame)
-                except queue.Full:
-                    # Drop frame if queue is full
-                    pass
-
-                self.frames_processed += 1
-
-                # Print statistics every 5 seconds
-                if self.frames_processed % (5 * SAMPLE_RATE // FRAME_SIZE) == 0:
-                    elapsed = time.time() - self.start_time
-                    fps = self.frames_processed / elapsed
-                    print(f"Processed {self.frames_processed} frames in {elapsed:.1f}s ({fps:.1f} fps)")
-
-            except queue.Empty:
-                continue
-            except Exception as e:
-                print(f"Error in processing thread: {e}")
-                continue
+        # Print statistics every 5 seconds
+        now = time.time()
+        if now - self.last_report_time >= 5:
+            self.last_report_time = now
+            elapsed = now - self.start_time
+            print(f"Processed {self.samples_processed / SAMPLE_RATE:.1f}s of audio "
+                  f"in {elapsed:.1f}s")
 
     def start(self):
         """Start real-time audio processing."""
@@ -208,25 +125,22 @@ class RealTimeEchoCanceller:
         self.setup_webrtc_processor()
 
         # Open audio streams
-        print(f"Opening audio streams (sample rate: {SAMPLE_RATE}Hz, frame size: {FRAME_SIZE})")
+        print(f"Opening audio streams (sample rate: {SAMPLE_RATE}Hz)")
 
         try:
+            self.running = True
+            self.start_time = self.last_report_time = time.time()
+
             # Full-duplex stream (microphone + speakers)
             self.stream = sd.Stream(
                 samplerate=SAMPLE_RATE,
                 channels=CHANNELS,
                 dtype="int16",
-                blocksize=CHUNK_SIZE,
+                blocksize=BLOCK_SIZE,
                 callback=self.audio_callback,
             )
             self.stream.start()
 
-            # Start processing thread
-            self.running = True
-            self.start_time = time.time()
-            self.processing_thread = threading.Thread(target=self.process_audio)
-            self.processing_thread.start()
-
             print("Real-time processing started!")
             print("Speak into your microphone - the processed audio will play through speakers")
             print("Echo cancellation is active to prevent feedback")
@@ -246,23 +160,19 @@ class RealTimeEchoCanceller:
 
         self.running = False
 
-        # Wait for processing thread to finish
-        if self.processing_thread and self.processing_thread.is_alive():
-            self.processing_thread.join(timeout=2.0)
-
         # Stop and close stream
         if self.stream:
             self.stream.stop()
             self.stream.close()
+            self.stream = None
 
         print("Stopped successfully")
 
         # Print final statistics
         if self.start_time:
             elapsed = time.time() - self.start_time
-            print(f"Total frames processed: {self.frames_processed}")
+            print(f"Total audio processed: {self.samples_processed / SAMPLE_RATE:.1f}s")
             print(f"Processing time: {elapsed:.1f}s")
-            print(f"Average frame rate: {self.frames_processed / elapsed:.1f} fps")
 
 
 def list_audio_devices():
@@ -2,18 +2,24 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <api/audio/audio_processing.h>
 #include <api/scoped_refptr.h>
 #include <common_audio/resampler/include/resampler.h>
+#include <modules/audio_processing/duplex/duplex_engine.h>
 #include <modules/audio_processing/rms_level.h>
 #include <modules/audio_processing/vad/standalone_vad.h>
 #include <modules/audio_processing/vad/voice_activity_detector.h>
+#include <rtc_base/time_utils.h>
 
 // Include VAD header directly from source tree
 extern "C" {
@@ -161,24 +167,206 @@ private:
     size_t num_channels_;
 };
 
+// First-in first-out buffer of interleaved samples. The samples are kept
+// contiguous so that complete frames can be passed to AudioProcessing without
+// copies; consumed samples are reclaimed when the buffer would otherwise grow.
+class SampleFifo {
+public:
+    size_t size() const { return end_ - begin_; }
+    const int16_t* data() const { return buffer_.data() + begin_; }
+
+    // Returns space for `count` samples at the end of the buffer.
+    int16_t* Append(size_t count) {
+        if (end_ + count > buffer_.size()) {
+            if (begin_ > 0) {
+                std::memmove(buffer_.data(), data(), size() * sizeof(int16_t));
+                end_ -= begin_;
+                begin_ = 0;
+            }
+            if (end_ + count > buffer_.size()) {
+                buffer_.resize(end_ + count);
+            }
+        }
+        int16_t* const tail = buffer_.data() + end_;
+        end_ += count;
+        return tail;
+    }
+
+    void Push(const int16_t* samples, size_t count) {
+        std::memcpy(Append(count), samples, count * sizeof(int16_t));
+    }
+
+    void Pop(int16_t* samples, size_t count) {
+        std::memcpy(samples, data(), count * sizeof(int16_t));
+        Drop(count);
+    }
+
+    void Drop(size_t count) {
+        begin_ += count;
+        if (begin_ == end_) {
+            begin_ = end_ = 0;
+        }
+    }
+
+private:
+    std::vector<int16_t> buffer_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+};
+
+// Runs AudioProcessing on capture and render audio delivered in chunks of any
+// length. Complete 10 ms frames are processed as soon as they are buffered,
+// and the processed capture audio is returned with a fixed latency of one
+// frame minus one sample, which is the least latency that lets every call
+// return as many samples as it was given. Capture and render audio can be
+// passed from different threads.
+class StreamProcessor {
+public:
+    StreamProcessor(const webrtc::AudioProcessing::Config& config,
+                    int sample_rate_hz,
+                    size_t num_channels,
+                    size_t render_num_channels)
+        : capture_config_(sample_rate_hz, num_channels),
+          render_config_(sample_rate_hz, render_num_channels) {
+        if (sample_rate_hz <= 0 || sample_rate_hz % 100 != 0) {
+            throw std::invalid_argument("sample_rate_hz must be a positive multiple of 100");
+        }
+        if (num_channels == 0 || render_num_channels == 0) {
+            throw std::invalid_argument("The channel counts must be positive");
+        }
+        apm_ = webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+        if (!apm_) {
+            throw std::runtime_error("Failed to create AudioProcessing");
+        }
+        const int error = apm_->Initialize(webrtc::ProcessingConfig{
+            {capture_config_, capture_config_, render_config_, render_config_}});
+        if (error != webrtc::AudioProcessing::kNoError) {
+            throw std::runtime_error("AudioProcessing Initialize failed with error " +
+                                     std::to_string(error));
+        }
+        render_output_.resize(render_config_.num_samples());
+        std::fill_n(capture_output_.Append(latency_frames() * num_channels),
+                    latency_frames() * num_channels, 0);
+    }
+
+    // Buffers `num_samples` interleaved capture samples, processes the complete
+    // frames and writes `num_samples` processed samples to `dest`.
+    void ProcessCapture(const int16_t* src, size_t num_samples, int16_t* dest) {
+        std::lock_guard<std::mutex> lock(capture_mutex_);
+        capture_input_.Push(src, num_samples);
+        const size_t frame_samples = capture_config_.num_samples();
+        while (capture_input_.size() >= frame_samples) {
+            if (stream_delay_ms_) {
+                apm_->set_stream_delay_ms(*stream_delay_ms_);
+            }
+            CheckError(apm_->ProcessStream(capture_input_.data(), capture_config_,
+                                           capture_config_,
+                                           capture_output_.Append(frame_samples)),
+                       "ProcessStream");
+            capture_input_.Drop(frame_samples);
+        }
+        capture_output_.Pop(dest, num_samples);
+    }
+
+    // Buffers `num_samples` interleaved render samples and analyzes the
+    // complete frames.
+    void ProcessRender(const int16_t* src, size_t num_samples) {
+        std::lock_guard<std::mutex> lock(render_mutex_);
+        render_input_.Push(src, num_samples);
+        const size_t frame_samples = render_config_.num_samples();
+        while (render_input_.size() >= frame_samples) {
+            CheckError(apm_->ProcessReverseStream(render_input_.data(), render_config_,
+                                                  render_config_, render_output_.data()),
+                       "ProcessReverseStream");
+            render_input_.Drop(frame_samples);
+        }
+    }
+
+    // The delay is passed to AudioProcessing before each processed frame.
+    void set_stream_delay_ms(int delay_ms) {
+        std::lock_guard<std::mutex> lock(capture_mutex_);
+        stream_delay_ms_ = delay_ms;
+    }
+
+    size_t latency_frames() const { return capture_config_.num_frames() - 1; }
+    int sample_rate_hz() const { return capture_config_.sample_rate_hz(); }
+    size_t num_channels() const { return capture_config_.num_channels(); }
+    size_t render_num_channels() const { return render_config_.num_channels(); }
+    webrtc::AudioProcessing* apm() const { return apm_.get(); }
+
+private:
+    static void CheckError(int error, const char* function) {
+        if (error != webrtc::AudioProcessing::kNoError) {
+            throw std::runtime_error(std::string(function) + " failed with error " +
+                                     std::to_string(error));
+        }
+    }
+
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm_;
+    const webrtc::StreamConfig capture_config_;
+    const webrtc::StreamConfig render_config_;
+
+    std::mutex capture_mutex_;
+    SampleFifo capture_input_;
+    SampleFifo capture_output_;
+    std::optional<int> stream_delay_ms_;
+
+    std::mutex render_mutex_;
+    SampleFifo render_input_;
+    std::vector<int16_t> render_output_;
+};
+
+// Returns the number of samples of `buf`, which must hold interleaved audio
+// with `num_channels` channels, either flat or of shape (num_frames,
+// num_channels).
+size_t InterleavedSamples(const py::buffer_info& buf, size_t num_channels) {
+    if (buf.ndim == 2 && static_cast<size_t>(buf.shape[1]) == num_channels) {
+        return buf.shape[0] * num_channels;
+    }
+    if (buf.ndim == 1 && buf.shape[0] % num_channels == 0) {
+        return buf.shape[0];
+    }
+    throw std::invalid_argument(
+        "audio must have shape (num_frames, num_channels) or be interleaved with a "
+        "length that is a multiple of num_channels");
+}
+
+// Throws ValueError unless `buf` holds exactly one frame of `config`, i.e.
+// config.num_samples() samples for its frame_size_ms(), as the raw int16
+// ProcessStream and ProcessReverseStream would otherwise read or write past the
+// end of the array.
+void CheckFrameSize(const py::buffer_info& buf,
+                    const webrtc::StreamConfig& config,
+                    const char* name) {
+    if (static_cast<size_t>(buf.size) != config.num_samples()) {
+        throw std::invalid_argument(
+            std::string(name) + " has " + std::to_string(buf.size) +
+            " samples, expected " + std::to_string(config.num_samples()));
+    }
+}
+
 PYBIND11_MODULE(webrtc_audio_processing, m) {
     m.doc() = "Python bindings for WebRTC Audio Processing";
 
     // StreamConfig class
     py::class_<webrtc::StreamConfig>(m, "StreamConfig")
-        .def(py::init<int, size_t>(), 
+        .def(py::init<int, size_t, int>(), 
              py::arg("sample_rate_hz") = 0, 
-             py::arg("num_channels") = 0)
+             py::arg("num_channels") = 0,
+             py::arg("frame_size_ms") = 10)
         .def("set_sample_rate_hz", &webrtc::StreamConfig::set_sample_rate_hz)
         .def("set_num_channels", &webrtc::StreamConfig::set_num_channels)
+        .def("set_frame_size_ms", &webrtc::StreamConfig::set_frame_size_ms)
         .def("sample_rate_hz", &webrtc::StreamConfig::sample_rate_hz)
         .def("num_channels", &webrtc::StreamConfig::num_channels)
+        .def("frame_size_ms", &webrtc::StreamConfig::frame_size_ms)
         .def("num_frames", &webrtc::StreamConfig::num_frames)
         .def("num_samples", &webrtc::StreamConfig::num_samples);
 
     // AudioProcessing Config structures
     py::class_<webrtc::AudioProcessing::Config>(m, "Config")
         .def(py::init<>())
+        .def_readwrite("pipeline", &webrtc::AudioProcessing::Config::pipeline)
         .def_readwrite("high_pass_filter", &webrtc::AudioProcessing::Config::high_pass_filter)
         .def_readwrite("echo_canceller", &webrtc::AudioProcessing::Config::echo_canceller)
         .def_readwrite("noise_suppression", &webrtc::AudioProcessing::Config::noise_suppression)
@@ -186,6 +374,10 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
         .def_readwrite("gain_controller2", &webrtc::AudioProcessing::Config::gain_controller2);
 
     // Config sub-structures
+    py::class_<webrtc::AudioProcessing::Config::Pipeline>(m, "Pipeline")
+        .def(py::init<>())
+        .def_readwrite("low_memory", &webrtc::AudioProcessing::Config::Pipeline::low_memory);
+
     py::class_<webrtc::AudioProcessing::Config::HighPassFilter>(m, "HighPassFilter")
         .def(py::init<>())
         .def_readwrite("enabled", &webrtc::AudioProcessing::Config::HighPassFilter::enabled)
@@ -233,6 +425,18 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
     // AudioProcessing class
     py::class_<webrtc::AudioProcessing>(m, "AudioProcessing")
         .def("Initialize", py::overload_cast<>(&webrtc::AudioProcessing::Initialize))
+        .def("Initialize",
+             [](webrtc::AudioProcessing& self,
+                const webrtc::StreamConfig& input_config,
+                const webrtc::StreamConfig& output_config,
+                const webrtc::StreamConfig& reverse_input_config,
+                const webrtc::StreamConfig& reverse_output_config) -> int {
+                 return self.Initialize(webrtc::ProcessingConfig{
+                     {input_config, output_config, reverse_input_config, reverse_output_config}});
+             },
+             py::arg("input_config"), py::arg("output_config"),
+             py::arg("reverse_input_config"), py::arg("reverse_output_config"),
+             "Initialize for the given stream formats, e.g., before restoring an echo canceller state")
         .def("ApplyConfig", &webrtc::AudioProcessing::ApplyConfig)
         .def("ProcessStream", 
              [](webrtc::AudioProcessing& self, 
@@ -242,6 +446,8 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
                 py::array_t<int16_t> dest) -> int {
                  auto src_buf = src.request();
                  auto dest_buf = dest.request();
+                 CheckFrameSize(src_buf, input_config, "src");
+                 CheckFrameSize(dest_buf, output_config, "dest");
                  return self.ProcessStream(
                      static_cast<const int16_t*>(src_buf.ptr),
                      input_config,
@@ -256,18 +462,67 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
                 py::array_t<int16_t> dest) -> int {
                  auto src_buf = src.request();
                  auto dest_buf = dest.request();
+                 CheckFrameSize(src_buf, input_config, "src");
+                 CheckFrameSize(dest_buf, output_config, "dest");
                  return self.ProcessReverseStream(
                      static_cast<const int16_t*>(src_buf.ptr),
                      input_config,
                      output_config,
                      static_cast<int16_t*>(dest_buf.ptr));
              })
+        .def("AnalyzeReverseReferences",
+             [](webrtc::AudioProcessing& self,
+                py::array_t<float, py::array::c_style | py::array::forcecast> references,
+                const webrtc::StreamConfig& reference_config) -> int {
+                 auto buf = references.request();
+                 if (buf.ndim != 2 ||
+                     static_cast<size_t>(buf.shape[0]) != reference_config.num_channels() ||
+                     static_cast<size_t>(buf.shape[1]) != reference_config.num_frames()) {
+                     throw std::invalid_argument(
+                         "references must have shape (num_channels, num_frames)");
+                 }
+                 std::vector<const float*> channels(buf.shape[0]);
+                 for (size_t ch = 0; ch < channels.size(); ++ch) {
+                     channels[ch] = static_cast<const float*>(buf.ptr) + ch * buf.shape[1];
+                 }
+                 return self.AnalyzeReverseReferences(channels.data(), reference_config);
+             },
+             py::arg("references"), py::arg("reference_config"),
+             "Analyze one 10 ms float frame per independently delayed render reference")
         .def("set_stream_delay_ms", &webrtc::AudioProcessing::set_stream_delay_ms)
         .def("stream_delay_ms", &webrtc::AudioProcessing::stream_delay_ms)
         .def("set_stream_analog_level", &webrtc::AudioProcessing::set_stream_analog_level)
         .def("recommended_stream_analog_level", &webrtc::AudioProcessing::recommended_stream_analog_level)
         .def("set_stream_key_pressed", &webrtc::AudioProcessing::set_stream_key_pressed)
-        .def("GetConfig", &webrtc::AudioProcessing::GetConfig);
+        .def("GetEchoControllerState",
+             [](const webrtc::AudioProcessing& self) -> py::bytes {
+                 const std::vector<uint8_t> state = self.GetEchoControllerState();
+                 return py::bytes(reinterpret_cast<const char*>(state.data()), state.size());
+             },
+             "Snapshot of the adapted echo canceller state as bytes (empty if unavailable)")
+        .def("SetEchoControllerState",
+             [](webrtc::AudioProcessing& self, py::bytes state) -> bool {
+                 const std::string data = state;
+                 return self.SetEchoControllerState(rtc::ArrayView<const uint8_t>(
+                     reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+             },
+             py::arg("state"),
+             "Restore a snapshot from GetEchoControllerState(); call after the first ProcessStream() or Initialize() with the stream formats")
+        .def("GetConfig", &webrtc::AudioProcessing::GetConfig)
+        .def("GetMemoryUsage", &webrtc::AudioProcessing::GetMemoryUsage,
+             "Bytes allocated by the audio buffers and each submodule");
+
+    py::class_<webrtc::AudioProcessing::MemoryUsage>(m, "MemoryUsage")
+        .def_readonly("audio_buffers", &webrtc::AudioProcessing::MemoryUsage::audio_buffers)
+        .def_readonly("render_queues", &webrtc::AudioProcessing::MemoryUsage::render_queues)
+        .def_readonly("echo_controller", &webrtc::AudioProcessing::MemoryUsage::echo_controller)
+        .def_readonly("echo_control_mobile", &webrtc::AudioProcessing::MemoryUsage::echo_control_mobile)
+        .def_readonly("gain_control", &webrtc::AudioProcessing::MemoryUsage::gain_control)
+        .def_readonly("gain_controller2", &webrtc::AudioProcessing::MemoryUsage::gain_controller2)
+        .def_readonly("noise_suppressor", &webrtc::AudioProcessing::MemoryUsage::noise_suppressor)
+        .def_readonly("high_pass_filter", &webrtc::AudioProcessing::MemoryUsage::high_pass_filter)
+        .def_readonly("other", &webrtc::AudioProcessing::MemoryUsage::other)
+        .def("total", &webrtc::AudioProcessing::MemoryUsage::total);
 
     // AudioProcessingBuilder class
     py::class_<webrtc::AudioProcessingBuilder>(m, "AudioProcessingBuilder")
@@ -406,6 +661,178 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
             "kInaudibleButNotMuted",
             [](py::object) { return webrtc::RmsLevel::kInaudibleButNotMuted; });
 
+    // Streaming processor
+    py::class_<StreamProcessor>(m, "StreamProcessor")
+        .def(py::init([](const webrtc::AudioProcessing::Config& config,
+                         int sample_rate_hz,
+                         size_t num_channels,
+                         std::optional<size_t> render_num_channels) {
+                 return std::make_unique<StreamProcessor>(
+                     config, sample_rate_hz, num_channels,
+                     render_num_channels.value_or(num_channels));
+             }),
+             py::arg("config"),
+             py::arg("sample_rate_hz"),
+             py::arg("num_channels") = 1,
+             py::arg("render_num_channels") = py::none())
+        .def("process_capture",
+             [](StreamProcessor& self,
+                py::array_t<int16_t, py::array::c_style | py::array::forcecast> audio) {
+                 const py::buffer_info buf = audio.request();
+                 const size_t num_samples = InterleavedSamples(buf, self.num_channels());
+                 py::array_t<int16_t> result(buf.shape);
+                 int16_t* dest = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     self.ProcessCapture(static_cast<const int16_t*>(buf.ptr),
+                                         num_samples, dest);
+                 }
+                 return result;
+             },
+             py::arg("audio"),
+             "Process int16 capture audio of any length and return as many processed "
+             "samples, delayed by latency_frames()")
+        .def("process_render",
+             [](StreamProcessor& self,
+                py::array_t<int16_t, py::array::c_style | py::array::forcecast> audio) {
+                 const py::buffer_info buf = audio.request();
+                 const size_t num_samples =
+                     InterleavedSamples(buf, self.render_num_channels());
+                 py::gil_scoped_release release;
+                 self.ProcessRender(static_cast<const int16_t*>(buf.ptr), num_samples);
+             },
+             py::arg("audio"),
+             "Analyze int16 render audio of any length as echo reference")
+        .def("set_stream_delay_ms", &StreamProcessor::set_stream_delay_ms,
+             py::arg("delay_ms"),
+             "Set the render to capture delay passed to AudioProcessing with every frame")
+        .def("latency_frames", &StreamProcessor::latency_frames,
+             "Delay of the processed capture audio in samples per channel")
+        .def("sample_rate_hz", &StreamProcessor::sample_rate_hz)
+        .def("num_channels", &StreamProcessor::num_channels)
+        .def("render_num_channels", &StreamProcessor::render_num_channels)
+        .def("apm", &StreamProcessor::apm, py::return_value_policy::reference_internal,
+             "The wrapped AudioProcessing, e.g. for ApplyConfig() or the analog level");
+
+    // Full-duplex engine
+    py::class_<webrtc::DuplexEngine>(m, "DuplexEngine")
+        .def(py::init([](const webrtc::AudioProcessing::Config& config,
+                         int sample_rate_hz,
+                         size_t num_capture_channels,
+                         std::optional<size_t> num_render_channels,
+                         size_t queue_size_frames) {
+                 if (sample_rate_hz <= 0 || sample_rate_hz % 100 != 0) {
+                     throw std::invalid_argument("sample_rate_hz must be a positive multiple of 100");
+                 }
+                 webrtc::DuplexEngine::Config engine_config;
+                 engine_config.sample_rate_hz = sample_rate_hz;
+                 engine_config.num_capture_channels = num_capture_channels;
+                 engine_config.num_render_channels =
+                     num_render_channels.value_or(num_capture_channels);
+                 engine_config.queue_size_frames = queue_size_frames;
+                 if (engine_config.num_capture_channels == 0 ||
+                     engine_config.num_render_channels == 0 ||
+                     engine_config.queue_size_frames == 0) {
+                     throw std::invalid_argument(
+                         "The channel counts and queue_size_frames must be positive");
+                 }
+                 auto apm = webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+                 if (!apm) {
+                     throw std::runtime_error("Failed to create AudioProcessing");
+                 }
+                 return std::make_unique<webrtc::DuplexEngine>(engine_config, apm);
+             }),
+             py::arg("config"),
+             py::arg("sample_rate_hz"),
+             py::arg("num_capture_channels") = 1,
+             py::arg("num_render_channels") = py::none(),
+             py::arg("queue_size_frames") = 50)
+        .def("start", &webrtc::DuplexEngine::Start,
+             "Start the real-time processing thread")
+        .def("stop", &webrtc::DuplexEngine::Stop,
+             py::call_guard<py::gil_scoped_release>(),
+             "Stop the processing thread")
+        .def("on_render",
+             [](webrtc::DuplexEngine& self,
+                py::array_t<int16_t, py::array::c_style | py::array::forcecast> audio,
+                int64_t playout_time_us) {
+                 const py::buffer_info buf = audio.request();
+                 const size_t num_channels = self.config().num_render_channels;
+                 const size_t num_samples = InterleavedSamples(buf, num_channels);
+                 py::gil_scoped_release release;
+                 self.OnRenderData(webrtc::InterleavedView<const int16_t>(
+                                       static_cast<const int16_t*>(buf.ptr),
+                                       num_samples / num_channels, num_channels),
+                                   playout_time_us);
+             },
+             py::arg("audio"), py::arg("playout_time_us"),
+             "Queue int16 audio of any length about to be played out at playout_time_us")
+        .def("on_capture",
+             [](webrtc::DuplexEngine& self,
+                py::array_t<int16_t, py::array::c_style | py::array::forcecast> audio,
+                int64_t capture_time_us) {
+                 const py::buffer_info buf = audio.request();
+                 const size_t num_channels = self.config().num_capture_channels;
+                 const size_t num_samples = InterleavedSamples(buf, num_channels);
+                 py::gil_scoped_release release;
+                 self.OnCaptureData(webrtc::InterleavedView<const int16_t>(
+                                        static_cast<const int16_t*>(buf.ptr),
+                                        num_samples / num_channels, num_channels),
+                                    capture_time_us);
+             },
+             py::arg("audio"), py::arg("capture_time_us"),
+             "Queue int16 audio of any length captured at capture_time_us")
+        .def("read",
+             [](webrtc::DuplexEngine& self) {
+                 const size_t num_channels = self.config().num_capture_channels;
+                 const size_t frame_samples = self.frame_size() * num_channels;
+                 std::vector<int16_t> samples;
+                 std::optional<int64_t> first_capture_time_us;
+                 {
+                     py::gil_scoped_release release;
+                     std::vector<int16_t> frame(frame_samples);
+                     int64_t capture_time_us = 0;
+                     while (self.ReadProcessedFrame(
+                         webrtc::InterleavedView<int16_t>(frame.data(), self.frame_size(),
+                                                          num_channels),
+                         &capture_time_us)) {
+                         if (!first_capture_time_us) {
+                             first_capture_time_us = capture_time_us;
+                         }
+                         samples.insert(samples.end(), frame.begin(), frame.end());
+                     }
+                 }
+                 py::array_t<int16_t> result(
+                     {static_cast<py::ssize_t>(samples.size() / num_channels),
+                      static_cast<py::ssize_t>(num_channels)});
+                 std::memcpy(result.mutable_data(), samples.data(),
+                             samples.size() * sizeof(int16_t));
+                 return py::make_tuple(result, first_capture_time_us);
+             },
+             "Pop the processed audio, as a (num_frames, num_channels) array, and the "
+             "capture time of its first sample (None if no audio is available)")
+        .def("stats",
+             [](const webrtc::DuplexEngine& self) {
+                 const webrtc::DuplexEngine::Stats stats = self.GetStats();
+                 py::dict result;
+                 result["render_frames_dropped"] = stats.render_frames_dropped;
+                 result["capture_frames_dropped"] = stats.capture_frames_dropped;
+                 result["output_frames_dropped"] = stats.output_frames_dropped;
+                 result["render_errors"] = stats.render_errors;
+                 result["capture_errors"] = stats.capture_errors;
+                 result["stream_delay_ms"] = stats.stream_delay_ms;
+                 return result;
+             },
+             "Dropped frame counts, processing error counts and the last computed "
+             "stream delay")
+        .def("frame_size", &webrtc::DuplexEngine::frame_size,
+             "Samples per channel of the 10 ms frames")
+        .def("apm", &webrtc::DuplexEngine::audio_processing,
+             py::return_value_policy::reference_internal,
+             "The wrapped AudioProcessing")
+        .def_static("now_us", &rtc::TimeMicros,
+                    "Current time in the clock of the render and capture timestamps");
+
     // Resampler wrapper
     py::class_<ResamplerWrapper>(m, "Resampler")
         .def(py::init<int, int, size_t>(),
@@ -56,6 +56,8 @@ __all__ = [
     "AudioProcessingBuilder", 
     "Config",
     "StreamConfig",
+    "StreamProcessor",
+    "DuplexEngine",
     "HighPassFilter",
     "EchoCanceller", 
     "NoiseSuppression",
@@ -104,7 +104,8 @@ bool Agc2Config::operator==(const Agc2Config& rhs) const {
   return enabled == rhs.enabled &&
          fixed_digital.gain_db == rhs.fixed_digital.gain_db &&
          adaptive_digital == rhs.adaptive_digital &&
-         input_volume_controller == rhs.input_volume_controller;
+         input_volume_controller == rhs.input_volume_controller &&
+         analysis_period_frames == rhs.analysis_period_frames;
 }
 
 bool AudioProcessing::Config::CaptureLevelAdjustment::operator==(
@@ -129,6 +130,7 @@ std::string AudioProcessing::Config::ToString() const {
           << pipeline.maximum_internal_processing_rate
           << ", multi_channel_render: " << pipeline.multi_channel_render
           << ", multi_channel_capture: " << pipeline.multi_channel_capture
+          << ", low_memory: " << pipeline.low_memory
           << " }, pre_amplifier: { enabled: " << pre_amplifier.enabled
           << ", fixed_gain_factor: " << pre_amplifier.fixed_gain_factor
           << " },capture_level_adjustment: { enabled: "
@@ -204,7 +206,9 @@ std::string AudioProcessing::Config::ToString() const {
           << ", max_output_noise_level_dbfs: "
           << gain_controller2.adaptive_digital.max_output_noise_level_dbfs
           << " }, input_volume_control : { enabled "
-          << gain_controller2.input_volume_controller.enabled << "}}";
+          << gain_controller2.input_volume_controller.enabled
+          << "}, analysis_period_frames: "
+          << gain_controller2.analysis_period_frames << "}";
   return builder.str();
 }
 
@@ -27,6 +27,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/strings/string_view.h"
@@ -162,6 +163,12 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       // Indicates how to downmix multi-channel capture audio to mono (when
       // needed).
       DownmixMethod capture_downmix_method = DownmixMethod::kAverageChannels;
+      // Reduces the memory footprint of the built-in submodules at the cost of
+      // robustness: the echo canceller covers echo path delays of up to about
+      // 300 ms instead of 500 ms, and the render queues hold 200 ms instead of
+      // 1 s of audio, so that the echo canceller drops render audio in longer
+      // bursts of render calls.
+      bool low_memory = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
@@ -378,6 +385,21 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
         // turned into a compressor that first applies a fixed gain.
         float gain_db = 0.0f;
       } fixed_digital;
+
+      // Decimates the signal analysis of the input volume and adaptive
+      // digital controllers (i.e., voice activity detection and input, noise
+      // and speech level estimation) by running it on one out of every
+      // `analysis_period_frames` bursts of four consecutive 10 ms frames,
+      // with `analysis_period_frames` in [1, 10]; the results are reused for
+      // the other frames. The gains are still updated and the limiter still
+      // runs every frame. Periods greater than one reduce the complexity where
+      // the levels change slowly (e.g., broadcast ingest). On speech-like
+      // material with abrupt level changes, periods up to 4 keep the adaptive
+      // digital gain within 0.75 dB of the undecimated gain on average and
+      // within 3 dB for 95% of the frames; periods up to 10 within 1.5 dB and
+      // 4.5 dB respectively. The largest deviations follow abrupt level
+      // changes. A speech probability provided by the caller is never reused.
+      int analysis_period_frames = 1;
     } gain_controller2;
 
     std::string ToString() const;
@@ -544,9 +566,11 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // enqueueing was successfull.
   virtual bool PostRuntimeSetting(RuntimeSetting setting) = 0;
 
-  // Accepts and produces a ~10 ms frame of interleaved 16 bit integer audio as
-  // specified in `input_config` and `output_config`. `src` and `dest` may use
-  // the same memory, if desired.
+  // Accepts and produces a frame of interleaved 16 bit integer audio as
+  // specified in `input_config` and `output_config`. The frame is ~10 ms or,
+  // as set by StreamConfig::frame_size_ms(), a multiple thereof, which is then
+  // processed in 10 ms chunks. `src` and `dest` may use the same memory, if
+  // desired.
   virtual int ProcessStream(const int16_t* const src,
                             const StreamConfig& input_config,
                             const StreamConfig& output_config,
@@ -564,9 +588,10 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
                             const StreamConfig& output_config,
                             float* const* dest) = 0;
 
-  // Accepts and produces a ~10 ms frame of interleaved 16 bit integer audio for
-  // the reverse direction audio stream as specified in `input_config` and
-  // `output_config`. `src` and `dest` may use the same memory, if desired.
+  // Accepts and produces a ~10 ms frame, or a multiple thereof, of interleaved
+  // 16 bit integer audio for the reverse direction audio stream as specified
+  // in `input_config` and `output_config`. `src` and `dest` may use the same
+  // memory, if desired.
   virtual int ProcessReverseStream(const int16_t* const src,
                                    const StreamConfig& input_config,
                                    const StreamConfig& output_config,
@@ -585,6 +610,16 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   virtual int AnalyzeReverseStream(const float* const* data,
                                    const StreamConfig& reverse_config) = 0;
 
+  // Like AnalyzeReverseStream(), but each channel of `references` is a
+  // separate mono render reference, such as the signal played out on a
+  // separate device, that may reach the microphones with its own delay. The
+  // references are never downmixed, and the echo canceller estimates and
+  // compensates for the delay of each of them separately. The number of
+  // references is given by the number of channels of `reference_config`.
+  virtual int AnalyzeReverseReferences(
+      const float* const* references,
+      const StreamConfig& reference_config) = 0;
+
   // Returns the most recently produced ~10 ms of the linear AEC output at a
   // rate of 16 kHz. If there is more than one capture channel, a mono
   // representation of the input is returned. Returns true/false to indicate
@@ -592,6 +627,19 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   virtual bool GetLinearAecOutput(
       rtc::ArrayView<std::array<float, 160>> linear_output) const = 0;
 
+  // Returns a snapshot of the adapted echo canceller state, such as the echo
+  // path estimate, which can be restored with SetEchoControllerState() to
+  // warm-start a later session on the same device. Returns an empty vector if
+  // no echo canceller is active or if it does not support snapshots.
+  virtual std::vector<uint8_t> GetEchoControllerState() const = 0;
+
+  // Restores a snapshot produced by GetEchoControllerState(). As the echo
+  // canceller is recreated when the stream formats change, this should be
+  // called once the formats are set, e.g., after the first call to
+  // ProcessStream(). Returns false if the snapshot is not compatible with the
+  // active echo canceller.
+  virtual bool SetEchoControllerState(rtc::ArrayView<const uint8_t> state) = 0;
+
   // This must be called prior to ProcessStream() if and only if adaptive analog
   // gain control is enabled, to pass the current analog level from the audio
   // HAL. Must be within the range [0, 255].
@@ -668,6 +716,35 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // Returns the last applied configuration.
   virtual AudioProcessing::Config GetConfig() const = 0;
 
+  // Memory footprint of an instance in bytes, broken down by submodule. The
+  // memory of disabled submodules is released, and the footprint of an
+  // injected echo controller is only included if it reports it.
+  struct MemoryUsage {
+    // Audio buffers for the capture and the render signals.
+    size_t audio_buffers = 0;
+    // Queues passing render audio to the capture side of the submodules.
+    size_t render_queues = 0;
+    size_t echo_controller = 0;
+    size_t echo_control_mobile = 0;
+    // AGC1, including its analog gain controller.
+    size_t gain_control = 0;
+    size_t gain_controller2 = 0;
+    size_t noise_suppressor = 0;
+    size_t high_pass_filter = 0;
+    // The instance itself and the remaining submodules.
+    size_t other = 0;
+
+    size_t total() const {
+      return audio_buffers + render_queues + echo_controller +
+             echo_control_mobile + gain_control + gain_controller2 +
+             noise_suppressor + high_pass_filter + other;
+    }
+  };
+
+  // Returns the current memory footprint of the instance. The allocator
+  // overhead is not included.
+  virtual MemoryUsage GetMemoryUsage() const = 0;
+
   enum Error {
     // Fatal errors.
     kNoError = 0,
@@ -715,7 +792,8 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // Returns floor(sample_rate_hz/100): the number of samples per channel used
   // as input and output to the audio processing module in calls to
   // ProcessStream, ProcessReverseStream, AnalyzeReverseStream, and
-  // GetLinearAecOutput.
+  // GetLinearAecOutput. Longer frames, see StreamConfig::frame_size_ms(), are
+  // multiples of this size.
   //
   // This is exactly 10 ms for sample rates divisible by 100. For example:
   //  - 48000 Hz (480 samples per channel),
@@ -829,26 +907,45 @@ class StreamConfig {
  public:
   // sample_rate_hz: The sampling rate of the stream.
   // num_channels: The number of audio channels in the stream.
-  StreamConfig(int sample_rate_hz = 0,
-               size_t num_channels = 0)  // NOLINT(runtime/explicit)
+  // frame_size_ms: The duration of the frames passed in each call, which must
+  // be a multiple of AudioProcessing::kChunkSizeMs. Longer frames are processed
+  // in chunks of 10 ms, which saves the fixed per-call costs.
+  StreamConfig(int sample_rate_hz = 0,  // NOLINT(runtime/explicit)
+               size_t num_channels = 0,
+               int frame_size_ms = AudioProcessing::kChunkSizeMs)
       : sample_rate_hz_(sample_rate_hz),
         num_channels_(num_channels),
-        num_frames_(calculate_frames(sample_rate_hz)) {}
+        frame_size_ms_(frame_size_ms),
+        num_frames_(calculate_frames(sample_rate_hz, frame_size_ms)) {}
 
   void set_sample_rate_hz(int value) {
     sample_rate_hz_ = value;
-    num_frames_ = calculate_frames(value);
+    num_frames_ = calculate_frames(value, frame_size_ms_);
   }
   void set_num_channels(size_t value) { num_channels_ = value; }
+  void set_frame_size_ms(int value) {
+    frame_size_ms_ = value;
+    num_frames_ = calculate_frames(sample_rate_hz_, value);
+  }
 
   int sample_rate_hz() const { return sample_rate_hz_; }
 
   // The number of channels in the stream.
   size_t num_channels() const { return num_channels_; }
 
+  int frame_size_ms() const { return frame_size_ms_; }
+
+  // The number of 10 ms chunks in a frame.
+  size_t num_chunks() const {
+    return frame_size_ms_ > 0 ? frame_size_ms_ / AudioProcessing::kChunkSizeMs
+                              : 0;
+  }
+
   size_t num_frames() const { return num_frames_; }
   size_t num_samples() const { return num_channels_ * num_frames_; }
 
+  // The frame size does not affect the processing, and is therefore not
+  // compared.
   bool operator==(const StreamConfig& other) const {
     return sample_rate_hz_ == other.sample_rate_hz_ &&
            num_channels_ == other.num_channels_;
@@ -857,12 +954,17 @@ class StreamConfig {
   bool operator!=(const StreamConfig& other) const { return !(*this == other); }
 
  private:
-  static size_t calculate_frames(int sample_rate_hz) {
-    return static_cast<size_t>(AudioProcessing::GetFrameSize(sample_rate_hz));
+  static size_t calculate_frames(int sample_rate_hz, int frame_size_ms) {
+    if (frame_size_ms <= 0) {
+      return 0;
+    }
+    return static_cast<size_t>(AudioProcessing::GetFrameSize(sample_rate_hz)) *
+           (frame_size_ms / AudioProcessing::kChunkSizeMs);
   }
 
   int sample_rate_hz_;
   size_t num_channels_;
+  int frame_size_ms_;
   size_t num_frames_;
 };
 
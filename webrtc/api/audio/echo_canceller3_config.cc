@@ -108,16 +108,24 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
     res = false;
   }
 
+  res = res & Limit(&c->buffering.render_transfer_queue_size_frames, 1, 1000);
+
   res = res & Limit(&c->delay.default_delay, 0, 5000);
   res = res & Limit(&c->delay.num_filters, 0, 5000);
   res = res & Limit(&c->delay.delay_headroom_samples, 0, 5000);
   res = res & Limit(&c->delay.hysteresis_limit_blocks, 0, 5000);
   res = res & Limit(&c->delay.fixed_capture_delay_samples, 0, 5000);
+  res = res & Limit(&c->delay.pinned_delay_samples, 0, 48000);
   res = res & Limit(&c->delay.delay_estimate_smoothing, 0.f, 1.f);
   res = res & Limit(&c->delay.delay_candidate_detection_threshold, 0.f, 1.f);
   res = res & Limit(&c->delay.delay_selection_thresholds.initial, 1, 250);
   res = res & Limit(&c->delay.delay_selection_thresholds.converged, 1, 250);
 
+  if (c->delay.use_pinned_delay && c->delay.use_external_delay_estimator) {
+    c->delay.use_pinned_delay = false;
+    res = false;
+  }
+
   res = res & FloorLimit(&c->filter.refined.length_blocks, 1);
   res = res & Limit(&c->filter.refined.leakage_converged, 0.f, 1000.f);
   res = res & Limit(&c->filter.refined.leakage_diverged, 0.f, 1000.f);
@@ -155,6 +163,15 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
   res = res & Limit(&c->filter.initial_state_seconds, 0.f, 100.f);
   res = res & Limit(&c->filter.coarse_reset_hangover_blocks, 0, 250000);
 
+  res = res & Limit(&c->filter.adaptive_refined_length.min_length_blocks, 1,
+                    1000);
+  res = res & Limit(&c->filter.adaptive_refined_length.max_length_blocks,
+                    c->filter.adaptive_refined_length.min_length_blocks, 1000);
+  res = res & Limit(&c->filter.adaptive_refined_length.headroom_blocks, 0,
+                    1000);
+  res = res &
+        Limit(&c->filter.adaptive_refined_length.tail_threshold, 0.f, 1.f);
+
   res = res & Limit(&c->erle.min, 1.f, 100000.f);
   res = res & Limit(&c->erle.max_l, 1.f, 100000.f);
   res = res & Limit(&c->erle.max_h, 1.f, 100000.f);
@@ -273,6 +290,9 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
 
   res = res & Limit(&c->suppressor.floor_first_increase, 0.f, 1000000.f);
 
+  res = res &
+        Limit(&c->multi_channel.max_reference_delay_spread_blocks, 0, 250);
+
   return res;
 }
 }  // namespace webrtc
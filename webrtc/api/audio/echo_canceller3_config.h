@@ -30,6 +30,8 @@ struct RTC_EXPORT EchoCanceller3Config {
   struct Buffering {
     size_t excess_render_detection_interval_blocks = 250;
     size_t max_allowed_excess_render_blocks = 8;
+    // Number of 10 ms render frames that can be queued for the capture side.
+    size_t render_transfer_queue_size_frames = 100;
   } buffering;
 
   struct Delay {
@@ -60,6 +62,23 @@ struct RTC_EXPORT EchoCanceller3Config {
     AlignmentMixing render_alignment_mixing = {false, true, 10000.f, true};
     AlignmentMixing capture_alignment_mixing = {false, true, 10000.f, false};
     bool detect_pre_echo = true;
+    // Estimate the delay by correlating in the frequency domain instead of
+    // with time-domain matched filters. The cost then grows only slightly
+    // faster than linearly with `num_filters`, which allows searching delays
+    // of several seconds. Pre-echo detection is not done in this mode.
+    bool use_fft_matched_filter = false;
+    // Estimate the rate mismatch between the render and capture clocks from
+    // the drift of the estimated delay, and resample the render signal to
+    // cancel it. This keeps the delay stable when the clocks differ. When
+    // the delay shrinks, the compensation delays the render signal by up to
+    // 16 ms at a time, so it needs an echo path delay of at least that much.
+    bool compensate_clockdrift = false;
+    // Use a known, fixed delay instead of estimating it. The delay, in samples
+    // at 16 kHz, is given by `pinned_delay_samples` and is limited to the size
+    // of the render buffer. Neither the delay estimator nor the downsampled
+    // render signal that it analyzes is then computed.
+    bool use_pinned_delay = false;
+    size_t pinned_delay_samples = 0;
   } delay;
 
   struct Filter {
@@ -94,6 +113,20 @@ struct RTC_EXPORT EchoCanceller3Config {
     bool use_linear_filter = true;
     bool high_pass_filter_echo_reference = false;
     bool export_linear_aec_output = false;
+
+    // Lets the size of the refined filter follow the measured echo tail once
+    // the initial state has been left. The refined filter is then allocated
+    // for `max_length_blocks` partitions, and its active size is kept between
+    // `min_length_blocks` and `max_length_blocks`. The tail ends at the last
+    // partition whose energy exceeds `tail_threshold` times the energy of the
+    // strongest partition.
+    struct AdaptiveRefinedLength {
+      bool enabled = false;
+      size_t min_length_blocks = 4;
+      size_t max_length_blocks = 20;
+      size_t headroom_blocks = 2;
+      float tail_threshold = 0.001f;
+    } adaptive_refined_length;
   } filter;
 
   struct Erle {
@@ -137,6 +170,10 @@ struct RTC_EXPORT EchoCanceller3Config {
   struct EchoRemovalControl {
     bool has_clock_drift = false;
     bool linear_and_stable_echo_path = false;
+    // Skip the linear filtering and adaptation, the residual echo estimation
+    // and the suppression gain computation while the render signal covered by
+    // the linear filters is silent and the echo tail has decayed.
+    bool bypass_on_render_silence = false;
   } echo_removal_control;
 
   struct EchoModel {
@@ -243,6 +280,13 @@ struct RTC_EXPORT EchoCanceller3Config {
     float stereo_detection_threshold = 0.0f;
     int stereo_detection_timeout_threshold_seconds = 300;
     float stereo_detection_hysteresis_seconds = 2.0f;
+    // Treat each render channel as a separate reference with its own delay to
+    // the capture signal. The references are then never downmixed, their
+    // delays are estimated separately, and each reference is delayed to align
+    // with the earliest one before the linear filtering. Delay differences
+    // beyond `max_reference_delay_spread_blocks` are not compensated for.
+    bool independent_render_references = false;
+    size_t max_reference_delay_spread_blocks = 50;
   } multi_channel;
 };
 }  // namespace webrtc
@@ -11,8 +11,13 @@
 #ifndef API_AUDIO_ECHO_CONTROL_H_
 #define API_AUDIO_ECHO_CONTROL_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
+#include <vector>
 
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -58,6 +63,21 @@ class EchoControl {
   // Returns wheter the signal is altered.
   virtual bool ActiveProcessing() const = 0;
 
+  // Returns a versioned snapshot of the adapted state, such as the echo path
+  // estimate, which can be restored with SetState() into a new echo controller
+  // operating on the same device. Returns an empty vector if snapshots are not
+  // supported.
+  virtual std::vector<uint8_t> GetState() const { return {}; }
+
+  // Restores a snapshot produced by GetState(). Returns false, and leaves the
+  // echo controller unchanged, if the snapshot is not compatible with it.
+  virtual bool SetState(rtc::ArrayView<const uint8_t> state) { return false; }
+
+  // Returns the size in bytes of the echo controller, including the memory it
+  // owns, or 0 if not supported. Must not be called concurrently with the
+  // processing.
+  virtual size_t MemoryUsage() const { return 0; }
+
   virtual ~EchoControl() {}
 };
 
@@ -10,7 +10,50 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include <array>
+
+#include "common_audio/audio_util_kernels.h"
+#include "rtc_base/system/arch.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
+#endif
+
 namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+struct X86Features {
+  bool sse2;
+  bool avx2;
+};
+
+// Detects the CPU features once, since the functions below are called for
+// every frame.
+const X86Features& GetX86Features() {
+  static const X86Features features = {.sse2 = GetCPUInfo(kSSE2) != 0,
+                                       .avx2 = GetCPUInfo(kAVX2) != 0};
+  return features;
+}
+#endif
+
+// Returns true if the shuffling kernels support `num_channels` channels.
+bool IsVectorizedChannelCount(size_t num_channels) {
+  return num_channels == 2 || num_channels == 4 || num_channels == 8;
+}
+
+constexpr size_t kMaxVectorizedChannels = 8;
+
+template <typename T>
+std::array<T*, kMaxVectorizedChannels> ChannelPointers(
+    const DeinterleavedView<T>& view) {
+  std::array<T*, kMaxVectorizedChannels> channels;
+  for (size_t i = 0; i < view.num_channels(); ++i) {
+    channels[i] = view[i].data();
+  }
+  return channels;
+}
+
+}  // namespace
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
   for (size_t i = 0; i < size; ++i)
@@ -23,30 +66,227 @@ void S16ToFloat(const int16_t* src, size_t size, float* dest) {
 }
 
 void S16ToFloatS16(const int16_t* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetX86Features().avx2) {
+    audio_util_kernels::S16ToFloatS16_AVX2(src, size, dest);
+    return;
+  }
+  if (GetX86Features().sse2) {
+    audio_util_kernels::S16ToFloatS16_SSE2(src, size, dest);
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  audio_util_kernels::S16ToFloatS16_NEON(src, size, dest);
+  return;
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = src[i];
 }
 
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetX86Features().avx2) {
+    audio_util_kernels::FloatS16ToS16_AVX2(src, size, dest);
+    return;
+  }
+  if (GetX86Features().sse2) {
+    audio_util_kernels::FloatS16ToS16_SSE2(src, size, dest);
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  audio_util_kernels::FloatS16ToS16_NEON(src, size, dest);
+  return;
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
 }
 
 void FloatToFloatS16(const float* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetX86Features().avx2) {
+    audio_util_kernels::FloatToFloatS16_AVX2(src, size, dest);
+    return;
+  }
+  if (GetX86Features().sse2) {
+    audio_util_kernels::FloatToFloatS16_SSE2(src, size, dest);
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  audio_util_kernels::FloatToFloatS16_NEON(src, size, dest);
+  return;
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatToFloatS16(src[i]);
 }
 
 void FloatS16ToFloat(const float* src, size_t size, float* dest) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetX86Features().avx2) {
+    audio_util_kernels::FloatS16ToFloat_AVX2(src, size, dest);
+    return;
+  }
+  if (GetX86Features().sse2) {
+    audio_util_kernels::FloatS16ToFloat_SSE2(src, size, dest);
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  audio_util_kernels::FloatS16ToFloat_NEON(src, size, dest);
+  return;
+#endif
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatS16ToFloat(src[i]);
 }
 
+template <>
+void Deinterleave<float>(const InterleavedView<const float>& interleaved,
+                         const DeinterleavedView<float>& deinterleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  const size_t num_channels = NumChannels(interleaved);
+  const size_t samples_per_channel = SamplesPerChannel(interleaved);
+  if (IsVectorizedChannelCount(num_channels)) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (GetX86Features().sse2) {
+      audio_util_kernels::Deinterleave_SSE2(
+          interleaved.data().data(), samples_per_channel, num_channels,
+          ChannelPointers(deinterleaved).data());
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    audio_util_kernels::Deinterleave_NEON(
+        interleaved.data().data(), samples_per_channel, num_channels,
+        ChannelPointers(deinterleaved).data());
+    return;
+#endif
+  }
+  for (size_t i = 0; i < num_channels; ++i) {
+    MonoView<float> channel = deinterleaved[i];
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      channel[j] = interleaved[j * num_channels + i];
+    }
+  }
+}
+
+template <>
+void Interleave<float>(const DeinterleavedView<const float>& deinterleaved,
+                       const InterleavedView<float>& interleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  const size_t num_channels = NumChannels(interleaved);
+  const size_t samples_per_channel = SamplesPerChannel(interleaved);
+  if (IsVectorizedChannelCount(num_channels)) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (GetX86Features().sse2) {
+      audio_util_kernels::Interleave_SSE2(
+          ChannelPointers(deinterleaved).data(), samples_per_channel,
+          num_channels, interleaved.data().data());
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    audio_util_kernels::Interleave_NEON(
+        ChannelPointers(deinterleaved).data(), samples_per_channel,
+        num_channels, interleaved.data().data());
+    return;
+#endif
+  }
+  for (size_t i = 0; i < num_channels; ++i) {
+    const MonoView<const float> channel = deinterleaved[i];
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      interleaved[j * num_channels + i] = channel[j];
+    }
+  }
+}
+
+void DeinterleaveS16ToFloatS16(InterleavedView<const int16_t> interleaved,
+                               DeinterleavedView<float> deinterleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  const size_t num_channels = NumChannels(interleaved);
+  const size_t samples_per_channel = SamplesPerChannel(interleaved);
+  if (num_channels == 1) {
+    S16ToFloatS16(interleaved.data().data(), samples_per_channel,
+                  deinterleaved[0].data());
+    return;
+  }
+  if (IsVectorizedChannelCount(num_channels)) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (GetX86Features().sse2) {
+      audio_util_kernels::DeinterleaveS16ToFloatS16_SSE2(
+          interleaved.data().data(), samples_per_channel, num_channels,
+          ChannelPointers(deinterleaved).data());
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    audio_util_kernels::DeinterleaveS16ToFloatS16_NEON(
+        interleaved.data().data(), samples_per_channel, num_channels,
+        ChannelPointers(deinterleaved).data());
+    return;
+#endif
+  }
+  for (size_t i = 0; i < num_channels; ++i) {
+    MonoView<float> channel = deinterleaved[i];
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      channel[j] = interleaved[j * num_channels + i];
+    }
+  }
+}
+
+void InterleaveFloatS16ToS16(DeinterleavedView<const float> deinterleaved,
+                             InterleavedView<int16_t> interleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  const size_t num_channels = NumChannels(interleaved);
+  const size_t samples_per_channel = SamplesPerChannel(interleaved);
+  if (num_channels == 1) {
+    FloatS16ToS16(deinterleaved[0].data(), samples_per_channel,
+                  interleaved.data().data());
+    return;
+  }
+  if (IsVectorizedChannelCount(num_channels)) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (GetX86Features().sse2) {
+      audio_util_kernels::InterleaveFloatS16ToS16_SSE2(
+          ChannelPointers(deinterleaved).data(), samples_per_channel,
+          num_channels, interleaved.data().data());
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    audio_util_kernels::InterleaveFloatS16ToS16_NEON(
+        ChannelPointers(deinterleaved).data(), samples_per_channel,
+        num_channels, interleaved.data().data());
+    return;
+#endif
+  }
+  for (size_t i = 0; i < num_channels; ++i) {
+    const MonoView<const float> channel = deinterleaved[i];
+    for (size_t j = 0; j < samples_per_channel; ++j) {
+      interleaved[j * num_channels + i] = FloatS16ToS16(channel[j]);
+    }
+  }
+}
+
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
                                        int num_channels,
                                        int16_t* deinterleaved) {
+  if (num_channels == 2) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (GetX86Features().sse2) {
+      audio_util_kernels::DownmixStereoToMono_SSE2(interleaved, num_frames,
+                                                   deinterleaved);
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    audio_util_kernels::DownmixStereoToMono_NEON(interleaved, num_frames,
+                                                 deinterleaved);
+    return;
+#endif
+  }
   DownmixInterleavedToMonoImpl<int16_t, int32_t>(interleaved, num_frames,
                                                  num_channels, deinterleaved);
 }
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/audio_util_kernels.h"
+#include "common_audio/include/audio_util.h"
+
+namespace webrtc {
+namespace audio_util_kernels {
+namespace {
+
+// Rounds and saturates as FloatS16ToS16().
+inline __m256i FloatS16ToS16Epi32(__m256 v) {
+  // The operands are ordered so that NaNs are kept, and the NaN lanes are then
+  // zeroed as they are converted by FloatS16ToS16().
+  v = _mm256_min_ps(_mm256_set1_ps(32767.f), v);
+  v = _mm256_max_ps(_mm256_set1_ps(-32768.f), v);
+  const __m256 half = _mm256_or_ps(_mm256_and_ps(v, _mm256_set1_ps(-0.f)),
+                                   _mm256_set1_ps(0.5f));
+  const __m256i s = _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+  return _mm256_and_si256(
+      s, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_ORD_Q)));
+}
+
+}  // namespace
+
+void S16ToFloatS16_AVX2(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+    _mm256_storeu_ps(&dest[i], _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+                                   _mm256_castsi256_si128(v))));
+    _mm256_storeu_ps(&dest[i + 8], _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+                                       _mm256_extracti128_si256(v, 1))));
+  }
+  for (; i < size; ++i) {
+    dest[i] = src[i];
+  }
+}
+
+void FloatS16ToS16_AVX2(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256i lo = FloatS16ToS16Epi32(_mm256_loadu_ps(&src[i]));
+    const __m256i hi = FloatS16ToS16Epi32(_mm256_loadu_ps(&src[i + 8]));
+    // The packing is done within 128-bit lanes, which the permutation undoes.
+    const __m256i packed = _mm256_permute4x64_epi64(
+        _mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest[i]), packed);
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToS16(src[i]);
+  }
+}
+
+void FloatToFloatS16_AVX2(const float* src, size_t size, float* dest) {
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 minus_one = _mm256_set1_ps(-1.f);
+  const __m256 scaling = _mm256_set1_ps(32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    // The operands are ordered so that NaNs are kept as by FloatToFloatS16().
+    __m256 v = _mm256_min_ps(one, _mm256_loadu_ps(&src[i]));
+    v = _mm256_max_ps(minus_one, v);
+    _mm256_storeu_ps(&dest[i], _mm256_mul_ps(v, scaling));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatToFloatS16(src[i]);
+  }
+}
+
+void FloatS16ToFloat_AVX2(const float* src, size_t size, float* dest) {
+  const __m256 max_value = _mm256_set1_ps(32768.f);
+  const __m256 min_value = _mm256_set1_ps(-32768.f);
+  const __m256 scaling = _mm256_set1_ps(1.f / 32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256 v = _mm256_min_ps(max_value, _mm256_loadu_ps(&src[i]));
+    v = _mm256_max_ps(min_value, v);
+    _mm256_storeu_ps(&dest[i], _mm256_mul_ps(v, scaling));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToFloat(src[i]);
+  }
+}
+
+}  // namespace audio_util_kernels
+}  // namespace webrtc
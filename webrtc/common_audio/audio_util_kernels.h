@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_AUDIO_UTIL_KERNELS_H_
+#define COMMON_AUDIO_AUDIO_UTIL_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+// Architecture specific implementations of the conversion and shuffling
+// functions of audio_util.h, which are selected at runtime by audio_util.cc.
+// The output of each of them is identical to that of the generic
+// implementation. The shuffling functions support 2, 4 and 8 channels.
+
+namespace webrtc {
+namespace audio_util_kernels {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void S16ToFloatS16_SSE2(const int16_t* src, size_t size, float* dest);
+void FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest);
+void FloatToFloatS16_SSE2(const float* src, size_t size, float* dest);
+void FloatS16ToFloat_SSE2(const float* src, size_t size, float* dest);
+void Deinterleave_SSE2(const float* interleaved,
+                       size_t samples_per_channel,
+                       size_t num_channels,
+                       float* const* deinterleaved);
+void Interleave_SSE2(const float* const* deinterleaved,
+                     size_t samples_per_channel,
+                     size_t num_channels,
+                     float* interleaved);
+void DeinterleaveS16ToFloatS16_SSE2(const int16_t* interleaved,
+                                    size_t samples_per_channel,
+                                    size_t num_channels,
+                                    float* const* deinterleaved);
+void InterleaveFloatS16ToS16_SSE2(const float* const* deinterleaved,
+                                  size_t samples_per_channel,
+                                  size_t num_channels,
+                                  int16_t* interleaved);
+void DownmixStereoToMono_SSE2(const int16_t* interleaved,
+                              size_t num_frames,
+                              int16_t* mono);
+
+void S16ToFloatS16_AVX2(const int16_t* src, size_t size, float* dest);
+void FloatS16ToS16_AVX2(const float* src, size_t size, int16_t* dest);
+void FloatToFloatS16_AVX2(const float* src, size_t size, float* dest);
+void FloatS16ToFloat_AVX2(const float* src, size_t size, float* dest);
+#elif defined(WEBRTC_HAS_NEON)
+void S16ToFloatS16_NEON(const int16_t* src, size_t size, float* dest);
+void FloatS16ToS16_NEON(const float* src, size_t size, int16_t* dest);
+void FloatToFloatS16_NEON(const float* src, size_t size, float* dest);
+void FloatS16ToFloat_NEON(const float* src, size_t size, float* dest);
+void Deinterleave_NEON(const float* interleaved,
+                       size_t samples_per_channel,
+                       size_t num_channels,
+                       float* const* deinterleaved);
+void Interleave_NEON(const float* const* deinterleaved,
+                     size_t samples_per_channel,
+                     size_t num_channels,
+                     float* interleaved);
+void DeinterleaveS16ToFloatS16_NEON(const int16_t* interleaved,
+                                    size_t samples_per_channel,
+                                    size_t num_channels,
+                                    float* const* deinterleaved);
+void InterleaveFloatS16ToS16_NEON(const float* const* deinterleaved,
+                                  size_t samples_per_channel,
+                                  size_t num_channels,
+                                  int16_t* interleaved);
+void DownmixStereoToMono_NEON(const int16_t* interleaved,
+                              size_t num_frames,
+                              int16_t* mono);
+#endif
+
+}  // namespace audio_util_kernels
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_AUDIO_UTIL_KERNELS_H_
@@ -0,0 +1,286 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/audio_util_kernels.h"
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace audio_util_kernels {
+namespace {
+
+inline float32x4_t S16ToFloatS16x4(int16x4_t v) {
+  return vcvtq_f32_s32(vmovl_s16(v));
+}
+
+// Rounds and saturates as FloatS16ToS16().
+inline int16x4_t FloatS16ToS16x4(float32x4_t v) {
+  v = vminq_f32(v, vdupq_n_f32(32767.f));
+  v = vmaxq_f32(v, vdupq_n_f32(-32768.f));
+  const uint32x4_t sign =
+      vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u));
+  const float32x4_t half = vreinterpretq_f32_u32(
+      vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+  return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, half)));
+}
+
+inline int16x8_t FloatS16ToS16x8(float32x4_t lo, float32x4_t hi) {
+  return vcombine_s16(FloatS16ToS16x4(lo), FloatS16ToS16x4(hi));
+}
+
+}  // namespace
+
+void S16ToFloatS16_NEON(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t v = vld1q_s16(&src[i]);
+    vst1q_f32(&dest[i], S16ToFloatS16x4(vget_low_s16(v)));
+    vst1q_f32(&dest[i + 4], S16ToFloatS16x4(vget_high_s16(v)));
+  }
+  for (; i < size; ++i) {
+    dest[i] = src[i];
+  }
+}
+
+void FloatS16ToS16_NEON(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    vst1q_s16(&dest[i],
+              FloatS16ToS16x8(vld1q_f32(&src[i]), vld1q_f32(&src[i + 4])));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToS16(src[i]);
+  }
+}
+
+void FloatToFloatS16_NEON(const float* src, size_t size, float* dest) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t minus_one = vdupq_n_f32(-1.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t v = vminq_f32(vld1q_f32(&src[i]), one);
+    v = vmaxq_f32(v, minus_one);
+    vst1q_f32(&dest[i], vmulq_n_f32(v, 32768.f));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatToFloatS16(src[i]);
+  }
+}
+
+void FloatS16ToFloat_NEON(const float* src, size_t size, float* dest) {
+  const float32x4_t max_value = vdupq_n_f32(32768.f);
+  const float32x4_t min_value = vdupq_n_f32(-32768.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t v = vminq_f32(vld1q_f32(&src[i]), max_value);
+    v = vmaxq_f32(v, min_value);
+    vst1q_f32(&dest[i], vmulq_n_f32(v, 1.f / 32768.f));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToFloat(src[i]);
+  }
+}
+
+void Deinterleave_NEON(const float* interleaved,
+                       size_t samples_per_channel,
+                       size_t num_channels,
+                       float* const* deinterleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      const float32x4x2_t v = vld2q_f32(&interleaved[2 * k]);
+      vst1q_f32(&deinterleaved[0][k], v.val[0]);
+      vst1q_f32(&deinterleaved[1][k], v.val[1]);
+    }
+  } else if (num_channels == 4) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      const float32x4x4_t v = vld4q_f32(&interleaved[4 * k]);
+      for (int c = 0; c < 4; ++c) {
+        vst1q_f32(&deinterleaved[c][k], v.val[c]);
+      }
+    }
+  } else {
+    RTC_DCHECK_EQ(num_channels, 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      // Each vector holds the samples of channels c and c + 4 of two frames.
+      const float32x4x4_t a = vld4q_f32(&interleaved[8 * k]);
+      const float32x4x4_t b = vld4q_f32(&interleaved[8 * k + 16]);
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t v = vuzpq_f32(a.val[c], b.val[c]);
+        vst1q_f32(&deinterleaved[c][k], v.val[0]);
+        vst1q_f32(&deinterleaved[c + 4][k], v.val[1]);
+      }
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      deinterleaved[c][k] = interleaved[num_channels * k + c];
+    }
+  }
+}
+
+void Interleave_NEON(const float* const* deinterleaved,
+                     size_t samples_per_channel,
+                     size_t num_channels,
+                     float* interleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(&deinterleaved[0][k]);
+      v.val[1] = vld1q_f32(&deinterleaved[1][k]);
+      vst2q_f32(&interleaved[2 * k], v);
+    }
+  } else if (num_channels == 4) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      float32x4x4_t v;
+      for (int c = 0; c < 4; ++c) {
+        v.val[c] = vld1q_f32(&deinterleaved[c][k]);
+      }
+      vst4q_f32(&interleaved[4 * k], v);
+    }
+  } else {
+    RTC_DCHECK_EQ(num_channels, 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      float32x4x4_t a;
+      float32x4x4_t b;
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t v = vzipq_f32(vld1q_f32(&deinterleaved[c][k]),
+                                          vld1q_f32(&deinterleaved[c + 4][k]));
+        a.val[c] = v.val[0];
+        b.val[c] = v.val[1];
+      }
+      vst4q_f32(&interleaved[8 * k], a);
+      vst4q_f32(&interleaved[8 * k + 16], b);
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      interleaved[num_channels * k + c] = deinterleaved[c][k];
+    }
+  }
+}
+
+void DeinterleaveS16ToFloatS16_NEON(const int16_t* interleaved,
+                                    size_t samples_per_channel,
+                                    size_t num_channels,
+                                    float* const* deinterleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      const int16x8x2_t v = vld2q_s16(&interleaved[2 * k]);
+      for (int c = 0; c < 2; ++c) {
+        vst1q_f32(&deinterleaved[c][k],
+                  S16ToFloatS16x4(vget_low_s16(v.val[c])));
+        vst1q_f32(&deinterleaved[c][k + 4],
+                  S16ToFloatS16x4(vget_high_s16(v.val[c])));
+      }
+    }
+  } else if (num_channels == 4) {
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      const int16x8x4_t v = vld4q_s16(&interleaved[4 * k]);
+      for (int c = 0; c < 4; ++c) {
+        vst1q_f32(&deinterleaved[c][k],
+                  S16ToFloatS16x4(vget_low_s16(v.val[c])));
+        vst1q_f32(&deinterleaved[c][k + 4],
+                  S16ToFloatS16x4(vget_high_s16(v.val[c])));
+      }
+    }
+  } else {
+    RTC_DCHECK_EQ(num_channels, 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      // Each vector holds the samples of channels c and c + 4 of four frames.
+      const int16x8x4_t v = vld4q_s16(&interleaved[8 * k]);
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t u =
+            vuzpq_f32(S16ToFloatS16x4(vget_low_s16(v.val[c])),
+                      S16ToFloatS16x4(vget_high_s16(v.val[c])));
+        vst1q_f32(&deinterleaved[c][k], u.val[0]);
+        vst1q_f32(&deinterleaved[c + 4][k], u.val[1]);
+      }
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      deinterleaved[c][k] = interleaved[num_channels * k + c];
+    }
+  }
+}
+
+void InterleaveFloatS16ToS16_NEON(const float* const* deinterleaved,
+                                  size_t samples_per_channel,
+                                  size_t num_channels,
+                                  int16_t* interleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      int16x8x2_t v;
+      for (int c = 0; c < 2; ++c) {
+        v.val[c] = FloatS16ToS16x8(vld1q_f32(&deinterleaved[c][k]),
+                                   vld1q_f32(&deinterleaved[c][k + 4]));
+      }
+      vst2q_s16(&interleaved[2 * k], v);
+    }
+  } else if (num_channels == 4) {
+    for (; k + 8 <= samples_per_channel; k += 8) {
+      int16x8x4_t v;
+      for (int c = 0; c < 4; ++c) {
+        v.val[c] = FloatS16ToS16x8(vld1q_f32(&deinterleaved[c][k]),
+                                   vld1q_f32(&deinterleaved[c][k + 4]));
+      }
+      vst4q_s16(&interleaved[4 * k], v);
+    }
+  } else {
+    RTC_DCHECK_EQ(num_channels, 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      int16x8x4_t v;
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t z = vzipq_f32(vld1q_f32(&deinterleaved[c][k]),
+                                          vld1q_f32(&deinterleaved[c + 4][k]));
+        v.val[c] = FloatS16ToS16x8(z.val[0], z.val[1]);
+      }
+      vst4q_s16(&interleaved[8 * k], v);
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      interleaved[num_channels * k + c] = FloatS16ToS16(deinterleaved[c][k]);
+    }
+  }
+}
+
+void DownmixStereoToMono_NEON(const int16_t* interleaved,
+                              size_t num_frames,
+                              int16_t* mono) {
+  size_t k = 0;
+  for (; k + 8 <= num_frames; k += 8) {
+    const int16x8x2_t v = vld2q_s16(&interleaved[2 * k]);
+    int32x4_t sums[2] = {
+        vaddl_s16(vget_low_s16(v.val[0]), vget_low_s16(v.val[1])),
+        vaddl_s16(vget_high_s16(v.val[0]), vget_high_s16(v.val[1]))};
+    for (int j = 0; j < 2; ++j) {
+      // Division by 2 rounding towards zero, as in the generic version.
+      const uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_s32(sums[j]), 31);
+      sums[j] = vshrq_n_s32(vaddq_s32(sums[j], vreinterpretq_s32_u32(sign)), 1);
+    }
+    vst1q_s16(&mono[k], vcombine_s16(vmovn_s32(sums[0]), vmovn_s32(sums[1])));
+  }
+  for (; k < num_frames; ++k) {
+    const int32_t sum = interleaved[2 * k] + interleaved[2 * k + 1];
+    mono[k] = sum / 2;
+  }
+}
+
+}  // namespace audio_util_kernels
+}  // namespace webrtc
@@ -0,0 +1,259 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/audio_util_kernels.h"
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace audio_util_kernels {
+namespace {
+
+// Loads 4 consecutive samples as floats.
+inline __m128 Load4(const float* x) {
+  return _mm_loadu_ps(x);
+}
+
+inline __m128 Load4(const int16_t* x) {
+  const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x));
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+
+// Rounds and saturates as FloatS16ToS16().
+inline __m128i FloatS16ToS16Epi32(__m128 v) {
+  // The operands are ordered so that NaNs are kept, and the NaN lanes are then
+  // zeroed as they are converted by FloatS16ToS16().
+  v = _mm_min_ps(_mm_set1_ps(32767.f), v);
+  v = _mm_max_ps(_mm_set1_ps(-32768.f), v);
+  const __m128 half =
+      _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.f)), _mm_set1_ps(0.5f));
+  const __m128i s = _mm_cvttps_epi32(_mm_add_ps(v, half));
+  return _mm_and_si128(s, _mm_castps_si128(_mm_cmpord_ps(v, v)));
+}
+
+// Stores 4 floats as consecutive samples.
+inline void Store4(__m128 v, float* y) {
+  _mm_storeu_ps(y, v);
+}
+
+inline void Store4(__m128 v, int16_t* y) {
+  const __m128i s = FloatS16ToS16Epi32(v);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(y), _mm_packs_epi32(s, s));
+}
+
+inline void StoreSample(float v, float* y) {
+  *y = v;
+}
+
+inline void StoreSample(float v, int16_t* y) {
+  *y = FloatS16ToS16(v);
+}
+
+// Deinterleaves `num_channels` channels, 4 frames at a time, with the frames
+// being transposed into channels in 4x4 blocks.
+template <typename T>
+void DeinterleaveImpl(const T* interleaved,
+                      size_t samples_per_channel,
+                      size_t num_channels,
+                      float* const* deinterleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      const __m128 a = Load4(&interleaved[2 * k]);
+      const __m128 b = Load4(&interleaved[2 * k + 4]);
+      _mm_storeu_ps(&deinterleaved[0][k],
+                    _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(&deinterleaved[1][k],
+                    _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+  } else {
+    RTC_DCHECK(num_channels == 4 || num_channels == 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      const T* x = &interleaved[num_channels * k];
+      for (size_t c = 0; c < num_channels; c += 4) {
+        __m128 r0 = Load4(&x[c]);
+        __m128 r1 = Load4(&x[num_channels + c]);
+        __m128 r2 = Load4(&x[2 * num_channels + c]);
+        __m128 r3 = Load4(&x[3 * num_channels + c]);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(&deinterleaved[c][k], r0);
+        _mm_storeu_ps(&deinterleaved[c + 1][k], r1);
+        _mm_storeu_ps(&deinterleaved[c + 2][k], r2);
+        _mm_storeu_ps(&deinterleaved[c + 3][k], r3);
+      }
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      deinterleaved[c][k] = interleaved[num_channels * k + c];
+    }
+  }
+}
+
+template <typename T>
+void InterleaveImpl(const float* const* deinterleaved,
+                    size_t samples_per_channel,
+                    size_t num_channels,
+                    T* interleaved) {
+  size_t k = 0;
+  if (num_channels == 2) {
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      const __m128 l = _mm_loadu_ps(&deinterleaved[0][k]);
+      const __m128 r = _mm_loadu_ps(&deinterleaved[1][k]);
+      Store4(_mm_unpacklo_ps(l, r), &interleaved[2 * k]);
+      Store4(_mm_unpackhi_ps(l, r), &interleaved[2 * k + 4]);
+    }
+  } else {
+    RTC_DCHECK(num_channels == 4 || num_channels == 8);
+    for (; k + 4 <= samples_per_channel; k += 4) {
+      T* y = &interleaved[num_channels * k];
+      for (size_t c = 0; c < num_channels; c += 4) {
+        __m128 r0 = _mm_loadu_ps(&deinterleaved[c][k]);
+        __m128 r1 = _mm_loadu_ps(&deinterleaved[c + 1][k]);
+        __m128 r2 = _mm_loadu_ps(&deinterleaved[c + 2][k]);
+        __m128 r3 = _mm_loadu_ps(&deinterleaved[c + 3][k]);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        Store4(r0, &y[c]);
+        Store4(r1, &y[num_channels + c]);
+        Store4(r2, &y[2 * num_channels + c]);
+        Store4(r3, &y[3 * num_channels + c]);
+      }
+    }
+  }
+  for (; k < samples_per_channel; ++k) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      StoreSample(deinterleaved[c][k], &interleaved[num_channels * k + c]);
+    }
+  }
+}
+
+}  // namespace
+
+void S16ToFloatS16_SSE2(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    // The samples are sign-extended to 32 bits by the arithmetic shifts.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(&dest[i], _mm_cvtepi32_ps(lo));
+    _mm_storeu_ps(&dest[i + 4], _mm_cvtepi32_ps(hi));
+  }
+  for (; i < size; ++i) {
+    dest[i] = src[i];
+  }
+}
+
+void FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i lo = FloatS16ToS16Epi32(_mm_loadu_ps(&src[i]));
+    const __m128i hi = FloatS16ToS16Epi32(_mm_loadu_ps(&src[i + 4]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[i]),
+                     _mm_packs_epi32(lo, hi));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToS16(src[i]);
+  }
+}
+
+void FloatToFloatS16_SSE2(const float* src, size_t size, float* dest) {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 minus_one = _mm_set1_ps(-1.f);
+  const __m128 scaling = _mm_set1_ps(32768.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    // The operands are ordered so that NaNs are kept as by FloatToFloatS16().
+    __m128 v = _mm_min_ps(one, _mm_loadu_ps(&src[i]));
+    v = _mm_max_ps(minus_one, v);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(v, scaling));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatToFloatS16(src[i]);
+  }
+}
+
+void FloatS16ToFloat_SSE2(const float* src, size_t size, float* dest) {
+  const __m128 max_value = _mm_set1_ps(32768.f);
+  const __m128 min_value = _mm_set1_ps(-32768.f);
+  const __m128 scaling = _mm_set1_ps(1.f / 32768.f);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m128 v = _mm_min_ps(max_value, _mm_loadu_ps(&src[i]));
+    v = _mm_max_ps(min_value, v);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(v, scaling));
+  }
+  for (; i < size; ++i) {
+    dest[i] = FloatS16ToFloat(src[i]);
+  }
+}
+
+void Deinterleave_SSE2(const float* interleaved,
+                       size_t samples_per_channel,
+                       size_t num_channels,
+                       float* const* deinterleaved) {
+  DeinterleaveImpl(interleaved, samples_per_channel, num_channels,
+                   deinterleaved);
+}
+
+void Interleave_SSE2(const float* const* deinterleaved,
+                     size_t samples_per_channel,
+                     size_t num_channels,
+                     float* interleaved) {
+  InterleaveImpl(deinterleaved, samples_per_channel, num_channels,
+                 interleaved);
+}
+
+void DeinterleaveS16ToFloatS16_SSE2(const int16_t* interleaved,
+                                    size_t samples_per_channel,
+                                    size_t num_channels,
+                                    float* const* deinterleaved) {
+  DeinterleaveImpl(interleaved, samples_per_channel, num_channels,
+                   deinterleaved);
+}
+
+void InterleaveFloatS16ToS16_SSE2(const float* const* deinterleaved,
+                                  size_t samples_per_channel,
+                                  size_t num_channels,
+                                  int16_t* interleaved) {
+  InterleaveImpl(deinterleaved, samples_per_channel, num_channels,
+                 interleaved);
+}
+
+void DownmixStereoToMono_SSE2(const int16_t* interleaved,
+                              size_t num_frames,
+                              int16_t* mono) {
+  const __m128i ones = _mm_set1_epi16(1);
+  size_t k = 0;
+  for (; k + 8 <= num_frames; k += 8) {
+    __m128i sums[2];
+    for (int j = 0; j < 2; ++j) {
+      const __m128i x = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(&interleaved[2 * k + 8 * j]));
+      const __m128i sum = _mm_madd_epi16(x, ones);
+      // Division by 2 rounding towards zero, as in the generic version.
+      sums[j] = _mm_srai_epi32(_mm_add_epi32(sum, _mm_srli_epi32(sum, 31)), 1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&mono[k]),
+                     _mm_packs_epi32(sums[0], sums[1]));
+  }
+  for (; k < num_frames; ++k) {
+    const int32_t sum = interleaved[2 * k] + interleaved[2 * k + 1];
+    mono[k] = sum / 2;
+  }
+}
+
+}  // namespace audio_util_kernels
+}  // namespace webrtc
@@ -20,6 +20,7 @@
 #include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -191,6 +192,13 @@ class ChannelBuffer {
     num_channels_ = num_channels;
   }
 
+  // Returns the size of the buffer and of the samples and views it owns.
+  size_t MemoryUsage() const {
+    return sizeof(*this) + size() * sizeof(T) +
+           2 * num_allocated_channels_ * num_bands_ * sizeof(T*) +
+           HeapBytes(bands_view_) + HeapBytes(channels_view_);
+  }
+
   void SetDataForTesting(const T* data, size_t size) {
     RTC_CHECK_EQ(size, this->size());
     memcpy(data_.get(), data, size * sizeof(*data));
@@ -75,6 +75,8 @@ static inline float FloatS16ToFloat(float v) {
   return v * kScaling;
 }
 
+// S16ToFloatS16(), FloatS16ToS16(), FloatToFloatS16() and FloatS16ToFloat()
+// are vectorized.
 void FloatToS16(const float* src, size_t size, int16_t* dest);
 void S16ToFloat(const int16_t* src, size_t size, float* dest);
 void S16ToFloatS16(const int16_t* src, size_t size, float* dest);
@@ -160,6 +162,25 @@ void Interleave(const DeinterleavedView<const T>& deinterleaved,
   }
 }
 
+// Specializations of `Deinterleave()` and `Interleave()` for float samples,
+// which are vectorized for 2, 4 and 8 channels.
+template <>
+void Deinterleave<float>(const InterleavedView<const float>& interleaved,
+                         const DeinterleavedView<float>& deinterleaved);
+template <>
+void Interleave<float>(const DeinterleavedView<const float>& deinterleaved,
+                       const InterleavedView<float>& interleaved);
+
+// Deinterleaves S16 audio from `interleaved` and converts it to FloatS16 in
+// `deinterleaved`. Same requirements as for `Deinterleave()`.
+void DeinterleaveS16ToFloatS16(InterleavedView<const int16_t> interleaved,
+                               DeinterleavedView<float> deinterleaved);
+
+// Converts FloatS16 audio from `deinterleaved` to S16 and interleaves it in
+// `interleaved`. Same requirements as for `Interleave()`.
+void InterleaveFloatS16ToS16(DeinterleavedView<const float> deinterleaved,
+                             InterleavedView<int16_t> interleaved);
+
 // Downmixes an interleaved multichannel signal to a single channel by averaging
 // all channels.
 // TODO: b/335805780 - Accept InterleavedView and DeinterleavedView.
@@ -192,6 +213,7 @@ void DownmixInterleavedToMono(const T* interleaved,
                               int num_channels,
                               T* deinterleaved);
 
+// Vectorized for 2 channels.
 // TODO: b/335805780 - Accept InterleavedView and DeinterleavedView.
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
@@ -38,6 +38,9 @@ class PushResampler final {
   // deinterleaved operation.
   int Resample(MonoView<const T> src, MonoView<T> dst);
 
+  // Returns the size of the resampler and of the buffers it owns.
+  size_t MemoryUsage() const;
+
  private:
   // Ensures that source and destination buffers for deinterleaving are
   // correctly configured prior to resampling that requires deinterleaving.
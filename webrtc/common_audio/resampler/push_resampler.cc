@@ -19,6 +19,7 @@
 #include "common_audio/include/audio_util.h"
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -120,6 +121,13 @@ int PushResampler<T>::Resample(MonoView<const T> src, MonoView<T> dst) {
   return resamplers_[0]->Resample(src, dst);
 }
 
+template <typename T>
+size_t PushResampler<T>::MemoryUsage() const {
+  return sizeof(*this) +
+         (source_view_.size() + destination_view_.size()) * sizeof(T) +
+         HeapBytes(resamplers_);
+}
+
 // Explictly generate required instantiations.
 template class PushResampler<int16_t>;
 template class PushResampler<float>;
@@ -24,12 +24,18 @@ PushSincResampler::PushSincResampler(size_t source_frames,
                                    this)),
       source_ptr_(nullptr),
       source_ptr_int_(nullptr),
+      source_(nullptr),
       destination_frames_(destination_frames),
       first_pass_(true),
       source_available_(0) {}
 
 PushSincResampler::~PushSincResampler() {}
 
+size_t PushSincResampler::MemoryUsage() const {
+  return sizeof(*this) + resampler_->MemoryUsage() +
+         (float_buffer_ ? sizeof(float) * destination_frames_ : 0);
+}
+
 size_t PushSincResampler::Resample(const int16_t* source,
                                    size_t source_length,
                                    int16_t* destination,
@@ -77,6 +83,17 @@ size_t PushSincResampler::Resample(const float* source,
   return destination_frames_;
 }
 
+size_t PushSincResampler::Resample(Source& source,
+                                   size_t source_frames,
+                                   float* destination,
+                                   size_t destination_capacity) {
+  source_ = &source;
+  // Pass nullptr as the float source to have Run() read from `source`.
+  Resample(nullptr, source_frames, destination, destination_capacity);
+  source_ = nullptr;
+  return destination_frames_;
+}
+
 void PushSincResampler::Run(size_t frames, float* destination) {
   // Ensure we are only asked for the available samples. This would fail if
   // Run() was triggered more than once per Resample() call.
@@ -92,6 +109,8 @@ void PushSincResampler::Run(size_t frames, float* destination) {
 
   if (source_ptr_) {
     std::memcpy(destination, source_ptr_, frames * sizeof(*destination));
+  } else if (source_) {
+    source_->Read(frames, destination);
   } else {
     for (size_t i = 0; i < frames; ++i)
       destination[i] = static_cast<float>(source_ptr_int_[i]);
@@ -27,6 +27,17 @@ namespace webrtc {
 // These Run() calls will happen on the same thread Resample() is called on.
 class PushSincResampler : public SincResamplerCallback {
  public:
+  // Provides the source signal of a Resample() call by writing it directly
+  // into the resampler input buffer. This avoids staging signals derived from
+  // the caller's data, e.g. a downmix or a channel of an interleaved signal, in
+  // an intermediate buffer.
+  class Source {
+   public:
+    virtual ~Source() = default;
+    // Writes the `frames` source samples to `destination`.
+    virtual void Read(size_t frames, float* destination) = 0;
+  };
+
   // Provide the size of the source and destination blocks in samples. These
   // must correspond to the same time duration (typically 10 ms) as the sample
   // ratio is inferred from them.
@@ -55,6 +66,14 @@ class PushSincResampler : public SincResamplerCallback {
                   size_t source_frames,
                   float* destination,
                   size_t destination_capacity);
+  // Same as above, with the `source_frames` source samples read from `source`.
+  size_t Resample(Source& source,
+                  size_t source_frames,
+                  float* destination,
+                  size_t destination_capacity);
+
+  // Returns the size of the resampler and of the buffers it owns.
+  size_t MemoryUsage() const;
 
   // Delay due to the filter kernel. Essentially, the time after which an input
   // sample will appear in the resampled output.
@@ -74,6 +93,7 @@ class PushSincResampler : public SincResamplerCallback {
   std::unique_ptr<float[]> float_buffer_;
   const float* source_ptr_;
   const int16_t* source_ptr_int_;
+  Source* source_;
   const size_t destination_frames_;
 
   // True on the first call to Resample(), to prime the SincResampler buffer.
@@ -94,6 +94,7 @@
 #include <limits>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/process_wide_cache.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
 
@@ -117,6 +118,78 @@ double SincScaleFactor(double io_ratio) {
   return sinc_scale_factor;
 }
 
+// The sub-sample shifted sinc() arguments and Blackman windows of the kernels,
+// which do not depend on the sample rate ratio.
+struct KernelTables {
+  KernelTables();
+
+  float pre_sinc[SincResampler::kKernelStorageSize];
+  float window[SincResampler::kKernelStorageSize];
+};
+
+KernelTables::KernelTables() {
+  // Blackman window parameters.
+  static const double kAlpha = 0.16;
+  static const double kA0 = 0.5 * (1.0 - kAlpha);
+  static const double kA1 = 0.5;
+  static const double kA2 = 0.5 * kAlpha;
+
+  constexpr size_t kKernelSize = SincResampler::kKernelSize;
+  constexpr size_t kKernelOffsetCount = SincResampler::kKernelOffsetCount;
+
+  // We generate a range of sub-sample offsets from 0.0 to 1.0.
+  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
+    const float subsample_offset =
+        static_cast<float>(offset_idx) / kKernelOffsetCount;
+
+    for (size_t i = 0; i < kKernelSize; ++i) {
+      const size_t idx = i + offset_idx * kKernelSize;
+      pre_sinc[idx] = static_cast<float>(
+          M_PI * (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
+                  subsample_offset));
+
+      // Compute Blackman window, matching the offset of the sinc().
+      const float x = (i - subsample_offset) / kKernelSize;
+      window[idx] = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
+                                       kA2 * cos(4.0 * M_PI * x));
+    }
+  }
+}
+
+const KernelTables& GetKernelTables() {
+  static const KernelTables* const tables = new KernelTables();
+  return *tables;
+}
+
+// Generates a set of windowed sinc() kernels, one per sub-sample offset.
+void ComputeKernels(double sinc_scale_factor, float* kernels) {
+  const KernelTables& tables = GetKernelTables();
+  for (size_t idx = 0; idx < SincResampler::kKernelStorageSize; ++idx) {
+    const float window = tables.window[idx];
+    const float pre_sinc = tables.pre_sinc[idx];
+
+    // Compute the sinc with offset, then window the sinc() function.
+    kernels[idx] = static_cast<float>(
+        window * ((pre_sinc == 0)
+                      ? sinc_scale_factor
+                      : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+  }
+}
+
+// Returns the kernels for `sinc_scale_factor`. Since only a few sample rate
+// ratios are used in practice, the kernels are computed once per process for
+// each of them and shared by all the resamplers.
+const float* GetSharedKernels(double sinc_scale_factor) {
+  static auto* const kernels = new ProcessWideCache<double, float*>();
+  return kernels->GetOrCreate(sinc_scale_factor, [&] {
+    // 32-byte aligned for SIMD optimizations.
+    float* shared_kernels = static_cast<float*>(AlignedMalloc(
+        sizeof(float) * SincResampler::kKernelStorageSize, 32));
+    ComputeKernels(sinc_scale_factor, shared_kernels);
+    return shared_kernels;
+  });
+}
+
 }  // namespace
 
 const size_t SincResampler::kKernelSize;
@@ -146,13 +219,8 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
+      kernel_(GetSharedKernels(SincScaleFactor(io_sample_rate_ratio_))),
       // Create input buffers with a 32-byte alignment for SIMD optimizations.
-      kernel_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
-      kernel_pre_sinc_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
-      kernel_window_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
       input_buffer_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * input_buffer_size_, 32))),
       convolve_proc_(nullptr),
@@ -163,19 +231,16 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
   RTC_DCHECK_GT(request_frames_, 0);
   Flush();
   RTC_DCHECK_GT(block_size_, kKernelSize);
-
-  memset(kernel_storage_.get(), 0,
-         sizeof(*kernel_storage_.get()) * kKernelStorageSize);
-  memset(kernel_pre_sinc_storage_.get(), 0,
-         sizeof(*kernel_pre_sinc_storage_.get()) * kKernelStorageSize);
-  memset(kernel_window_storage_.get(), 0,
-         sizeof(*kernel_window_storage_.get()) * kKernelStorageSize);
-
-  InitializeKernel();
 }
 
 SincResampler::~SincResampler() {}
 
+size_t SincResampler::MemoryUsage() const {
+  return sizeof(*this) +
+         sizeof(float) * ((kernel_storage_ ? kKernelStorageSize : 0) +
+                          input_buffer_size_);
+}
+
 void SincResampler::UpdateRegions(bool second_load) {
   // Setup various region pointers in the buffer (see diagram above).  If we're
   // on the second load we need to slide r0_ to the right by kKernelSize / 2.
@@ -192,43 +257,6 @@ void SincResampler::UpdateRegions(bool second_load) {
   RTC_DCHECK_LT(r2_, r3_);
 }
 
-void SincResampler::InitializeKernel() {
-  // Blackman window parameters.
-  static const double kAlpha = 0.16;
-  static const double kA0 = 0.5 * (1.0 - kAlpha);
-  static const double kA1 = 0.5;
-  static const double kA2 = 0.5 * kAlpha;
-
-  // Generates a set of windowed sinc() kernels.
-  // We generate a range of sub-sample offsets from 0.0 to 1.0.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    const float subsample_offset =
-        static_cast<float>(offset_idx) / kKernelOffsetCount;
-
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float pre_sinc = static_cast<float>(
-          M_PI * (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
-                  subsample_offset));
-      kernel_pre_sinc_storage_[idx] = pre_sinc;
-
-      // Compute Blackman window, matching the offset of the sinc().
-      const float x = (i - subsample_offset) / kKernelSize;
-      const float window = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
-                                              kA2 * cos(4.0 * M_PI * x));
-      kernel_window_storage_[idx] = window;
-
-      // Compute the sinc with offset, then window the sinc() function and store
-      // at the correct offset.
-      kernel_storage_[idx] = static_cast<float>(
-          window * ((pre_sinc == 0)
-                        ? sinc_scale_factor
-                        : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
-    }
-  }
-}
-
 void SincResampler::SetRatio(double io_sample_rate_ratio) {
   if (fabs(io_sample_rate_ratio_ - io_sample_rate_ratio) <
       std::numeric_limits<double>::epsilon()) {
@@ -237,21 +265,14 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
 
   io_sample_rate_ratio_ = io_sample_rate_ratio;
 
-  // Optimize reinitialization by reusing values which are independent of
-  // `sinc_scale_factor`.  Provides a 3x speedup.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float window = kernel_window_storage_[idx];
-      const float pre_sinc = kernel_pre_sinc_storage_[idx];
-
-      kernel_storage_[idx] = static_cast<float>(
-          window * ((pre_sinc == 0)
-                        ? sinc_scale_factor
-                        : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
-    }
+  // The shared kernel must not be modified, so the kernels are computed into
+  // storage owned by this instance from then on.
+  if (!kernel_storage_) {
+    kernel_storage_.reset(static_cast<float*>(
+        AlignedMalloc(sizeof(float) * kKernelStorageSize, 32)));
   }
+  ComputeKernels(SincScaleFactor(io_sample_rate_ratio_), kernel_storage_.get());
+  kernel_ = kernel_storage_.get();
 }
 
 void SincResampler::Resample(size_t frames, float* destination) {
@@ -266,7 +287,7 @@ void SincResampler::Resample(size_t frames, float* destination) {
   // Step (2) -- Resample!  const what we can outside of the loop for speed.  It
   // actually has an impact on ARM performance.  See inner loop comment below.
   const double current_io_ratio = io_sample_rate_ratio_;
-  const float* const kernel_ptr = kernel_storage_.get();
+  const float* const kernel_ptr = kernel_;
   while (remaining_frames) {
     // `i` may be negative if the last Resample() call ended on an iteration
     // that put `virtual_source_idx_` over the limit.
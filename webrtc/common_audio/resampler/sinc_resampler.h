@@ -75,25 +75,29 @@ class SincResampler {
 
   size_t request_frames() const { return request_frames_; }
 
+  // Returns the size of the resampler and of its input buffer. The kernels are
+  // shared by the resamplers with the same cutoff frequency and only counted
+  // once owned, i.e., after a call to SetRatio().
+  size_t MemoryUsage() const;
+
   // Flush all buffered data and reset internal indices.  Not thread safe, do
   // not call while Resample() is in progress.
   void Flush();
 
   // Update `io_sample_rate_ratio_`.  SetRatio() will cause a reconstruction of
-  // the kernels used for resampling.  Not thread safe, do not call while
-  // Resample() is in progress.
+  // the kernels used for resampling, into storage owned by the instance.  Not
+  // thread safe, do not call while Resample() is in progress.
   //
   // TODO(ajm): Use this in PushSincResampler rather than reconstructing
   // SincResampler.  We would also need a way to update `request_frames_`.
   void SetRatio(double io_sample_rate_ratio);
 
-  float* get_kernel_for_testing() { return kernel_storage_.get(); }
+  const float* get_kernel_for_testing() const { return kernel_; }
 
  private:
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, Convolve);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveBenchmark);
 
-  void InitializeKernel();
   void UpdateRegions(bool second_load);
 
   // Selects runtime specific CPU features like SSE.  Must be called before
@@ -149,10 +153,10 @@ class SincResampler {
 
   // Contains kKernelOffsetCount kernels back-to-back, each of size kKernelSize.
   // The kernel offsets are sub-sample shifts of a windowed sinc shifted from
-  // 0.0 to 1.0 sample.
+  // 0.0 to 1.0 sample. Points to the process-wide kernels for the initial
+  // ratio, or to `kernel_storage_` once the ratio has been changed.
+  const float* kernel_;
   std::unique_ptr<float[], AlignedFreeDeleter> kernel_storage_;
-  std::unique_ptr<float[], AlignedFreeDeleter> kernel_pre_sinc_storage_;
-  std::unique_ptr<float[], AlignedFreeDeleter> kernel_window_storage_;
 
   // Data from the source is copied into this buffer for each processing pass.
   std::unique_ptr<float[], AlignedFreeDeleter> input_buffer_;
@@ -26,6 +26,175 @@
 #define CIFFTSFT 14
 #define CIFFTRND 1
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__) && \
+    !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+
+#define WEBRTC_COMPLEX_FFT_SSE2
+
+// Truncates the 32 bit values in `a` and `b` to 16 bits, like the casts in the
+// generic code (i.e., without saturation).
+static __inline __m128i PackTruncate(__m128i a, __m128i b)
+{
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                           _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+// Returns the twiddle factors for the indices `m0` to `m3` of a stage laid out
+// for _mm_madd_epi16() on interleaved complex data, such that the products
+// with `w_tr` and `w_ti` give wr * xr - wi * xi and wi * xr + wr * xi.
+static __inline void LoadTwiddles(int m0,
+                                  int m1,
+                                  int m2,
+                                  int m3,
+                                  int k,
+                                  int wi_sign,
+                                  __m128i* w_tr,
+                                  __m128i* w_ti)
+{
+    const int16_t wr0 = kSinTable1024[(m0 << k) + 256];
+    const int16_t wr1 = kSinTable1024[(m1 << k) + 256];
+    const int16_t wr2 = kSinTable1024[(m2 << k) + 256];
+    const int16_t wr3 = kSinTable1024[(m3 << k) + 256];
+    const int16_t wi0 = (int16_t)(wi_sign * kSinTable1024[m0 << k]);
+    const int16_t wi1 = (int16_t)(wi_sign * kSinTable1024[m1 << k]);
+    const int16_t wi2 = (int16_t)(wi_sign * kSinTable1024[m2 << k]);
+    const int16_t wi3 = (int16_t)(wi_sign * kSinTable1024[m3 << k]);
+    *w_tr = _mm_setr_epi16(wr0, (int16_t)-wi0, wr1, (int16_t)-wi1,
+                           wr2, (int16_t)-wi2, wr3, (int16_t)-wi3);
+    *w_ti = _mm_setr_epi16(wi0, wr0, wi1, wr1, wi2, wr2, wi3, wr3);
+}
+
+// Computes four high-accuracy mode butterflies on the interleaved complex
+// values `q` (index i) and `x` (index j), rounding the outputs with `round`
+// and shifting them right by `shift` + CFFTSFT. The results are identical to
+// those of the generic code, for which CFFTSFT and CFFTRND equal CIFFTSFT and
+// CIFFTRND.
+static __inline void Butterflies(__m128i q,
+                                 __m128i x,
+                                 __m128i w_tr,
+                                 __m128i w_ti,
+                                 __m128i round,
+                                 __m128i shift,
+                                 __m128i* out_q,
+                                 __m128i* out_x)
+{
+    const __m128i rnd = _mm_set1_epi32(CFFTRND);
+    const __m128i tr = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(x, w_tr), rnd), 15 - CFFTSFT);
+    const __m128i ti = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(x, w_ti), rnd), 15 - CFFTSFT);
+    const __m128i t_lo = _mm_unpacklo_epi32(tr, ti);
+    const __m128i t_hi = _mm_unpackhi_epi32(tr, ti);
+
+    const __m128i q_lo = _mm_slli_epi32(
+        _mm_srai_epi32(_mm_unpacklo_epi16(q, q), 16), CFFTSFT);
+    const __m128i q_hi = _mm_slli_epi32(
+        _mm_srai_epi32(_mm_unpackhi_epi16(q, q), 16), CFFTSFT);
+
+    *out_q = PackTruncate(
+        _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(q_lo, t_lo), round), shift),
+        _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(q_hi, t_hi), round), shift));
+    *out_x = PackTruncate(
+        _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(q_lo, t_lo), round), shift),
+        _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(q_hi, t_hi), round), shift));
+}
+
+// Same as WebRtcSpl_MaxAbsValueW16() for `length` being a multiple of 8.
+static int16_t MaxAbsValueW16Sse2(const int16_t* vector, size_t length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i max_v = zero;
+    size_t i;
+    for (i = 0; i < length; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+        // The saturating negation maps -32768 to 32767, as does the generic
+        // code.
+        max_v = _mm_max_epi16(max_v, _mm_max_epi16(x, _mm_subs_epi16(zero, x)));
+    }
+    max_v = _mm_max_epi16(max_v,
+                          _mm_shuffle_epi32(max_v, _MM_SHUFFLE(1, 0, 3, 2)));
+    max_v = _mm_max_epi16(max_v,
+                          _mm_shuffle_epi32(max_v, _MM_SHUFFLE(2, 3, 0, 1)));
+    max_v = _mm_max_epi16(max_v, _mm_srli_epi32(max_v, 16));
+    return (int16_t)_mm_cvtsi128_si32(max_v);
+}
+
+// Computes the high-accuracy mode butterflies of one stage with n >= 8, four
+// butterflies at a time. `wi_sign` is -1 for the forward and 1 for the inverse
+// transform, and the outputs are rounded with `round` and shifted right by
+// `shift` + CFFTSFT.
+static void ComplexButterfliesSse2(int16_t frfi[],
+                                   int n,
+                                   int l,
+                                   int k,
+                                   int wi_sign,
+                                   int shift,
+                                   int32_t round)
+{
+    const __m128i round_v = _mm_set1_epi32(round);
+    const __m128i shift_v = _mm_cvtsi32_si128(shift + CFFTSFT);
+    __m128i w_tr, w_ti, out_q, out_x;
+    int i, m;
+
+    if (l < 4)
+    {
+        // The butterflies of the first two stages are within groups of two
+        // and four consecutive complex values, which are rearranged such that
+        // eight complex values give four butterflies.
+        if (l == 1)
+        {
+            LoadTwiddles(0, 0, 0, 0, k, wi_sign, &w_tr, &w_ti);
+        } else
+        {
+            LoadTwiddles(0, 1, 0, 1, k, wi_sign, &w_tr, &w_ti);
+        }
+        for (i = 0; i < n; i += 8)
+        {
+            __m128i* p = (__m128i*)&frfi[2 * i];
+            const __m128i v0 = _mm_loadu_si128(p);
+            const __m128i v1 = _mm_loadu_si128(p + 1);
+            if (l == 1)
+            {
+                const __m128 v0_f = _mm_castsi128_ps(v0);
+                const __m128 v1_f = _mm_castsi128_ps(v1);
+                Butterflies(
+                    _mm_castps_si128(
+                        _mm_shuffle_ps(v0_f, v1_f, _MM_SHUFFLE(2, 0, 2, 0))),
+                    _mm_castps_si128(
+                        _mm_shuffle_ps(v0_f, v1_f, _MM_SHUFFLE(3, 1, 3, 1))),
+                    w_tr, w_ti, round_v, shift_v, &out_q, &out_x);
+                _mm_storeu_si128(p, _mm_unpacklo_epi32(out_q, out_x));
+                _mm_storeu_si128(p + 1, _mm_unpackhi_epi32(out_q, out_x));
+            } else
+            {
+                Butterflies(_mm_unpacklo_epi64(v0, v1),
+                            _mm_unpackhi_epi64(v0, v1), w_tr, w_ti, round_v,
+                            shift_v, &out_q, &out_x);
+                _mm_storeu_si128(p, _mm_unpacklo_epi64(out_q, out_x));
+                _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(out_q, out_x));
+            }
+        }
+        return;
+    }
+
+    for (m = 0; m < l; m += 4)
+    {
+        LoadTwiddles(m, m + 1, m + 2, m + 3, k, wi_sign, &w_tr, &w_ti);
+        for (i = m; i < n; i += l << 1)
+        {
+            __m128i* p_i = (__m128i*)&frfi[2 * i];
+            __m128i* p_j = (__m128i*)&frfi[2 * (i + l)];
+            Butterflies(_mm_loadu_si128(p_i), _mm_loadu_si128(p_j), w_tr,
+                        w_ti, round_v, shift_v, &out_q, &out_x);
+            _mm_storeu_si128(p_i, out_q);
+            _mm_storeu_si128(p_j, out_x);
+        }
+    }
+}
+#endif
+
 
 int WebRtcSpl_ComplexFFT(int16_t frfi[], int stages, int mode)
 {
@@ -91,6 +260,16 @@ int WebRtcSpl_ComplexFFT(int16_t frfi[], int stages, int mode)
         {
             istep = l << 1;
 
+#if defined(WEBRTC_COMPLEX_FFT_SSE2)
+            if (n >= 8)
+            {
+                ComplexButterfliesSse2(frfi, n, l, k, -1, 1, CFFTRND2);
+                --k;
+                l = istep;
+                continue;
+            }
+#endif
+
             for (m = 0; m < l; ++m)
             {
                 j = m << k;
@@ -183,7 +362,12 @@ int WebRtcSpl_ComplexIFFT(int16_t frfi[], int stages, int mode)
         shift = 0;
         round2 = 8192;
 
+#if defined(WEBRTC_COMPLEX_FFT_SSE2)
+        tmp32 = n >= 8 ? MaxAbsValueW16Sse2(frfi, 2 * n)
+                       : WebRtcSpl_MaxAbsValueW16(frfi, 2 * n);
+#else
         tmp32 = WebRtcSpl_MaxAbsValueW16(frfi, 2 * n);
+#endif
         if (tmp32 > 13573)
         {
             shift++;
@@ -199,6 +383,16 @@ int WebRtcSpl_ComplexIFFT(int16_t frfi[], int stages, int mode)
 
         istep = l << 1;
 
+#if defined(WEBRTC_COMPLEX_FFT_SSE2)
+        if (mode != 0 && n >= 8)
+        {
+            ComplexButterfliesSse2(frfi, (int)n, (int)l, k, 1, shift, round2);
+            --k;
+            l = istep;
+            continue;
+        }
+#endif
+
         if (mode == 0)
         {
             // mode==0: Low-complexity and Low-accuracy mode
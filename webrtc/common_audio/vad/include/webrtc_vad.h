@@ -33,6 +33,9 @@ VadInst* WebRtcVad_Create(void);
 // - handle [i] : Pointer to VAD instance that should be freed.
 void WebRtcVad_Free(VadInst* handle);
 
+// Returns the size of a VAD instance created by WebRtcVad_Create().
+size_t WebRtcVad_MemoryUsage(void);
+
 // Initializes a VAD instance.
 //
 // - handle [i/o] : Instance that should be initialized.
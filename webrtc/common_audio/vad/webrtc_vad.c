@@ -33,6 +33,10 @@ void WebRtcVad_Free(VadInst* handle) {
   free(handle);
 }
 
+size_t WebRtcVad_MemoryUsage(void) {
+  return sizeof(VadInstT);
+}
+
 // TODO(bjornv): Move WebRtcVad_InitCore() code here.
 int WebRtcVad_Init(VadInst* handle) {
   // Initialize the core VAD component.
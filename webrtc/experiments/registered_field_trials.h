@@ -12,12 +12,15 @@ inline constexpr absl::string_view kRegisteredFieldTrials[] = {
     "WebRTC-AddNetworkCostToVpn",
     "WebRTC-AddPacingToCongestionWindowPushback",
     "WebRTC-AdjustOpusBandwidth",
+    "WebRTC-Aec3AdaptiveRefinedFilterLength",
     "WebRTC-Aec3AecStateFullResetKillSwitch",
     "WebRTC-Aec3AecStateSubtractorAnalyzerResetKillSwitch",
     "WebRTC-Aec3AntiHowlingMinimizationKillSwitch",
     "WebRTC-Aec3BufferingMaxAllowedExcessRenderBlocksOverride",
+    "WebRTC-Aec3BypassOnRenderSilence",
     "WebRTC-Aec3ClampInstQualityToOneKillSwitch",
     "WebRTC-Aec3ClampInstQualityToZeroKillSwitch",
+    "WebRTC-Aec3ClockdriftCompensation",
     "WebRTC-Aec3CoarseFilterResetHangoverKillSwitch",
     "WebRTC-Aec3ConservativeTailFreqResponse",
     "WebRTC-Aec3DeactivateInitialStateResetKillSwitch",
@@ -44,6 +47,7 @@ inline constexpr absl::string_view kRegisteredFieldTrials[] = {
     "WebRTC-Aec3MinErleDuringOnsetsKillSwitch",
     "WebRTC-Aec3NonlinearModeReverbKillSwitch",
     "WebRTC-Aec3OnsetDetectionKillSwitch",
+    "WebRTC-Aec3PinnedDelayOverride",
     "WebRTC-Aec3RenderDelayEstimationLeftRightPrioritizationKillSwitch",
     "WebRTC-Aec3SensitiveDominantNearendActivation",
     "WebRTC-Aec3SetupSpecificDefaultConfigDefaultsKillSwitch",
@@ -83,9 +87,11 @@ inline constexpr absl::string_view kRegisteredFieldTrials[] = {
     "WebRTC-Aec3UseLowEarlyReflectionsDefaultGain",
     "WebRTC-Aec3UseLowLateReflectionsDefaultGain",
     "WebRTC-Aec3UseNearendReverbLen",
+    "WebRTC-Aec3UsePffft",
     "WebRTC-Aec3UseShortConfigChangeDuration",
     "WebRTC-Aec3UseZeroInitialStateDuration",
     "WebRTC-Aec3VerySensitiveDominantNearendActivation",
+    "WebRTC-Agc1FloatDigitalPathKillSwitch",
     "WebRTC-Agc2SimdAvx2KillSwitch",
     "WebRTC-Agc2SimdNeonKillSwitch",
     "WebRTC-Agc2SimdSse2KillSwitch",
@@ -200,6 +206,7 @@ inline constexpr absl::string_view kRegisteredFieldTrials[] = {
     "WebRTC-Network-UseNWPathMonitor",
     "WebRTC-NetworkMonitorAutoDetect",
     "WebRTC-NormalizeSimulcastResolution",
+    "WebRTC-NsPffftKillSwitch",
     "WebRTC-Pacer-BlockAudio",
     "WebRTC-Pacer-DrainQueue",
     "WebRTC-Pacer-FastRetransmissions",
@@ -622,6 +622,11 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
   }
 }
 
+void AdaptiveFirFilter::SkipAdaptation(std::vector<float>* impulse_response) {
+  UpdateSize();
+  ConstrainAndUpdateImpulseResponse(impulse_response);
+}
+
 void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
                                            const FftData& G) {
   // Update the filter size if needed.
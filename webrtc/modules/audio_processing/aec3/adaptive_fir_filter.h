@@ -23,6 +23,7 @@
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -125,6 +126,12 @@ class AdaptiveFirFilter {
   // Adapts the filter.
   void Adapt(const RenderBuffer& render_buffer, const FftData& G);
 
+  // Performs the filter size update and the cyclic constraint of Adapt(), but
+  // leaves the filter coefficients otherwise unchanged. Used when restoring a
+  // stored, already constrained, filter to recompute `impulse_response` one
+  // partition per call.
+  void SkipAdaptation(std::vector<float>* impulse_response);
+
   // Receives reports that known echo path changes have occured and adjusts
   // the filter adaptation accordingly.
   void HandleEchoPathChange();
@@ -159,6 +166,10 @@ class AdaptiveFirFilter {
   // Gets the filter coefficients.
   const std::vector<std::vector<FftData>>& GetFilter() const { return H_; }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(H_);
+  }
+
  private:
   // Adapts the filter and updates the filter size.
   void AdaptAndUpdateSize(const RenderBuffer& render_buffer, const FftData& G);
@@ -38,8 +38,6 @@ constexpr size_t kFftLengthBy2Minus1 = kFftLengthBy2 - 1;
 constexpr size_t kFftLength = 2 * kFftLengthBy2;
 constexpr size_t kFftLengthBy2Log2 = 6;
 
-constexpr int kRenderTransferQueueSizeFrames = 100;
-
 constexpr size_t kMaxNumBands = 3;
 constexpr size_t kFrameSize = 160;
 constexpr size_t kSubFrameLength = kFrameSize / 2;
@@ -51,6 +49,8 @@ constexpr size_t kExtendedBlockSize = 2 * kFftLengthBy2;
 constexpr size_t kMatchedFilterWindowSizeSubBlocks = 32;
 constexpr size_t kMatchedFilterAlignmentShiftSizeSubBlocks =
     kMatchedFilterWindowSizeSubBlocks * 3 / 4;
+constexpr size_t kFftMatchedFilterHopSizeSubBlocks =
+    kMatchedFilterWindowSizeSubBlocks;
 
 // TODO(peah): Integrate this with how it is done inside audio_processing_impl.
 constexpr size_t NumBandsForRate(int sample_rate_hz) {
@@ -15,7 +15,7 @@
 #include <iterator>
 
 #include "rtc_base/checks.h"
-#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -71,17 +71,43 @@ const float kSqrtHanning128[kFftLength] = {
     0.19509032201613f, 0.17096188876030f, 0.14673047445536f, 0.12241067519922f,
     0.09801714032956f, 0.07356456359967f, 0.04906767432742f, 0.02454122852291f};
 
-bool IsSse2Available() {
-#if defined(WEBRTC_ARCH_X86_FAMILY)
-  return GetCPUInfo(kSSE2) != 0;
-#else
-  return false;
-#endif
+RealFft::Backend SelectBackend() {
+  return field_trial::IsEnabled("WebRTC-Aec3UsePffft")
+             ? RealFft::Backend::kPffft
+             : RealFft::Backend::kOoura;
+}
+
+// Concatenates x_old and x into `fft` while applying the time-domain window.
+void FormPaddedInput(rtc::ArrayView<const float> x,
+                     rtc::ArrayView<const float> x_old,
+                     Aec3Fft::Window window,
+                     std::array<float, kFftLength>* fft) {
+  switch (window) {
+    case Aec3Fft::Window::kRectangular:
+      std::copy(x_old.begin(), x_old.end(), fft->begin());
+      std::copy(x.begin(), x.end(), fft->begin() + x_old.size());
+      break;
+    case Aec3Fft::Window::kHanning:
+      RTC_DCHECK_NOTREACHED();
+      break;
+    case Aec3Fft::Window::kSqrtHanning:
+      std::transform(x_old.begin(), x_old.end(), std::begin(kSqrtHanning128),
+                     fft->begin(), std::multiplies<float>());
+      std::transform(x.begin(), x.end(),
+                     std::begin(kSqrtHanning128) + x_old.size(),
+                     fft->begin() + x_old.size(), std::multiplies<float>());
+      break;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
 }
 
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() : Aec3Fft(SelectBackend()) {}
+
+Aec3Fft::Aec3Fft(RealFft::Backend backend)
+    : fft_(RealFft::Create(kFftLength, backend)) {}
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
@@ -118,27 +144,33 @@ void Aec3Fft::PaddedFft(rtc::ArrayView<const float> x,
   RTC_DCHECK_EQ(kFftLengthBy2, x.size());
   RTC_DCHECK_EQ(kFftLengthBy2, x_old.size());
   std::array<float, kFftLength> fft;
+  FormPaddedInput(x, x_old, window, &fft);
+  Fft(&fft, X);
+}
 
-  switch (window) {
-    case Window::kRectangular:
-      std::copy(x_old.begin(), x_old.end(), fft.begin());
-      std::copy(x.begin(), x.end(), fft.begin() + x_old.size());
-      break;
-    case Window::kHanning:
-      RTC_DCHECK_NOTREACHED();
-      break;
-    case Window::kSqrtHanning:
-      std::transform(x_old.begin(), x_old.end(), std::begin(kSqrtHanning128),
-                     fft.begin(), std::multiplies<float>());
-      std::transform(x.begin(), x.end(),
-                     std::begin(kSqrtHanning128) + x_old.size(),
-                     fft.begin() + x_old.size(), std::multiplies<float>());
-      break;
-    default:
-      RTC_DCHECK_NOTREACHED();
+void Aec3Fft::PaddedFft(const Block& x,
+                        const Block& x_old,
+                        Window window,
+                        rtc::ArrayView<FftData> X) const {
+  const size_t num_channels = x.NumChannels();
+  RTC_DCHECK_EQ(num_channels, x_old.NumChannels());
+  RTC_DCHECK_EQ(num_channels, X.size());
+  if (batch_.size() != num_channels) {
+    batch_.resize(num_channels);
+    batch_pointers_.resize(num_channels);
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      batch_pointers_[ch] = batch_[ch].data();
+    }
   }
 
-  Fft(&fft, X);
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    FormPaddedInput(x.View(/*band=*/0, ch), x_old.View(/*band=*/0, ch), window,
+                    &batch_[ch]);
+  }
+  fft_->ForwardBatch(batch_pointers_);
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    X[ch].CopyFromPackedArray(batch_[ch]);
+  }
 }
 
 }  // namespace webrtc
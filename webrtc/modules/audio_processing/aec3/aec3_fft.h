@@ -12,12 +12,16 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_AEC3_FFT_H_
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "api/array_view.h"
-#include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/utility/real_fft.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -27,7 +31,10 @@ class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
 
+  // Uses the Ooura backend unless the PFFFT backend is enabled via the
+  // WebRTC-Aec3UsePffft field trial.
   Aec3Fft();
+  explicit Aec3Fft(RealFft::Backend backend);
 
   Aec3Fft(const Aec3Fft&) = delete;
   Aec3Fft& operator=(const Aec3Fft&) = delete;
@@ -36,14 +43,14 @@ class Aec3Fft {
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
-    ooura_fft_.Fft(x->data());
+    fft_->Forward(*x);
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
     X.CopyToPackedArray(x);
-    ooura_fft_.InverseFft(x->data());
+    fft_->Inverse(*x);
   }
 
   // Windows the input using a Hanning window, and then adds padding of
@@ -66,8 +73,25 @@ class Aec3Fft {
                  Window window,
                  FftData* X) const;
 
+  // Batched padded Fft of the lowest band of all the channels in `x` and
+  // `x_old`, transforming all channels with a single call to the backend.
+  void PaddedFft(const Block& x,
+                 const Block& x_old,
+                 Window window,
+                 rtc::ArrayView<FftData> X) const;
+
+  RealFft::Backend backend() const { return fft_->backend(); }
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(batch_) +
+           HeapBytes(batch_pointers_);
+  }
+
  private:
-  const OouraFft ooura_fft_;
+  const std::unique_ptr<RealFft> fft_;
+  // Scratch buffers for the batched transforms.
+  mutable std::vector<std::array<float, kFftLength>> batch_;
+  mutable std::vector<float*> batch_pointers_;
 };
 
 }  // namespace webrtc
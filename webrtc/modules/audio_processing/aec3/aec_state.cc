@@ -11,6 +11,7 @@
 #include "modules/audio_processing/aec3/aec_state.h"
 
 #include <math.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <numeric>
@@ -323,6 +324,18 @@ void AecState::Update(
                         subtractor_output[0].e2_refined);
 }
 
+void AecState::GetState(StateWriter* writer) const {
+  initial_state_.GetState(writer);
+  erl_estimator_.GetState(writer);
+  erle_estimator_.GetState(writer);
+}
+
+void AecState::SetState(StateReader* reader) {
+  initial_state_.SetState(reader);
+  erl_estimator_.SetState(reader);
+  erle_estimator_.SetState(reader);
+}
+
 AecState::InitialState::InitialState(const EchoCanceller3Config& config)
     : conservative_initial_phase_(config.filter.conservative_initial_phase),
       initial_state_seconds_(config.filter.initial_state_seconds) {
@@ -351,6 +364,16 @@ void AecState::InitialState::InitialState::Update(bool active_render,
   transition_triggered_ = !initial_state_ && prev_initial_state;
 }
 
+void AecState::InitialState::GetState(StateWriter* writer) const {
+  writer->WriteUint32(static_cast<uint32_t>(
+      std::min<size_t>(strong_not_saturated_render_blocks_, UINT32_MAX)));
+}
+
+void AecState::InitialState::SetState(StateReader* reader) {
+  strong_not_saturated_render_blocks_ = reader->ReadUint32();
+  Update(/*active_render=*/false, /*saturated_capture=*/false);
+}
+
 AecState::FilterDelay::FilterDelay(const EchoCanceller3Config& config,
                                    size_t num_capture_channels)
     : delay_headroom_blocks_(config.delay.delay_headroom_samples / kBlockSize),
@@ -30,9 +30,11 @@
 #include "modules/audio_processing/aec3/filter_analyzer.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/reverb_model_estimator.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/aec3/subtractor_output_analyzer.h"
 #include "modules/audio_processing/aec3/transparent_mode.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -135,6 +137,14 @@ class AecState {
     return initial_state_.TransitionTriggered();
   }
 
+  // Writes the ERL and ERLE estimates and the progress out of the initial
+  // state to `writer`.
+  void GetState(StateWriter* writer) const;
+
+  // Restores a state written by GetState(). If the restored state has left the
+  // initial state, the transition out of it is triggered.
+  void SetState(StateReader* reader);
+
   // Updates the aec state.
   // TODO(bugs.webrtc.org/10913): Compute multi-channel ERL.
   void Update(
@@ -148,12 +158,23 @@ class AecState {
       rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
       rtc::ArrayView<const SubtractorOutput> subtractor_output);
 
+  // Returns the length in blocks of the part of the linear filters that holds
+  // the echo tail, if it has been measured.
+  std::optional<int> FilterTailLengthBlocks() const {
+    return filter_analyzer_.TailLengthBlocks();
+  }
+
   // Returns filter length in blocks.
   int FilterLengthBlocks() const {
     // All filters have the same length, so arbitrarily return channel 0 length.
     return filter_analyzer_.FilterLengthBlocks();
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(erle_estimator_) +
+           HeapBytes(filter_analyzer_);
+  }
+
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -180,6 +201,10 @@ class AecState {
     // Returns that the transition from the initial state has was started.
     bool TransitionTriggered() const { return transition_triggered_; }
 
+    // Writes and restores the amount of render seen in the initial state.
+    void GetState(StateWriter* writer) const;
+    void SetState(StateReader* reader);
+
    private:
     const bool conservative_initial_phase_;
     const float initial_state_seconds_;
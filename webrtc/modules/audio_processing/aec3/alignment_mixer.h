@@ -17,6 +17,7 @@
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -36,6 +37,10 @@ class AlignmentMixer {
 
   void ProduceOutput(const Block& x, rtc::ArrayView<float, kBlockSize> y);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(cumulative_energies_);
+  }
+
   enum class MixingVariant { kDownmix, kAdaptive, kFixed };
 
  private:
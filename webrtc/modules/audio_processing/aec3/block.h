@@ -16,6 +16,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -75,6 +76,8 @@ class Block {
     data_.swap(b.data_);
   }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(data_); }
+
  private:
   // Returns the index of the first sample of the requested |band| and
   // |channel|.
@@ -17,6 +17,7 @@
 
 #include "modules/audio_processing/aec3/block.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -49,6 +50,8 @@ struct BlockBuffer {
   void IncReadIndex() { read = IncIndex(read); }
   void DecReadIndex() { read = DecIndex(read); }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer); }
+
   const int size;
   std::vector<Block> buffer;
   int write = 0;
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "modules/audio_processing/audio_buffer.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -32,6 +33,8 @@ class BlockDelayBuffer {
   // Delays the samples by the specified delay.
   void DelaySignal(AudioBuffer* frame);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buf_); }
+
  private:
   const size_t frame_length_;
   const size_t delay_;
@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -39,6 +40,8 @@ class BlockFramer {
       const Block& block,
       std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer_); }
+
  private:
   const size_t num_bands_;
   const size_t num_channels_;
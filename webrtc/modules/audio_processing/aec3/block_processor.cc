@@ -11,6 +11,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <optional>
@@ -26,15 +27,22 @@
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/render_reference_aligner.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
+#include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
 namespace {
 
 enum class BlockProcessorApiCall { kCapture, kRender };
 
+// Maximum clockdrift, as the change of the delay per sample, that is
+// compensated for.
+constexpr float kMaxClockdriftRate = 0.002f;
+
 class BlockProcessorImpl final : public BlockProcessor {
  public:
   BlockProcessorImpl(const EchoCanceller3Config& config,
@@ -63,7 +71,28 @@ class BlockProcessorImpl final : public BlockProcessor {
   void SetAudioBufferDelay(int delay_ms) override;
   void SetCaptureOutputUsage(bool capture_output_used) override;
 
+  void GetState(StateWriter* writer) const override;
+  void SetState(StateReader* reader) override;
+
+  size_t MemoryUsage() const override;
+
  private:
+  // Resets the delay controller, after which any restored delay that has not
+  // yet been confirmed by the delay estimator is applied again.
+  void ResetDelayController(bool reset_delay_confidence);
+
+  // Aligns the render buffer to the restored delay without reporting it as a
+  // delay change, as that would reset the restored echo remover state.
+  void ApplyRestoredDelay();
+
+  // Aligns the render buffer to the pinned delay, which is reported as a delay
+  // change whenever it is (re)applied after a render buffer reset.
+  void ApplyPinnedDelay(EchoPathVariability* echo_path_variability);
+
+  // Adds any newly estimated residual clockdrift to the compensation applied
+  // to the render signal.
+  void UpdateClockdriftCompensation();
+
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const EchoCanceller3Config config_;
@@ -73,10 +102,15 @@ class BlockProcessorImpl final : public BlockProcessor {
   std::unique_ptr<RenderDelayBuffer> render_buffer_;
   std::unique_ptr<RenderDelayController> delay_controller_;
   std::unique_ptr<EchoRemover> echo_remover_;
+  std::unique_ptr<RenderReferenceAligner> reference_aligner_;
+  Block aligned_render_block_;
   BlockProcessorMetrics metrics_;
   RenderDelayBuffer::BufferingEvent render_event_;
   size_t capture_call_counter_ = 0;
   std::optional<DelayEstimate> estimated_delay_;
+  std::optional<size_t> restored_delay_;
+  bool apply_restored_delay_ = false;
+  float clockdrift_rate_ = 0.f;
 };
 
 std::atomic<int> BlockProcessorImpl::instance_count_(0);
@@ -95,8 +129,15 @@ BlockProcessorImpl::BlockProcessorImpl(
       render_buffer_(std::move(render_buffer)),
       delay_controller_(std::move(delay_controller)),
       echo_remover_(std::move(echo_remover)),
+      aligned_render_block_(NumBandsForRate(sample_rate_hz),
+                            num_render_channels),
       render_event_(RenderDelayBuffer::BufferingEvent::kNone) {
   RTC_DCHECK(ValidFullBandRate(sample_rate_hz_));
+  if (config_.multi_channel.independent_render_references &&
+      num_render_channels > 1 && delay_controller_) {
+    reference_aligner_ = std::make_unique<RenderReferenceAligner>(
+        config_, sample_rate_hz, num_render_channels, num_capture_channels);
+  }
 }
 
 BlockProcessorImpl::~BlockProcessorImpl() = default;
@@ -120,8 +161,10 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
     if (!capture_properly_started_) {
       capture_properly_started_ = true;
       render_buffer_->Reset();
-      if (delay_controller_)
-        delay_controller_->Reset(true);
+      if (reference_aligner_) {
+        reference_aligner_->Reset();
+      }
+      ResetDelayController(true);
     }
   } else {
     // If no render data has yet arrived, do not process the capture signal.
@@ -137,8 +180,7 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
       render_properly_started_) {
     echo_path_variability.delay_change =
         EchoPathVariability::DelayAdjustment::kBufferFlush;
-    if (delay_controller_)
-      delay_controller_->Reset(true);
+    ResetDelayController(true);
     RTC_LOG(LS_WARNING) << "Reset due to render buffer overrun at block  "
                         << capture_call_counter_;
   }
@@ -151,8 +193,7 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
       render_buffer_->PrepareCaptureProcessing();
   // Reset the delay controller at render buffer underrun.
   if (buffer_event == RenderDelayBuffer::BufferingEvent::kRenderUnderrun) {
-    if (delay_controller_)
-      delay_controller_->Reset(false);
+    ResetDelayController(false);
   }
 
   data_dumper_->DumpWav("aec3_processblock_capture_input2",
@@ -160,17 +201,39 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
                         1);
 
   bool has_delay_estimator = !config_.delay.use_external_delay_estimator;
-  if (has_delay_estimator) {
+  if (config_.delay.use_pinned_delay) {
+    RTC_DCHECK(!delay_controller_);
+    ApplyPinnedDelay(&echo_path_variability);
+  } else if (has_delay_estimator) {
     RTC_DCHECK(delay_controller_);
+    if (apply_restored_delay_) {
+      ApplyRestoredDelay();
+    }
+
     // Compute and apply the render delay required to achieve proper signal
-    // alignment.
-    estimated_delay_ = delay_controller_->GetDelay(
-        render_buffer_->GetDownsampledRenderBuffer(), render_buffer_->Delay(),
-        *capture_block);
+    // alignment. With independent render references, the delay is that of
+    // the earliest reference, to which the other references are aligned.
+    bool reference_alignment_change = false;
+    if (reference_aligner_) {
+      estimated_delay_ = reference_aligner_->EstimateDelay(
+          *capture_block, &reference_alignment_change);
+    } else {
+      estimated_delay_ = delay_controller_->GetDelay(
+          render_buffer_->GetDownsampledRenderBuffer(),
+          render_buffer_->Delay(), *capture_block);
+    }
+
+    // Once the delay estimator produces an estimate, it takes over from the
+    // restored delay.
+    if (restored_delay_ && estimated_delay_ &&
+        estimated_delay_->blocks_since_last_update == 0) {
+      restored_delay_ = std::nullopt;
+    }
 
     if (estimated_delay_) {
       bool delay_change =
-          render_buffer_->AlignFromDelay(estimated_delay_->delay);
+          render_buffer_->AlignFromDelay(estimated_delay_->delay) ||
+          reference_alignment_change;
       if (delay_change) {
         rtc::LoggingSeverity log_level =
             config_.delay.log_warning_on_delay_changes ? rtc::LS_WARNING
@@ -182,7 +245,13 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
       }
     }
 
-    echo_path_variability.clock_drift = delay_controller_->HasClockdrift();
+    echo_path_variability.clock_drift =
+        reference_aligner_ ? reference_aligner_->HasClockdrift()
+                           : delay_controller_->HasClockdrift();
+
+    if (config_.delay.compensate_clockdrift) {
+      UpdateClockdriftCompensation();
+    }
 
   } else {
     render_buffer_->AlignFromExternalDelay();
@@ -206,7 +275,12 @@ void BlockProcessorImpl::BufferRender(const Block& block) {
   data_dumper_->DumpWav("aec3_processblock_render_input",
                         block.View(/*band=*/0, /*channel=*/0), 16000, 1);
 
-  render_event_ = render_buffer_->Insert(block);
+  if (reference_aligner_) {
+    reference_aligner_->BufferRender(block, &aligned_render_block_);
+    render_event_ = render_buffer_->Insert(aligned_render_block_);
+  } else {
+    render_event_ = render_buffer_->Insert(block);
+  }
 
   metrics_.UpdateRender(render_event_ !=
                         RenderDelayBuffer::BufferingEvent::kNone);
@@ -235,6 +309,87 @@ void BlockProcessorImpl::SetCaptureOutputUsage(bool capture_output_used) {
   echo_remover_->SetCaptureOutputUsage(capture_output_used);
 }
 
+size_t BlockProcessorImpl::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(render_buffer_) +
+         HeapBytes(delay_controller_) + HeapBytes(echo_remover_) +
+         HeapBytes(reference_aligner_) + HeapBytes(aligned_render_block_);
+}
+
+void BlockProcessorImpl::GetState(StateWriter* writer) const {
+  writer->WriteUint32(estimated_delay_ ? 1 : 0);
+  writer->WriteUint32(estimated_delay_ ? estimated_delay_->delay : 0);
+  echo_remover_->GetState(writer);
+}
+
+void BlockProcessorImpl::SetState(StateReader* reader) {
+  const bool has_delay = reader->ReadUint32() != 0;
+  const size_t delay = reader->ReadUint32();
+  // The delay is applied with the next capture block, after any reset of the
+  // delay controller that is done when the capture processing starts.
+  if (has_delay && delay_controller_) {
+    restored_delay_ = std::min(delay, render_buffer_->MaxDelay());
+    apply_restored_delay_ = true;
+  }
+  echo_remover_->SetState(reader);
+}
+
+void BlockProcessorImpl::ResetDelayController(bool reset_delay_confidence) {
+  if (delay_controller_) {
+    delay_controller_->Reset(reset_delay_confidence);
+    if (reference_aligner_) {
+      reference_aligner_->ResetDelayControllers(reset_delay_confidence);
+    }
+    apply_restored_delay_ = restored_delay_.has_value();
+  }
+}
+
+void BlockProcessorImpl::ApplyRestoredDelay() {
+  RTC_DCHECK(restored_delay_);
+  RTC_DCHECK(delay_controller_);
+  delay_controller_->SetDelay(*restored_delay_);
+  render_buffer_->AlignFromDelay(*restored_delay_);
+  apply_restored_delay_ = false;
+}
+
+void BlockProcessorImpl::ApplyPinnedDelay(
+    EchoPathVariability* echo_path_variability) {
+  // The headroom is subtracted in the same way as for the estimated delays.
+  const size_t delay_samples =
+      config_.delay.pinned_delay_samples > config_.delay.delay_headroom_samples
+          ? config_.delay.pinned_delay_samples -
+                config_.delay.delay_headroom_samples
+          : 0;
+  const size_t delay_blocks =
+      std::min(delay_samples >> kBlockSizeLog2, render_buffer_->MaxDelay());
+  if (!estimated_delay_) {
+    estimated_delay_ =
+        DelayEstimate(DelayEstimate::Quality::kRefined, delay_blocks);
+  }
+  if (render_buffer_->AlignFromDelay(delay_blocks)) {
+    RTC_LOG(LS_INFO) << "Pinned delay of " << delay_blocks
+                     << " blocks applied at block " << capture_call_counter_;
+    echo_path_variability->delay_change =
+        EchoPathVariability::DelayAdjustment::kNewDetectedDelay;
+  }
+}
+
+void BlockProcessorImpl::UpdateClockdriftCompensation() {
+  RTC_DCHECK(delay_controller_);
+  std::optional<float> rate = delay_controller_->ClockdriftRate();
+  if (!rate) {
+    return;
+  }
+  // The drift is estimated on the compensated render signal, so the estimate
+  // is the drift that remains to be compensated for.
+  delay_controller_->ResetClockdriftRate();
+  clockdrift_rate_ = rtc::SafeClamp(clockdrift_rate_ + *rate,
+                                    -kMaxClockdriftRate, kMaxClockdriftRate);
+  render_buffer_->SetClockdriftRate(clockdrift_rate_);
+  RTC_LOG(LS_INFO) << "Clockdrift compensation set to "
+                   << clockdrift_rate_ * 1e6f << " ppm at block "
+                   << capture_call_counter_;
+}
+
 }  // namespace
 
 BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
@@ -244,7 +399,8 @@ BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
   std::unique_ptr<RenderDelayBuffer> render_buffer(
       RenderDelayBuffer::Create(config, sample_rate_hz, num_render_channels));
   std::unique_ptr<RenderDelayController> delay_controller;
-  if (!config.delay.use_external_delay_estimator) {
+  if (!config.delay.use_external_delay_estimator &&
+      !config.delay.use_pinned_delay) {
     delay_controller.reset(RenderDelayController::Create(config, sample_rate_hz,
                                                          num_capture_channels));
   }
@@ -262,7 +418,8 @@ BlockProcessor* BlockProcessor::Create(
     size_t num_capture_channels,
     std::unique_ptr<RenderDelayBuffer> render_buffer) {
   std::unique_ptr<RenderDelayController> delay_controller;
-  if (!config.delay.use_external_delay_estimator) {
+  if (!config.delay.use_external_delay_estimator &&
+      !config.delay.use_pinned_delay) {
     delay_controller.reset(RenderDelayController::Create(config, sample_rate_hz,
                                                          num_capture_channels));
   }
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 
 namespace webrtc {
 
@@ -74,6 +75,16 @@ class BlockProcessor {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Writes the estimated delay and the state of the echo remover to `writer`.
+  virtual void GetState(StateWriter* writer) const = 0;
+
+  // Restores a state written by GetState(). The restored delay is used until
+  // the delay estimator reports a new delay.
+  virtual void SetState(StateReader* reader) = 0;
+
+  // Returns the size of the block processor, including its submodules.
+  virtual size_t MemoryUsage() const = 0;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/clockdrift_rate_estimator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Delay changes larger than this, in downsampled samples, between two
+// consecutive observations are treated as echo path changes rather than drift.
+constexpr int kMaxDelayStep = 2;
+
+// The delay is observed for at least this long before a rate is reported. The
+// rate is reported earlier than `kMaxObservationBlocks` only if the delay has
+// spanned `kMinDelaySpread` downsampled samples, since the delay estimate is
+// quantized.
+constexpr size_t kMinObservationBlocks = 10 * kNumBlocksPerSecond;
+constexpr size_t kMaxObservationBlocks = 60 * kNumBlocksPerSecond;
+constexpr int kMinDelaySpread = 3;
+
+}  // namespace
+
+ClockdriftRateEstimator::ClockdriftRateEstimator(size_t down_sampling_factor)
+    : rate_scaling_(static_cast<float>(down_sampling_factor) / kBlockSize) {
+  RTC_DCHECK_GT(down_sampling_factor, 0);
+}
+
+void ClockdriftRateEstimator::Reset() {
+  block_counter_ = 0;
+  first_block_ = 0;
+  last_delay_ = std::nullopt;
+  num_points_ = 0.0;
+  sum_t_ = 0.0;
+  sum_d_ = 0.0;
+  sum_tt_ = 0.0;
+  sum_td_ = 0.0;
+  rate_ = std::nullopt;
+}
+
+void ClockdriftRateEstimator::Update(std::optional<int> delay) {
+  ++block_counter_;
+  if (!delay) {
+    return;
+  }
+
+  if (last_delay_ && std::abs(*delay - *last_delay_) > kMaxDelayStep) {
+    Reset();
+    block_counter_ = 1;
+  }
+
+  if (num_points_ == 0.0) {
+    first_block_ = block_counter_;
+    min_delay_ = *delay;
+    max_delay_ = *delay;
+  }
+  last_delay_ = delay;
+  min_delay_ = std::min(min_delay_, *delay);
+  max_delay_ = std::max(max_delay_, *delay);
+
+  // Fit a line to the delay as a function of time, in blocks.
+  const size_t observation_blocks = block_counter_ - first_block_;
+  const double t = static_cast<double>(observation_blocks);
+  const double d = static_cast<double>(*delay);
+  num_points_ += 1.0;
+  sum_t_ += t;
+  sum_d_ += d;
+  sum_tt_ += t * t;
+  sum_td_ += t * d;
+
+  if (observation_blocks < kMinObservationBlocks ||
+      (max_delay_ - min_delay_ < kMinDelaySpread &&
+       observation_blocks < kMaxObservationBlocks)) {
+    return;
+  }
+
+  const double denominator = num_points_ * sum_tt_ - sum_t_ * sum_t_;
+  if (denominator > 0.0) {
+    const double slope =
+        (num_points_ * sum_td_ - sum_t_ * sum_d_) / denominator;
+    rate_ = static_cast<float>(slope) * rate_scaling_;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_CLOCKDRIFT_RATE_ESTIMATOR_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_CLOCKDRIFT_RATE_ESTIMATOR_H_
+
+#include <stddef.h>
+
+#include <optional>
+
+namespace webrtc {
+
+// Estimates the rate mismatch between the render and capture clocks as the
+// slope of the estimated delay over time. The rate is expressed as the change
+// of the delay, in samples, per capture sample. A positive rate means that the
+// echo arrives increasingly late relative to the render signal.
+class ClockdriftRateEstimator {
+ public:
+  explicit ClockdriftRateEstimator(size_t down_sampling_factor);
+
+  ClockdriftRateEstimator(const ClockdriftRateEstimator&) = delete;
+  ClockdriftRateEstimator& operator=(const ClockdriftRateEstimator&) = delete;
+
+  // Discards all observations.
+  void Reset();
+
+  // Called once per capture block with the delay, in downsampled samples, if a
+  // reliable delay is available for the block.
+  void Update(std::optional<int> delay);
+
+  // Returns the estimated rate once the delay has been observed for long
+  // enough.
+  std::optional<float> Rate() const { return rate_; }
+
+ private:
+  const float rate_scaling_;
+  size_t block_counter_ = 0;
+  size_t first_block_ = 0;
+  std::optional<int> last_delay_;
+  int min_delay_ = 0;
+  int max_delay_ = 0;
+  double num_points_ = 0.0;
+  double sum_t_ = 0.0;
+  double sum_d_ = 0.0;
+  double sum_tt_ = 0.0;
+  double sum_td_ = 0.0;
+  std::optional<float> rate_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_CLOCKDRIFT_RATE_ESTIMATOR_H_
@@ -13,7 +13,10 @@
 // Defines WEBRTC_ARCH_X86_FAMILY, used below.
 #include "rtc_base/system/arch.h"
 
-#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
 #include <emmintrin.h>
 #endif
 #include <algorithm>
@@ -48,11 +51,141 @@ constexpr float kSqrt2Sin[32] = {
     -1.3870398f, -1.3065630f, -1.1758756f, -1.0000000f, -0.7856950f,
     -0.5411961f, -0.2758994f};
 
+// Table of sqrt(2) * cos(2*pi*i/32) = sqrt(2) * sin(2*pi*(i + 8)/32).
+constexpr std::array<float, 32> kSqrt2Cos = [] {
+  std::array<float, 32> table = {};
+  for (int i = 0; i < 32; ++i) {
+    table[i] = kSqrt2Sin[(i + 8) & 31];
+  }
+  return table;
+}();
+
+// The random phases are drawn from the 31-bit linear congruential generator
+// x[n+1] = (69069 * x[n] + 1) mod 2^31. Splitting the sequence into
+// `kNumLanes` interleaved lanes, each advanced by `kNumLanes` steps at a time,
+// breaks the serial dependency between the draws while producing exactly the
+// same sequence. The SIMD implementations advance the lanes as two independent
+// vectors of four, which hides the latency of the multiplications.
+constexpr uint32_t kLcgMultiplier = 69069;
+constexpr uint32_t kLcgMask = 0x80000000 - 1;
+constexpr int kNumLanes = 8;
+
+// Returns the multiplier (first) and the increment (second) that advance the
+// generator by `kNumLanes` steps.
+constexpr std::array<uint32_t, 2> LcgLaneStep() {
+  uint32_t multiplier = 1;
+  uint32_t increment = 0;
+  for (int k = 0; k < kNumLanes; ++k) {
+    multiplier *= kLcgMultiplier;
+    increment = increment * kLcgMultiplier + 1;
+  }
+  return {multiplier, increment};
+}
+
+constexpr uint32_t kLcgLaneMultiplier = LcgLaneStep()[0];
+constexpr uint32_t kLcgLaneIncrement = LcgLaneStep()[1];
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+// Multiplies the 32-bit lanes of `a` and `b`, keeping the lower 32 bits of
+// the products, as SSE2 lacks a single instruction for this.
+inline __m128i MultiplyLanes(__m128i a, __m128i b) {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd =
+      _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+// Draws one random 5-bit phase index per element of `phase_indices`, and
+// leaves `seed` at the last drawn value of the generator.
+void GeneratePhaseIndices(Aec3Optimization optimization,
+                          uint32_t* seed,
+                          rtc::ArrayView<uint32_t> phase_indices) {
+  const size_t num_indices = phase_indices.size();
+  RTC_DCHECK_GT(num_indices, 0);
+
+  std::array<uint32_t, kNumLanes> lanes;
+  uint32_t x = *seed;
+  for (auto& lane : lanes) {
+    x = (x * kLcgMultiplier + 1) & kLcgMask;
+    lane = x;
+  }
+
+  // The lanes are advanced after each use, so the loop leaves between one and
+  // `kNumLanes` values in the lanes for the remaining indices.
+  size_t k = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+    case Aec3Optimization::kAvx2: {
+      const __m128i multiplier = _mm_set1_epi32(kLcgLaneMultiplier);
+      const __m128i increment = _mm_set1_epi32(kLcgLaneIncrement);
+      const __m128i mask = _mm_set1_epi32(kLcgMask);
+      __m128i x_lanes[2];
+      for (int v = 0; v < 2; ++v) {
+        x_lanes[v] = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&lanes[4 * v]));
+      }
+      for (; k + kNumLanes < num_indices; k += kNumLanes) {
+        for (int v = 0; v < 2; ++v) {
+          _mm_storeu_si128(
+              reinterpret_cast<__m128i*>(&phase_indices[k + 4 * v]),
+              _mm_srli_epi32(x_lanes[v], 26));
+          x_lanes[v] = _mm_and_si128(
+              _mm_add_epi32(MultiplyLanes(x_lanes[v], multiplier), increment),
+              mask);
+        }
+      }
+      for (int v = 0; v < 2; ++v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&lanes[4 * v]),
+                         x_lanes[v]);
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon: {
+      const uint32x4_t multiplier = vdupq_n_u32(kLcgLaneMultiplier);
+      const uint32x4_t increment = vdupq_n_u32(kLcgLaneIncrement);
+      const uint32x4_t mask = vdupq_n_u32(kLcgMask);
+      uint32x4_t x_lanes[2] = {vld1q_u32(&lanes[0]), vld1q_u32(&lanes[4])};
+      for (; k + kNumLanes < num_indices; k += kNumLanes) {
+        for (int v = 0; v < 2; ++v) {
+          vst1q_u32(&phase_indices[k + 4 * v], vshrq_n_u32(x_lanes[v], 26));
+          x_lanes[v] = vandq_u32(
+              vaddq_u32(vmulq_u32(x_lanes[v], multiplier), increment), mask);
+        }
+      }
+      vst1q_u32(&lanes[0], x_lanes[0]);
+      vst1q_u32(&lanes[4], x_lanes[1]);
+    } break;
+#endif
+    default:
+      for (; k + kNumLanes < num_indices; k += kNumLanes) {
+        for (int lane = 0; lane < kNumLanes; ++lane) {
+          phase_indices[k + lane] = lanes[lane] >> 26;
+          lanes[lane] =
+              (lanes[lane] * kLcgLaneMultiplier + kLcgLaneIncrement) &
+              kLcgMask;
+        }
+      }
+  }
+
+  const size_t num_remaining = num_indices - k;
+  RTC_DCHECK_GE(num_remaining, 1);
+  RTC_DCHECK_LE(num_remaining, kNumLanes);
+  for (size_t lane = 0; lane < num_remaining; ++lane) {
+    phase_indices[k + lane] = lanes[lane] >> 26;
+  }
+  *seed = lanes[num_remaining - 1];
+}
+
 void GenerateComfortNoise(Aec3Optimization optimization,
                           const std::array<float, kFftLengthBy2Plus1>& N2,
-                          uint32_t* seed,
+                          rtc::ArrayView<const uint32_t> phase_indices,
                           FftData* lower_band_noise,
                           FftData* upper_band_noise) {
+  RTC_DCHECK_EQ(phase_indices.size(), kFftLengthBy2 - 1);
   FftData* N_low = lower_band_noise;
   FftData* N_high = upper_band_noise;
 
@@ -75,17 +208,59 @@ void GenerateComfortNoise(Aec3Optimization optimization,
   // (strong correlation).
   N_low->re[0] = N_low->re[kFftLengthBy2] = N_high->re[0] =
       N_high->re[kFftLengthBy2] = 0.f;
-  for (size_t k = 1; k < kFftLengthBy2; k++) {
-    constexpr int kIndexMask = 32 - 1;
-    // Generate a random 31-bit integer.
-    seed[0] = (seed[0] * 69069 + 1) & (0x80000000 - 1);
-    // Convert to a 5-bit index.
-    int i = seed[0] >> 26;
-
-    // y = sqrt(2) * sin(a)
+
+  size_t k = 1;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+    case Aec3Optimization::kAvx2: {
+      const __m128 level = _mm_set1_ps(high_band_noise_level);
+      for (; k + 4 <= kFftLengthBy2; k += 4) {
+        const uint32_t* i = &phase_indices[k - 1];
+        const __m128 x = _mm_setr_ps(kSqrt2Sin[i[0]], kSqrt2Sin[i[1]],
+                                     kSqrt2Sin[i[2]], kSqrt2Sin[i[3]]);
+        const __m128 y = _mm_setr_ps(kSqrt2Cos[i[0]], kSqrt2Cos[i[1]],
+                                     kSqrt2Cos[i[2]], kSqrt2Cos[i[3]]);
+        const __m128 n = _mm_loadu_ps(&N[k]);
+        _mm_storeu_ps(&N_low->re[k], _mm_mul_ps(n, x));
+        _mm_storeu_ps(&N_low->im[k], _mm_mul_ps(n, y));
+        _mm_storeu_ps(&N_high->re[k], _mm_mul_ps(level, x));
+        _mm_storeu_ps(&N_high->im[k], _mm_mul_ps(level, y));
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon: {
+      const float32x4_t level = vdupq_n_f32(high_band_noise_level);
+      for (; k + 4 <= kFftLengthBy2; k += 4) {
+        const uint32_t* i = &phase_indices[k - 1];
+        float32x4_t x = vdupq_n_f32(kSqrt2Sin[i[0]]);
+        x = vsetq_lane_f32(kSqrt2Sin[i[1]], x, 1);
+        x = vsetq_lane_f32(kSqrt2Sin[i[2]], x, 2);
+        x = vsetq_lane_f32(kSqrt2Sin[i[3]], x, 3);
+        float32x4_t y = vdupq_n_f32(kSqrt2Cos[i[0]]);
+        y = vsetq_lane_f32(kSqrt2Cos[i[1]], y, 1);
+        y = vsetq_lane_f32(kSqrt2Cos[i[2]], y, 2);
+        y = vsetq_lane_f32(kSqrt2Cos[i[3]], y, 3);
+        const float32x4_t n = vld1q_f32(&N[k]);
+        vst1q_f32(&N_low->re[k], vmulq_f32(n, x));
+        vst1q_f32(&N_low->im[k], vmulq_f32(n, y));
+        vst1q_f32(&N_high->re[k], vmulq_f32(level, x));
+        vst1q_f32(&N_high->im[k], vmulq_f32(level, y));
+      }
+    } break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < kFftLengthBy2; k++) {
+    const uint32_t i = phase_indices[k - 1];
+
+    // x = sqrt(2) * sin(a)
     const float x = kSqrt2Sin[i];
-    // x = sqrt(2) * cos(a) = sqrt(2) * sin(a + pi/2)
-    const float y = kSqrt2Sin[(i + 8) & kIndexMask];
+    // y = sqrt(2) * cos(a) = sqrt(2) * sin(a + pi/2)
+    const float y = kSqrt2Cos[i];
 
     // Form low-frequency noise via spectral shaping.
     N_low->re[k] = N[k] * x;
@@ -110,7 +285,8 @@ ComfortNoiseGenerator::ComfortNoiseGenerator(const EchoCanceller3Config& config,
           std::make_unique<std::vector<std::array<float, kFftLengthBy2Plus1>>>(
               num_capture_channels_)),
       Y2_smoothed_(num_capture_channels_),
-      N2_(num_capture_channels_) {
+      N2_(num_capture_channels_),
+      phase_indices_(num_capture_channels_ * (kFftLengthBy2 - 1)) {
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     (*N2_initial_)[ch].fill(0.f);
     Y2_smoothed_[ch].fill(0.f);
@@ -177,9 +353,13 @@ void ComfortNoiseGenerator::Compute(
   // Choose N2 estimate to use.
   const auto& N2 = N2_initial_ ? (*N2_initial_) : N2_;
 
+  // The random phases for all channels are drawn in one go.
+  GeneratePhaseIndices(optimization_, &seed_, phase_indices_);
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    GenerateComfortNoise(optimization_, N2[ch], &seed_, &lower_band_noise[ch],
-                         &upper_band_noise[ch]);
+    rtc::ArrayView<const uint32_t> phase_indices(
+        &phase_indices_[ch * (kFftLengthBy2 - 1)], kFftLengthBy2 - 1);
+    GenerateComfortNoise(optimization_, N2[ch], phase_indices,
+                         &lower_band_noise[ch], &upper_band_noise[ch]);
   }
 }
 
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec_state.h"
 #include "modules/audio_processing/aec3/fft_data.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -60,6 +61,10 @@ class ComfortNoiseGenerator {
     return N2_;
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(Y2_smoothed_) + HeapBytes(phase_indices_);
+  }
+
  private:
   const Aec3Optimization optimization_;
   uint32_t seed_;
@@ -69,6 +74,8 @@ class ComfortNoiseGenerator {
       N2_initial_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> Y2_smoothed_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> N2_;
+  // Random phase indices for all channels of the current block.
+  std::vector<uint32_t> phase_indices_;
   int N2_counter_ = 0;
 };
 
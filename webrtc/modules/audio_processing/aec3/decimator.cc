@@ -50,21 +50,26 @@ const std::vector<CascadedBiQuadFilter::BiQuadParam> GetHighPassFilter() {
       {{1.f, 0.f}, {0.72712179f, 0.21296904f}, 0.7570763753338849f}};
 }
 
-const std::vector<CascadedBiQuadFilter::BiQuadParam> GetPassThroughFilter() {
-  return std::vector<CascadedBiQuadFilter::BiQuadParam>{};
+// Returns the anti-aliasing filter followed by the filter that reduces the
+// impact of near-end noise. Running them as one cascade lets four biquads be
+// processed together in CascadedBiQuadFilter.
+std::vector<CascadedBiQuadFilter::BiQuadParam> GetDecimationFilter(
+    size_t down_sampling_factor) {
+  if (down_sampling_factor == 8) {
+    return GetBandPassFilterDS8();
+  }
+  std::vector<CascadedBiQuadFilter::BiQuadParam> params =
+      down_sampling_factor == 4 ? GetLowPassFilterDS4() : GetLowPassFilterDS2();
+  const std::vector<CascadedBiQuadFilter::BiQuadParam> high_pass =
+      GetHighPassFilter();
+  params.insert(params.end(), high_pass.begin(), high_pass.end());
+  return params;
 }
 }  // namespace
 
 Decimator::Decimator(size_t down_sampling_factor)
     : down_sampling_factor_(down_sampling_factor),
-      anti_aliasing_filter_(down_sampling_factor_ == 4
-                                ? GetLowPassFilterDS4()
-                                : (down_sampling_factor_ == 8
-                                       ? GetBandPassFilterDS8()
-                                       : GetLowPassFilterDS2())),
-      noise_reduction_filter_(down_sampling_factor_ == 8
-                                  ? GetPassThroughFilter()
-                                  : GetHighPassFilter()) {
+      filter_(GetDecimationFilter(down_sampling_factor_)) {
   RTC_DCHECK(down_sampling_factor_ == 2 || down_sampling_factor_ == 4 ||
              down_sampling_factor_ == 8);
 }
@@ -75,11 +80,9 @@ void Decimator::Decimate(rtc::ArrayView<const float> in,
   RTC_DCHECK_EQ(kBlockSize / down_sampling_factor_, out.size());
   std::array<float, kBlockSize> x;
 
-  // Limit the frequency content of the signal to avoid aliasing.
-  anti_aliasing_filter_.Process(in, x);
-
-  // Reduce the impact of near-end noise.
-  noise_reduction_filter_.Process(x);
+  // Limit the frequency content of the signal to avoid aliasing and reduce the
+  // impact of near-end noise.
+  filter_.Process(in, x);
 
   // Downsample the signal.
   for (size_t j = 0, k = 0; j < out.size(); ++j, k += down_sampling_factor_) {
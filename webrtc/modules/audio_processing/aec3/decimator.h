@@ -17,6 +17,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -31,10 +32,11 @@ class Decimator {
   // Downsamples the signal.
   void Decimate(rtc::ArrayView<const float> in, rtc::ArrayView<float> out);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(filter_); }
+
  private:
   const size_t down_sampling_factor_;
-  CascadedBiQuadFilter anti_aliasing_filter_;
-  CascadedBiQuadFilter noise_reduction_filter_;
+  CascadedBiQuadFilter filter_;
 };
 }  // namespace webrtc
 
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -47,6 +48,8 @@ struct DownsampledRenderBuffer {
   void IncReadIndex() { read = IncIndex(read); }
   void DecReadIndex() { read = DecIndex(read); }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer); }
+
   const int size;
   std::vector<float> buffer;
   int write = 0;
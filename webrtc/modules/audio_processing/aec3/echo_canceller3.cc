@@ -9,15 +9,19 @@
  */
 #include "modules/audio_processing/aec3/echo_canceller3.h"
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <utility>
 
 #include "absl/strings/string_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/high_pass_filter.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
@@ -26,6 +30,11 @@ namespace {
 
 enum class EchoCanceller3ApiCall { kCapture, kRender };
 
+// Identifies the snapshots produced by EchoCanceller3::GetState() and the
+// version of their layout.
+constexpr uint32_t kStateMagic = 0x33434541;  // "AEC3" in little endian.
+constexpr uint32_t kStateVersion = 1;
+
 bool DetectSaturation(rtc::ArrayView<const float> y) {
   for (size_t k = 0; k < y.size(); ++k) {
     if (y[k] >= 32700.0f || y[k] <= -32700.0f) {
@@ -259,10 +268,38 @@ void CopyBufferIntoFrame(const AudioBuffer& buffer,
 EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config) {
   EchoCanceller3Config adjusted_cfg = config;
 
+  if (field_trial::IsEnabled("WebRTC-Aec3ClockdriftCompensation")) {
+    adjusted_cfg.delay.compensate_clockdrift = true;
+  }
+
   if (field_trial::IsEnabled("WebRTC-Aec3StereoContentDetectionKillSwitch")) {
     adjusted_cfg.multi_channel.detect_stereo_content = false;
   }
 
+  // Independent render references must never be downmixed. Their delays are
+  // estimated separately, which is not compatible with the clock drift
+  // compensation.
+  if (adjusted_cfg.multi_channel.independent_render_references) {
+    adjusted_cfg.multi_channel.detect_stereo_content = false;
+    adjusted_cfg.delay.compensate_clockdrift = false;
+  }
+
+  int pinned_delay_samples = -1;
+  RetrieveFieldTrialValue("WebRTC-Aec3PinnedDelayOverride", 0, 48000,
+                          &pinned_delay_samples);
+  if (pinned_delay_samples >= 0) {
+    adjusted_cfg.delay.use_pinned_delay = true;
+    adjusted_cfg.delay.pinned_delay_samples = pinned_delay_samples;
+  }
+
+  // A pinned delay is not estimated, so there is neither any clockdrift
+  // estimate to compensate for nor any per-reference delays to align.
+  if (adjusted_cfg.delay.use_pinned_delay &&
+      !adjusted_cfg.delay.use_external_delay_estimator) {
+    adjusted_cfg.delay.compensate_clockdrift = false;
+    adjusted_cfg.multi_channel.independent_render_references = false;
+  }
+
   if (field_trial::IsEnabled("WebRTC-Aec3AntiHowlingMinimizationKillSwitch")) {
     adjusted_cfg.suppressor.high_bands_suppression
         .anti_howling_activation_threshold = 25.f;
@@ -457,6 +494,22 @@ EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config) {
     adjusted_cfg.echo_model.model_reverb_in_nonlinear_mode = false;
   }
 
+  if (field_trial::IsEnabled("WebRTC-Aec3BypassOnRenderSilence")) {
+    adjusted_cfg.echo_removal_control.bypass_on_render_silence = true;
+  }
+
+  if (field_trial::IsEnabled("WebRTC-Aec3AdaptiveRefinedFilterLength")) {
+    adjusted_cfg.filter.adaptive_refined_length.enabled = true;
+  }
+
+  // With an adaptive refined filter length, the refined filter and everything
+  // sized after it must accommodate the longest allowed filter.
+  if (adjusted_cfg.filter.adaptive_refined_length.enabled) {
+    adjusted_cfg.filter.refined.length_blocks =
+        std::max(adjusted_cfg.filter.refined.length_blocks,
+                 adjusted_cfg.filter.adaptive_refined_length.max_length_blocks);
+  }
+
   // Field-trial based override for the whole suppressor tuning.
   const std::string suppressor_tuning_override_trial_name =
       field_trial::FindFullName("WebRTC-Aec3SuppressorTuningOverride");
@@ -658,6 +711,10 @@ class EchoCanceller3::RenderWriter {
 
   ~RenderWriter();
   void Insert(const AudioBuffer& input);
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(high_pass_filter_) +
+           HeapBytes(render_queue_input_frame_);
+  }
 
  private:
   ApmDataDumper* data_dumper_;
@@ -743,7 +800,7 @@ EchoCanceller3::EchoCanceller3(
       output_framer_(num_bands_, num_capture_channels_),
       capture_blocker_(num_bands_, num_capture_channels_),
       render_transfer_queue_(
-          kRenderTransferQueueSizeFrames,
+          config_.buffering.render_transfer_queue_size_frames,
           std::vector<std::vector<std::vector<float>>>(
               num_bands_,
               std::vector<std::vector<float>>(
@@ -932,6 +989,61 @@ bool EchoCanceller3::ActiveProcessing() const {
   return true;
 }
 
+std::vector<uint8_t> EchoCanceller3::GetState() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  std::vector<uint8_t> state;
+  StateWriter writer(&state);
+  writer.WriteUint32(kStateMagic);
+  writer.WriteUint32(kStateVersion);
+  writer.WriteUint32(sample_rate_hz_);
+  writer.WriteUint32(num_render_channels_to_aec_);
+  writer.WriteUint32(num_capture_channels_);
+  block_processor_->GetState(&writer);
+  return state;
+}
+
+bool EchoCanceller3::SetState(rtc::ArrayView<const uint8_t> state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  // The size of the state only depends on the configuration and the number of
+  // channels, which allows incompatible states to be rejected up front.
+  if (state.size() != GetState().size()) {
+    RTC_LOG(LS_WARNING) << "Rejecting AEC3 state of unexpected size "
+                        << state.size();
+    return false;
+  }
+
+  StateReader reader(state);
+  const uint32_t magic = reader.ReadUint32();
+  const uint32_t version = reader.ReadUint32();
+  const uint32_t sample_rate_hz = reader.ReadUint32();
+  const uint32_t num_render_channels = reader.ReadUint32();
+  const uint32_t num_capture_channels = reader.ReadUint32();
+  if (magic != kStateMagic || version != kStateVersion ||
+      sample_rate_hz != static_cast<uint32_t>(sample_rate_hz_) ||
+      num_render_channels != num_render_channels_to_aec_ ||
+      num_capture_channels != num_capture_channels_) {
+    RTC_LOG(LS_WARNING) << "Rejecting incompatible AEC3 state";
+    return false;
+  }
+
+  block_processor_->SetState(&reader);
+  RTC_DCHECK_EQ(0, reader.BytesLeft());
+  return true;
+}
+
+size_t EchoCanceller3::MemoryUsage() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  return sizeof(*this) + HeapBytes(render_writer_) +
+         HeapBytes(linear_output_framer_) + HeapBytes(output_framer_) +
+         HeapBytes(capture_blocker_) + HeapBytes(render_blocker_) +
+         HeapBytes(render_transfer_queue_) + HeapBytes(block_processor_) +
+         HeapBytes(render_queue_output_frame_) + HeapBytes(render_block_) +
+         HeapBytes(linear_output_block_) + HeapBytes(capture_block_) +
+         HeapBytes(render_sub_frame_view_) +
+         HeapBytes(linear_output_sub_frame_view_) +
+         HeapBytes(capture_sub_frame_view_) + HeapBytes(block_delay_buffer_);
+}
+
 EchoCanceller3Config EchoCanceller3::CreateDefaultMultichannelConfig() {
   EchoCanceller3Config cfg;
   // Use shorter and more rapidly adapting coarse filter to compensate for
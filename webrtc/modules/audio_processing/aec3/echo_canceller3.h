@@ -12,6 +12,7 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <atomic>
 #include <memory>
@@ -126,6 +127,14 @@ class EchoCanceller3 : public EchoControl {
 
   bool ActiveProcessing() const override;
 
+  // Returns a snapshot of the delay, the adaptive filters and the ERL and ERLE
+  // estimates. The snapshot can only be restored into an EchoCanceller3 with
+  // the same configuration, sample rate and number of channels.
+  std::vector<uint8_t> GetState() const override;
+  bool SetState(rtc::ArrayView<const uint8_t> state) override;
+
+  size_t MemoryUsage() const override;
+
   // Signals whether an external detector has detected echo leakage from the
   // echo canceller.
   // Note that in the case echo leakage has been flagged, it should be unflagged
@@ -16,8 +16,48 @@
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 
 namespace webrtc {
+namespace {
+
+float ExcitationLimit(const EchoCanceller3Config& config) {
+  return config.delay.down_sampling_factor == 8
+             ? config.render_levels.poor_excitation_render_limit_ds8
+             : config.render_levels.poor_excitation_render_limit;
+}
+
+std::unique_ptr<MatchedFilter> CreateMatchedFilter(
+    ApmDataDumper* data_dumper,
+    const EchoCanceller3Config& config,
+    size_t sub_block_size) {
+  if (config.delay.use_fft_matched_filter) {
+    return nullptr;
+  }
+  return std::make_unique<MatchedFilter>(
+      data_dumper, DetectOptimization(), sub_block_size,
+      kMatchedFilterWindowSizeSubBlocks, config.delay.num_filters,
+      kMatchedFilterAlignmentShiftSizeSubBlocks, ExcitationLimit(config),
+      config.delay.delay_estimate_smoothing,
+      config.delay.delay_estimate_smoothing_delay_found,
+      config.delay.delay_candidate_detection_threshold,
+      config.delay.detect_pre_echo);
+}
+
+std::unique_ptr<FftMatchedFilter> CreateFftMatchedFilter(
+    ApmDataDumper* data_dumper,
+    const EchoCanceller3Config& config,
+    size_t sub_block_size) {
+  if (!config.delay.use_fft_matched_filter) {
+    return nullptr;
+  }
+  return std::make_unique<FftMatchedFilter>(
+      data_dumper, sub_block_size, kMatchedFilterWindowSizeSubBlocks,
+      config.delay.num_filters, kMatchedFilterAlignmentShiftSizeSubBlocks,
+      kFftMatchedFilterHopSizeSubBlocks, ExcitationLimit(config));
+}
+
+}  // namespace
 
 EchoPathDelayEstimator::EchoPathDelayEstimator(
     ApmDataDumper* data_dumper,
@@ -32,24 +72,18 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
                      config.delay.capture_alignment_mixing),
       capture_decimator_(down_sampling_factor_),
       matched_filter_(
+          CreateMatchedFilter(data_dumper_, config, sub_block_size_)),
+      fft_matched_filter_(
+          CreateFftMatchedFilter(data_dumper_, config, sub_block_size_)),
+      matched_filter_lag_aggregator_(
           data_dumper_,
-          DetectOptimization(),
-          sub_block_size_,
-          kMatchedFilterWindowSizeSubBlocks,
-          config.delay.num_filters,
-          kMatchedFilterAlignmentShiftSizeSubBlocks,
-          config.delay.down_sampling_factor == 8
-              ? config.render_levels.poor_excitation_render_limit_ds8
-              : config.render_levels.poor_excitation_render_limit,
-          config.delay.delay_estimate_smoothing,
-          config.delay.delay_estimate_smoothing_delay_found,
-          config.delay.delay_candidate_detection_threshold,
-          config.delay.detect_pre_echo),
-      matched_filter_lag_aggregator_(data_dumper_,
-                                     matched_filter_.GetMaxFilterLag(),
-                                     config.delay) {
+          fft_matched_filter_ ? fft_matched_filter_->GetMaxFilterLag()
+                              : matched_filter_->GetMaxFilterLag(),
+          config.delay),
+      clockdrift_rate_estimator_(down_sampling_factor_) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK(down_sampling_factor_ > 0);
+  RTC_DCHECK_NE(!matched_filter_, !fft_matched_filter_);
 }
 
 EchoPathDelayEstimator::~EchoPathDelayEstimator() = default;
@@ -58,6 +92,18 @@ void EchoPathDelayEstimator::Reset(bool reset_delay_confidence) {
   Reset(true, reset_delay_confidence);
 }
 
+void EchoPathDelayEstimator::LogDelayEstimationProperties(int sample_rate_hz,
+                                                          size_t shift) const {
+  if (matched_filter_) {
+    matched_filter_->LogFilterProperties(sample_rate_hz, shift,
+                                         down_sampling_factor_);
+    return;
+  }
+  RTC_LOG(LS_VERBOSE) << "FFT matched filter: "
+                      << fft_matched_filter_->NumLags() << " lags, FFT size "
+                      << fft_matched_filter_->FftSize();
+}
+
 std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
     const DownsampledRenderBuffer& render_buffer,
     const Block& capture) {
@@ -71,19 +117,30 @@ std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
-  matched_filter_.Update(render_buffer, downsampled_capture,
-                         matched_filter_lag_aggregator_.ReliableDelayFound());
-
-  std::optional<DelayEstimate> aggregated_matched_filter_lag =
-      matched_filter_lag_aggregator_.Aggregate(
-          matched_filter_.GetBestLagEstimate());
+  std::optional<DelayEstimate> aggregated_matched_filter_lag;
+  if (fft_matched_filter_) {
+    fft_matched_filter_->Update(render_buffer, downsampled_capture);
+    aggregated_matched_filter_lag = matched_filter_lag_aggregator_.Aggregate(
+        fft_matched_filter_->GetBestLagEstimate());
+  } else {
+    matched_filter_->Update(
+        render_buffer, downsampled_capture,
+        matched_filter_lag_aggregator_.ReliableDelayFound());
+    aggregated_matched_filter_lag = matched_filter_lag_aggregator_.Aggregate(
+        matched_filter_->GetBestLagEstimate());
+  }
 
   // Run clockdrift detection.
   if (aggregated_matched_filter_lag &&
       (*aggregated_matched_filter_lag).quality ==
-          DelayEstimate::Quality::kRefined)
+          DelayEstimate::Quality::kRefined) {
     clockdrift_detector_.Update(
         matched_filter_lag_aggregator_.GetDelayAtHighestPeak());
+    clockdrift_rate_estimator_.Update(
+        matched_filter_lag_aggregator_.GetDelayAtHighestPeak());
+  } else {
+    clockdrift_rate_estimator_.Update(std::nullopt);
+  }
 
   // TODO(peah): Move this logging outside of this class once EchoCanceller3
   // development is done.
@@ -119,8 +176,13 @@ void EchoPathDelayEstimator::Reset(bool reset_lag_aggregator,
                                    bool reset_delay_confidence) {
   if (reset_lag_aggregator) {
     matched_filter_lag_aggregator_.Reset(reset_delay_confidence);
+    clockdrift_rate_estimator_.Reset();
+  }
+  if (fft_matched_filter_) {
+    fft_matched_filter_->Reset(/*full_reset=*/reset_lag_aggregator);
+  } else {
+    matched_filter_->Reset(/*full_reset=*/reset_lag_aggregator);
   }
-  matched_filter_.Reset(/*full_reset=*/reset_lag_aggregator);
   old_aggregated_lag_ = std::nullopt;
   consistent_estimate_counter_ = 0;
 }
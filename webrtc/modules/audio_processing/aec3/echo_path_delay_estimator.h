@@ -13,16 +13,20 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <optional>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/alignment_mixer.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/clockdrift_detector.h"
+#include "modules/audio_processing/aec3/clockdrift_rate_estimator.h"
 #include "modules/audio_processing/aec3/decimator.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/fft_matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter_lag_aggregator.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -51,27 +55,43 @@ class EchoPathDelayEstimator {
       const Block& capture);
 
   // Log delay estimator properties.
-  void LogDelayEstimationProperties(int sample_rate_hz, size_t shift) const {
-    matched_filter_.LogFilterProperties(sample_rate_hz, shift,
-                                        down_sampling_factor_);
-  }
+  void LogDelayEstimationProperties(int sample_rate_hz, size_t shift) const;
 
   // Returns the level of detected clockdrift.
   ClockdriftDetector::Level Clockdrift() const {
     return clockdrift_detector_.ClockdriftLevel();
   }
 
+  // Returns the estimated clockdrift rate, if available.
+  std::optional<float> ClockdriftRate() const {
+    return clockdrift_rate_estimator_.Rate();
+  }
+
+  // Restarts the estimation of the clockdrift rate.
+  void ResetClockdriftRate() { clockdrift_rate_estimator_.Reset(); }
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(capture_mixer_) +
+           HeapBytes(capture_decimator_) + HeapBytes(matched_filter_) +
+           HeapBytes(fft_matched_filter_) +
+           HeapBytes(matched_filter_lag_aggregator_);
+  }
+
  private:
   ApmDataDumper* const data_dumper_;
   const size_t down_sampling_factor_;
   const size_t sub_block_size_;
   AlignmentMixer capture_mixer_;
   Decimator capture_decimator_;
-  MatchedFilter matched_filter_;
+  // Exactly one of the matched filters is created, depending on
+  // `EchoCanceller3Config::Delay::use_fft_matched_filter`.
+  const std::unique_ptr<MatchedFilter> matched_filter_;
+  const std::unique_ptr<FftMatchedFilter> fft_matched_filter_;
   MatchedFilterLagAggregator matched_filter_lag_aggregator_;
   std::optional<DelayEstimate> old_aggregated_lag_;
   size_t consistent_estimate_counter_ = 0;
   ClockdriftDetector clockdrift_detector_;
+  ClockdriftRateEstimator clockdrift_rate_estimator_;
 
   // Internal reset method with more granularity.
   void Reset(bool reset_lag_aggregator, bool reset_delay_confidence);
@@ -17,6 +17,8 @@
 #include <atomic>
 #include <cmath>
 #include <memory>
+#include <numeric>
+#include <optional>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
@@ -36,6 +38,7 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -135,6 +138,29 @@ class EchoRemoverImpl final : public EchoRemover {
     capture_output_used_ = capture_output_used;
   }
 
+  void GetState(StateWriter* writer) const override {
+    subtractor_.GetState(writer);
+    aec_state_.GetState(writer);
+  }
+
+  void SetState(StateReader* reader) override {
+    subtractor_.SetState(reader);
+    aec_state_.SetState(reader);
+  }
+
+  size_t MemoryUsage() const override {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(subtractor_) +
+           HeapBytes(suppression_gain_) + HeapBytes(cng_) +
+           HeapBytes(suppression_filter_) + HeapBytes(aec_state_) +
+           HeapBytes(e_old_) + HeapBytes(y_old_) + HeapBytes(e_heap_) +
+           HeapBytes(Y2_heap_) + HeapBytes(E2_heap_) + HeapBytes(R2_heap_) +
+           HeapBytes(R2_unbounded_heap_) + HeapBytes(S2_linear_heap_) +
+           HeapBytes(Y_heap_) + HeapBytes(E_heap_) +
+           HeapBytes(comfort_noise_heap_) +
+           HeapBytes(high_band_comfort_noise_heap_) +
+           HeapBytes(subtractor_output_heap_);
+  }
+
  private:
   // Selects which of the coarse and refined linear filter outputs that is most
   // appropriate to pass to the suppressor and forms the linear filter output by
@@ -142,6 +168,11 @@ class EchoRemoverImpl final : public EchoRemover {
   void FormLinearFilterOutput(const SubtractorOutput& subtractor_output,
                               rtc::ArrayView<float> output);
 
+  // Updates the count of consecutive blocks for which the render signal is
+  // silent and returns whether the filters and the suppressor can be
+  // bypassed.
+  bool UpdateRenderSilence(const RenderBuffer& render_buffer);
+
   static std::atomic<int> instance_count_;
   const EchoCanceller3Config config_;
   const Aec3Fft fft_;
@@ -166,6 +197,11 @@ class EchoRemoverImpl final : public EchoRemover {
   size_t block_counter_ = 0;
   int gain_change_hangover_ = 0;
   bool refined_filter_output_last_selected_ = true;
+  const bool bypass_on_render_silence_;
+  const size_t render_silence_blocks_before_bypass_;
+  size_t num_silent_render_blocks_ = 0;
+  bool echo_tail_decayed_ = false;
+  bool bypassed_last_block_ = false;
 
   std::vector<std::array<float, kFftLengthBy2>> e_heap_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> Y2_heap_;
@@ -213,6 +249,13 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
       aec_state_(config_, num_capture_channels_),
       e_old_(num_capture_channels_, {0.f}),
       y_old_(num_capture_channels_, {0.f}),
+      bypass_on_render_silence_(
+          config_.echo_removal_control.bypass_on_render_silence),
+      render_silence_blocks_before_bypass_(
+          std::max({config_.filter.refined.length_blocks,
+                    config_.filter.refined_initial.length_blocks,
+                    config_.filter.coarse.length_blocks,
+                    config_.filter.coarse_initial.length_blocks})),
       e_heap_(NumChannelsOnHeap(num_capture_channels_), {0.f}),
       Y2_heap_(NumChannelsOnHeap(num_capture_channels_)),
       E2_heap_(NumChannelsOnHeap(num_capture_channels_)),
@@ -248,7 +291,7 @@ void EchoRemoverImpl::ProcessCapture(
   Block* y = capture;
   RTC_DCHECK(render_buffer);
   RTC_DCHECK(y);
-  RTC_DCHECK_EQ(x.NumBands(), NumBandsForRate(sample_rate_hz_));
+  RTC_DCHECK_EQ(x.NumBands(), 1);
   RTC_DCHECK_EQ(y->NumBands(), NumBandsForRate(sample_rate_hz_));
   RTC_DCHECK_EQ(x.NumChannels(), num_render_channels_);
   RTC_DCHECK_EQ(y->NumChannels(), num_capture_channels_);
@@ -346,6 +389,10 @@ void EchoRemoverImpl::ProcessCapture(
     subtractor_.HandleEchoPathChange(echo_path_variability);
     aec_state_.HandleEchoPathChange(echo_path_variability);
 
+    // The realignment may bring active render into the filters.
+    num_silent_render_blocks_ = 0;
+    echo_tail_decayed_ = false;
+
     if (echo_path_variability.delay_change !=
         EchoPathVariability::DelayAdjustment::kNone) {
       suppression_gain_.SetInitialState(true);
@@ -365,19 +412,35 @@ void EchoRemoverImpl::ProcessCapture(
     suppression_gain_.SetInitialState(false);
   }
 
-  // Perform linear echo cancellation.
-  subtractor_.Process(*render_buffer, *y, render_signal_analyzer_, aec_state_,
-                      subtractor_output);
+  // Perform linear echo cancellation, unless there is no render signal in the
+  // filters for which the echo can be estimated.
+  const bool bypass = UpdateRenderSilence(*render_buffer);
+  if (bypass) {
+    subtractor_.Bypass(*y, subtractor_output);
+  } else {
+    subtractor_.Process(*render_buffer, *y, render_signal_analyzer_,
+                        aec_state_, subtractor_output);
+  }
 
   // Compute spectra.
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     FormLinearFilterOutput(subtractor_output[ch], e[ch]);
     WindowedPaddedFft(fft_, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
-    WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
-    LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
     Y[ch].Spectrum(optimization_, Y2[ch]);
-    E[ch].Spectrum(optimization_, E2[ch]);
+    if (bypass && bypassed_last_block_) {
+      // The linear filter output is the capture signal, also in the previous
+      // block, so that its spectrum is that of the capture signal.
+      std::copy(e[ch].begin(), e[ch].end(), e_old_[ch].begin());
+      E[ch] = Y[ch];
+      E2[ch] = Y2[ch];
+      S2_linear[ch].fill(0.f);
+    } else {
+      WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
+      LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
+      E[ch].Spectrum(optimization_, E2[ch]);
+    }
   }
+  bypassed_last_block_ = bypass;
 
   // Optionally return the linear filter output.
   if (linear_output) {
@@ -394,6 +457,13 @@ void EchoRemoverImpl::ProcessCapture(
                     subtractor_.FilterImpulseResponses(), *render_buffer, E2,
                     Y2, subtractor_output);
 
+  // Let the refined filter length follow the measured echo tail.
+  const std::optional<int> tail_length_blocks =
+      aec_state_.FilterTailLengthBlocks();
+  if (tail_length_blocks) {
+    subtractor_.UpdateRefinedFilterSize(*tail_length_blocks);
+  }
+
   // Choose the linear output.
   const auto& Y_fft = aec_state_.UseLinearFilterOutput() ? E : Y;
 
@@ -408,7 +478,16 @@ void EchoRemoverImpl::ProcessCapture(
   // Only do the below processing if the output of the audio processing module
   // is used.
   std::array<float, kFftLengthBy2Plus1> G;
-  if (capture_output_used_) {
+  if (capture_output_used_ && bypass) {
+    // Without any echo, the suppressor gain is unity.
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      R2[ch].fill(0.f);
+      R2_unbounded[ch].fill(0.f);
+    }
+    G.fill(1.f);
+    suppression_filter_.ApplyGain(comfort_noise, high_band_comfort_noise, G,
+                                  /*high_bands_gain=*/1.f, Y_fft, y);
+  } else if (capture_output_used_) {
     // Estimate the residual echo power.
     residual_echo_estimator_.Estimate(aec_state_, *render_buffer, S2_linear, Y2,
                                       suppression_gain_.IsDominantNearend(), R2,
@@ -437,13 +516,22 @@ void EchoRemoverImpl::ProcessCapture(
     float high_bands_gain;
     suppression_gain_.GetGain(nearend_spectrum, echo_spectrum, R2, R2_unbounded,
                               cng_.NoiseSpectrum(), render_signal_analyzer_,
-                              aec_state_, x, clock_drift, &high_bands_gain, &G);
+                              aec_state_, x,
+                              render_buffer->GetUpperBandsLevels(0),
+                              clock_drift, &high_bands_gain, &G);
 
     suppression_filter_.ApplyGain(comfort_noise, high_band_comfort_noise, G,
                                   high_bands_gain, Y_fft, y);
 
+    // The echo tail is considered to have decayed once the suppressor no
+    // longer attenuates the capture signal.
+    constexpr float kTransparentGain = 0.99f;
+    echo_tail_decayed_ =
+        high_bands_gain >= kTransparentGain &&
+        *std::min_element(G.begin(), G.end()) >= kTransparentGain;
   } else {
     G.fill(0.f);
+    echo_tail_decayed_ = false;
   }
 
   // Update the metrics.
@@ -474,6 +562,38 @@ void EchoRemoverImpl::ProcessCapture(
                         aec_state_.SaturatedCapture() ? 1 : 0);
 }
 
+bool EchoRemoverImpl::UpdateRenderSilence(const RenderBuffer& render_buffer) {
+  if (!bypass_on_render_silence_) {
+    return false;
+  }
+
+  const Block& x = render_buffer.GetBlock(0);
+  const float active_render_threshold =
+      config_.render_levels.active_render_limit *
+      config_.render_levels.active_render_limit * kBlockSize;
+  bool silent_render = true;
+  for (int ch = 0; ch < x.NumChannels() && silent_render; ++ch) {
+    rtc::ArrayView<const float, kBlockSize> x_ch = x.View(/*band=*/0, ch);
+    const float render_energy =
+        std::inner_product(x_ch.begin(), x_ch.end(), x_ch.begin(), 0.f);
+    silent_render = render_energy <= active_render_threshold;
+  }
+
+  if (!silent_render) {
+    num_silent_render_blocks_ = 0;
+    echo_tail_decayed_ = false;
+    return false;
+  }
+  num_silent_render_blocks_ =
+      std::min(num_silent_render_blocks_ + 1,
+               render_silence_blocks_before_bypass_);
+
+  // Only bypass once the render signal has been silent for the whole length of
+  // the filters and the suppressor has stopped removing the echo tail.
+  return num_silent_render_blocks_ >= render_silence_blocks_before_bypass_ &&
+         echo_tail_decayed_;
+}
+
 void EchoRemoverImpl::FormLinearFilterOutput(
     const SubtractorOutput& subtractor_output,
     rtc::ArrayView<float> output) {
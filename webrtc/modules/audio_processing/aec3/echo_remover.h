@@ -20,6 +20,7 @@
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 
 namespace webrtc {
 
@@ -55,6 +56,15 @@ class EchoRemover {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Writes the adapted state of the echo remover to `writer`.
+  virtual void GetState(StateWriter* writer) const = 0;
+
+  // Restores a state written by GetState().
+  virtual void SetState(StateReader* reader) = 0;
+
+  // Returns the size of the echo remover, including its linear filters.
+  virtual size_t MemoryUsage() const = 0;
 };
 
 }  // namespace webrtc
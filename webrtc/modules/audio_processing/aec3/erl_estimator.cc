@@ -38,6 +38,16 @@ void ErlEstimator::Reset() {
   blocks_since_reset_ = 0;
 }
 
+void ErlEstimator::GetState(StateWriter* writer) const {
+  writer->WriteFloats(erl_);
+  writer->WriteFloat(erl_time_domain_);
+}
+
+void ErlEstimator::SetState(StateReader* reader) {
+  reader->ReadFloats(erl_);
+  erl_time_domain_ = reader->ReadFloat();
+}
+
 void ErlEstimator::Update(
     const std::vector<bool>& converged_filters,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> render_spectra,
@@ -18,6 +18,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 
 namespace webrtc {
 
@@ -44,6 +45,12 @@ class ErlEstimator {
   const std::array<float, kFftLengthBy2Plus1>& Erl() const { return erl_; }
   float ErlTimeDomain() const { return erl_time_domain_; }
 
+  // Writes the ERL estimates to `writer`.
+  void GetState(StateWriter* writer) const;
+
+  // Restores the ERL estimates written by GetState().
+  void SetState(StateReader* reader);
+
  private:
   const size_t startup_phase_length_blocks__;
   std::array<float, kFftLengthBy2Plus1> erl_;
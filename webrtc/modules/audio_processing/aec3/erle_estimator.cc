@@ -42,6 +42,16 @@ void ErleEstimator::Reset(bool delay_change) {
   }
 }
 
+void ErleEstimator::GetState(StateWriter* writer) const {
+  fullband_erle_estimator_.GetState(writer);
+  subband_erle_estimator_.GetState(writer);
+}
+
+void ErleEstimator::SetState(StateReader* reader) {
+  fullband_erle_estimator_.SetState(reader);
+  subband_erle_estimator_.SetState(reader);
+}
+
 void ErleEstimator::Update(
     const RenderBuffer& render_buffer,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -24,8 +24,10 @@
 #include "modules/audio_processing/aec3/fullband_erle_estimator.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/signal_dependent_erle_estimator.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/aec3/subband_erle_estimator.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -96,8 +98,20 @@ class ErleEstimator {
     return fullband_erle_estimator_.GetInstLinearQualityEstimates();
   }
 
+  // Writes the fullband and subband ERLE estimates to `writer`. The signal
+  // dependent ERLE is not included as it is derived from the subband ERLE.
+  void GetState(StateWriter* writer) const;
+
+  // Restores the ERLE estimates written by GetState().
+  void SetState(StateReader* reader);
+
   void Dump(const std::unique_ptr<ApmDataDumper>& data_dumper) const;
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(subband_erle_estimator_) +
+           HeapBytes(signal_dependent_erle_estimator_);
+  }
+
  private:
   const size_t startup_phase_length_blocks_;
   FullBandErleEstimator fullband_erle_estimator_;
@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/fft_matched_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Weight of the newest hop in the recursively smoothed spectra.
+constexpr float kSpectrumSmoothing = 0.3f;
+// Required ratio between the squared correlation peak and the average squared
+// correlation over all lags for the peak to be considered reliable.
+constexpr float kPeakToAverageThreshold = 40.f;
+constexpr float kSaturationLimit = 32000.f;
+
+size_t ComputeFftSize(size_t min_size) {
+  size_t fft_size = 32;
+  while (fft_size < min_size) {
+    fft_size *= 2;
+  }
+  return fft_size;
+}
+
+}  // namespace
+
+FftMatchedFilter::FftMatchedFilter(ApmDataDumper* data_dumper,
+                                   size_t sub_block_size,
+                                   size_t window_size_sub_blocks,
+                                   int num_matched_filters,
+                                   size_t alignment_shift_sub_blocks,
+                                   size_t hop_size_sub_blocks,
+                                   float excitation_limit)
+    : data_dumper_(data_dumper),
+      sub_block_size_(sub_block_size),
+      max_filter_lag_((num_matched_filters * alignment_shift_sub_blocks +
+                       window_size_sub_blocks) *
+                      sub_block_size),
+      num_lags_(((num_matched_filters - 1) * alignment_shift_sub_blocks +
+                 window_size_sub_blocks) *
+                sub_block_size),
+      hop_size_(hop_size_sub_blocks * sub_block_size),
+      excitation_limit_(excitation_limit),
+      fft_(RealFft::Create(ComputeFftSize(num_lags_ + hop_size_),
+                           RealFft::Backend::kPffft)),
+      render_(hop_size_ + num_lags_, 0.f),
+      capture_(hop_size_, 0.f),
+      render_fft_(fft_->fft_size(), 0.f),
+      capture_fft_(fft_->fft_size(), 0.f),
+      correlation_(fft_->fft_size(), 0.f),
+      cross_spectrum_(fft_->fft_size(), 0.f),
+      render_spectrum_(fft_->fft_size() / 2 + 1, 0.f),
+      capture_spectrum_(fft_->fft_size() / 2 + 1, 0.f) {
+  RTC_DCHECK(data_dumper);
+  RTC_DCHECK_LT(0, num_matched_filters);
+  RTC_DCHECK_LT(0, hop_size_sub_blocks);
+}
+
+FftMatchedFilter::~FftMatchedFilter() = default;
+
+void FftMatchedFilter::Reset(bool full_reset) {
+  reported_lag_estimate_ = std::nullopt;
+  if (full_reset) {
+    std::fill(cross_spectrum_.begin(), cross_spectrum_.end(), 0.f);
+    std::fill(render_spectrum_.begin(), render_spectrum_.end(), 0.f);
+    std::fill(capture_spectrum_.begin(), capture_spectrum_.end(), 0.f);
+    spectra_initialized_ = false;
+    std::fill(render_.begin(), render_.end(), 0.f);
+    capture_fill_ = 0;
+    capture_saturated_ = false;
+  }
+}
+
+void FftMatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
+                              rtc::ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  RTC_DCHECK_LE(capture_fill_ + capture.size(), capture_.size());
+  for (float y : capture) {
+    capture_saturated_ = capture_saturated_ || y >= kSaturationLimit ||
+                         y <= -kSaturationLimit;
+  }
+  std::copy(capture.begin(), capture.end(), capture_.begin() + capture_fill_);
+  capture_fill_ += capture.size();
+  if (capture_fill_ < capture_.size()) {
+    return;
+  }
+
+  // The render buffer is stored in reverse time order, with the sample at lag
+  // zero for the newest capture sample at the read index. Samples that are
+  // older than what the render buffer holds are kept from the previous hop.
+  const size_t total_size = render_.size();
+  const size_t num_fresh = std::min(render_buffer.buffer.size(), total_size);
+  RTC_DCHECK_GE(num_fresh, hop_size_);
+  const size_t num_kept = total_size - num_fresh;
+  std::copy(render_.begin() + hop_size_,
+            render_.begin() + hop_size_ + num_kept, render_.begin());
+  size_t x_index = render_buffer.read;
+  for (size_t t = total_size; t > num_kept; --t) {
+    render_[t - 1] = render_buffer.buffer[x_index];
+    x_index = x_index < render_buffer.buffer.size() - 1 ? x_index + 1 : 0;
+  }
+
+  Correlate();
+  capture_fill_ = 0;
+  capture_saturated_ = false;
+}
+
+void FftMatchedFilter::Correlate() {
+  float x2_sum = 0.f;
+  for (float x : render_) {
+    x2_sum += x * x;
+  }
+  if (capture_saturated_ ||
+      x2_sum <= render_.size() * excitation_limit_ * excitation_limit_) {
+    reported_lag_estimate_ = std::nullopt;
+    return;
+  }
+
+  std::copy(render_.begin(), render_.end(), render_fft_.begin());
+  std::fill(render_fft_.begin() + render_.size(), render_fft_.end(), 0.f);
+  std::copy(capture_.begin(), capture_.end(), capture_fft_.begin());
+  std::fill(capture_fft_.begin() + capture_.size(), capture_fft_.end(), 0.f);
+  fft_->Forward(render_fft_);
+  fft_->Forward(capture_fft_);
+
+  // Update the smoothed spectra. The DC and Nyquist bins are real valued and
+  // stored in the first two elements.
+  const float a = spectra_initialized_ ? kSpectrumSmoothing : 1.f;
+  spectra_initialized_ = true;
+  const size_t num_bins = render_spectrum_.size();
+  auto update_real_bin = [&](size_t index, size_t bin) {
+    const float r = render_fft_[index];
+    const float y = capture_fft_[index];
+    cross_spectrum_[index] += a * (r * y - cross_spectrum_[index]);
+    render_spectrum_[bin] += a * (r * r - render_spectrum_[bin]);
+    capture_spectrum_[bin] += a * (y * y - capture_spectrum_[bin]);
+  };
+  update_real_bin(0, 0);
+  update_real_bin(1, num_bins - 1);
+  for (size_t k = 1; k < num_bins - 1; ++k) {
+    const float r_re = render_fft_[2 * k];
+    const float r_im = render_fft_[2 * k + 1];
+    const float y_re = capture_fft_[2 * k];
+    const float y_im = capture_fft_[2 * k + 1];
+    const float c_re = r_re * y_re + r_im * y_im;
+    const float c_im = r_im * y_re - r_re * y_im;
+    cross_spectrum_[2 * k] += a * (c_re - cross_spectrum_[2 * k]);
+    cross_spectrum_[2 * k + 1] += a * (c_im - cross_spectrum_[2 * k + 1]);
+    render_spectrum_[k] +=
+        a * (r_re * r_re + r_im * r_im - render_spectrum_[k]);
+    capture_spectrum_[k] +=
+        a * (y_re * y_re + y_im * y_im - capture_spectrum_[k]);
+  }
+
+  // Normalize the cross-spectrum by the geometric mean of the auto-spectra
+  // to whiten the correlation.
+  auto weight = [&](size_t bin) {
+    return 1.f /
+           std::sqrt(render_spectrum_[bin] * capture_spectrum_[bin] + 1.f);
+  };
+  correlation_[0] = cross_spectrum_[0] * weight(0);
+  correlation_[1] = cross_spectrum_[1] * weight(num_bins - 1);
+  for (size_t k = 1; k < num_bins - 1; ++k) {
+    const float w = weight(k);
+    correlation_[2 * k] = cross_spectrum_[2 * k] * w;
+    correlation_[2 * k + 1] = cross_spectrum_[2 * k + 1] * w;
+  }
+  fft_->Inverse(correlation_);
+
+  // The correlation at index m corresponds to the lag num_lags_ - m.
+  float peak = 0.f;
+  float sum = 0.f;
+  size_t peak_index = 1;
+  for (size_t m = 1; m <= num_lags_; ++m) {
+    const float c2 = correlation_[m] * correlation_[m];
+    sum += c2;
+    if (c2 > peak) {
+      peak = c2;
+      peak_index = m;
+    }
+  }
+
+  const size_t lag = num_lags_ - peak_index;
+  data_dumper_->DumpRaw("aec3_fft_matched_filter_lag", lag);
+  if (peak > kPeakToAverageThreshold * sum / num_lags_) {
+    reported_lag_estimate_ =
+        MatchedFilter::LagEstimate(lag, /*pre_echo_lag=*/lag);
+  } else {
+    reported_lag_estimate_ = std::nullopt;
+  }
+}
+
+}  // namespace webrtc
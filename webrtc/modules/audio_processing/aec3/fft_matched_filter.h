@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "modules/audio_processing/utility/real_fft.h"
+#include "rtc_base/memory/heap_bytes.h"
+
+namespace webrtc {
+
+class ApmDataDumper;
+struct DownsampledRenderBuffer;
+
+// Frequency-domain alternative to MatchedFilter. Instead of adapting one
+// time-domain filter per lag range, the capture signal is cross-correlated
+// with the whole render history using FFTs once every hop of
+// `hop_size_sub_blocks` sub-blocks. The cross-spectrum is smoothed over time
+// and normalized by the render and capture spectra (SCOT weighting) before
+// the lag is picked as the peak of the resulting correlation. The cost per
+// sub-block is O(N log N / hop) for an FFT size N covering the lag range,
+// which makes delay searches over several seconds affordable.
+//
+// The lags are produced in the same coordinates as those of MatchedFilter, so
+// that the estimates can be aggregated by MatchedFilterLagAggregator.
+class FftMatchedFilter {
+ public:
+  FftMatchedFilter(ApmDataDumper* data_dumper,
+                   size_t sub_block_size,
+                   size_t window_size_sub_blocks,
+                   int num_matched_filters,
+                   size_t alignment_shift_sub_blocks,
+                   size_t hop_size_sub_blocks,
+                   float excitation_limit);
+
+  FftMatchedFilter() = delete;
+  FftMatchedFilter(const FftMatchedFilter&) = delete;
+  FftMatchedFilter& operator=(const FftMatchedFilter&) = delete;
+
+  ~FftMatchedFilter();
+
+  // Updates the correlation with the values in the capture buffer.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture);
+
+  // Resets the lag estimate. A full reset also clears the smoothed spectra and
+  // the stored render history.
+  void Reset(bool full_reset);
+
+  // Returns the current lag estimate.
+  std::optional<const MatchedFilter::LagEstimate> GetBestLagEstimate() const {
+    return reported_lag_estimate_;
+  }
+
+  // Returns the maximum filter lag, which is the same as for a MatchedFilter
+  // with the same configuration.
+  size_t GetMaxFilterLag() const { return max_filter_lag_; }
+
+  // Returns the number of lags searched.
+  size_t NumLags() const { return num_lags_; }
+
+  // Returns the FFT size used for the correlation.
+  size_t FftSize() const { return fft_->fft_size(); }
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(render_) +
+           HeapBytes(capture_) + HeapBytes(render_fft_) +
+           HeapBytes(capture_fft_) + HeapBytes(correlation_) +
+           HeapBytes(cross_spectrum_) + HeapBytes(render_spectrum_) +
+           HeapBytes(capture_spectrum_);
+  }
+
+ private:
+  // Computes the correlation over the stored render and capture histories and
+  // updates the lag estimate.
+  void Correlate();
+
+  ApmDataDumper* const data_dumper_;
+  const size_t sub_block_size_;
+  const size_t max_filter_lag_;
+  const size_t num_lags_;
+  const size_t hop_size_;
+  const float excitation_limit_;
+  const std::unique_ptr<RealFft> fft_;
+  // Render samples in time order, oldest first, covering the capture hop and
+  // all the searched lags.
+  std::vector<float> render_;
+  // Capture samples of the current hop in time order.
+  std::vector<float> capture_;
+  size_t capture_fill_ = 0;
+  bool capture_saturated_ = false;
+  std::vector<float> render_fft_;
+  std::vector<float> capture_fft_;
+  std::vector<float> correlation_;
+  // Smoothed spectra, where the cross-spectrum is stored in the packed layout
+  // of RealFft.
+  std::vector<float> cross_spectrum_;
+  std::vector<float> render_spectrum_;
+  std::vector<float> capture_spectrum_;
+  bool spectra_initialized_ = false;
+  std::optional<MatchedFilter::LagEstimate> reported_lag_estimate_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
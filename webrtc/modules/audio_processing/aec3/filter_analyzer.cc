@@ -51,6 +51,8 @@ FilterAnalyzer::FilterAnalyzer(const EchoCanceller3Config& config,
     : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       bounded_erl_(config.ep_strength.bounded_erl),
       default_gain_(config.ep_strength.default_gain),
+      estimate_tail_length_(config.filter.adaptive_refined_length.enabled),
+      tail_threshold_(config.filter.adaptive_refined_length.tail_threshold),
       h_highpass_(num_capture_channels,
                   std::vector<float>(
                       GetTimeDomainLength(config.filter.refined.length_blocks),
@@ -70,6 +72,7 @@ void FilterAnalyzer::Reset() {
     state.Reset(default_gain_);
   }
   std::fill(filter_delays_blocks_.begin(), filter_delays_blocks_.end(), 0);
+  tail_length_blocks_ = std::nullopt;
 }
 
 void FilterAnalyzer::Update(
@@ -91,6 +94,7 @@ void FilterAnalyzer::Update(
   *any_filter_consistent = st_ch0.consistent_estimate;
   *max_echo_path_gain = st_ch0.gain;
   min_filter_delay_blocks_ = filter_delays_blocks_[0];
+  tail_length_blocks_ = st_ch0.tail_length_blocks;
   for (size_t ch = 1; ch < filters_time_domain.size(); ++ch) {
     auto& st_ch = filter_analysis_states_[ch];
     *any_filter_consistent =
@@ -98,6 +102,10 @@ void FilterAnalyzer::Update(
     *max_echo_path_gain = std::max(*max_echo_path_gain, st_ch.gain);
     min_filter_delay_blocks_ =
         std::min(min_filter_delay_blocks_, filter_delays_blocks_[ch]);
+    if (st_ch.tail_length_blocks) {
+      tail_length_blocks_ =
+          std::max(tail_length_blocks_.value_or(0), *st_ch.tail_length_blocks);
+    }
   }
 }
 
@@ -131,7 +139,43 @@ void FilterAnalyzer::AnalyzeRegion(
         h_highpass_[ch], region_,
         render_buffer.GetBlock(-filter_delays_blocks_[ch]), st_ch.peak_index,
         filter_delays_blocks_[ch]);
+
+    // The tail is measured once per sweep over the filter, when the whole
+    // preprocessed filter is up to date.
+    if (estimate_tail_length_ &&
+        region_.end_sample_ == filters_time_domain[ch].size() - 1) {
+      UpdateTailLength(h_highpass_[ch], &st_ch);
+    }
+  }
+}
+
+void FilterAnalyzer::UpdateTailLength(
+    rtc::ArrayView<const float> filter_time_domain,
+    FilterAnalysisState* st) const {
+  // Only filters with a consistent shape reflect the echo path, while the
+  // coefficients of other filters are dominated by misadjustment noise.
+  if (!st->consistent_estimate) {
+    return;
+  }
+
+  const size_t num_blocks = filter_time_domain.size() >> kBlockSizeLog2;
+  auto block_energy = [&](size_t block) {
+    const float* h = &filter_time_domain[block * kBlockSize];
+    return std::inner_product(h, h + kBlockSize, h, 0.f);
+  };
+
+  float max_block_energy = 0.f;
+  for (size_t b = 0; b < num_blocks; ++b) {
+    max_block_energy = std::max(max_block_energy, block_energy(b));
+  }
+
+  const float threshold = tail_threshold_ * max_block_energy;
+  size_t tail_length_blocks = num_blocks;
+  while (tail_length_blocks > 1 &&
+         block_energy(tail_length_blocks - 1) <= threshold) {
+    --tail_length_blocks;
   }
+  st->tail_length_blocks = static_cast<int>(tail_length_blocks);
 }
 
 void FilterAnalyzer::UpdateFilterGain(
@@ -16,12 +16,14 @@
 #include <array>
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -60,6 +62,11 @@ class FilterAnalyzer {
     return filter_analysis_states_[0].filter_length_blocks;
   }
 
+  // Returns the length in blocks of the part of the filters that holds the
+  // echo tail, or nullopt if no consistent filter has been analyzed yet. Only
+  // estimated when the refined filter length is adaptive.
+  std::optional<int> TailLengthBlocks() const { return tail_length_blocks_; }
+
   // Returns the preprocessed filter.
   rtc::ArrayView<const std::vector<float>> GetAdjustedFilters() const {
     return h_highpass_;
@@ -68,6 +75,12 @@ class FilterAnalyzer {
   // Public for testing purposes only.
   void SetRegionToAnalyze(size_t filter_size);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(h_highpass_) +
+           HeapBytes(filter_analysis_states_) +
+           HeapBytes(filter_delays_blocks_);
+  }
+
  private:
   struct FilterAnalysisState;
 
@@ -75,6 +88,9 @@ class FilterAnalyzer {
       rtc::ArrayView<const std::vector<float>> filters_time_domain,
       const RenderBuffer& render_buffer);
 
+  void UpdateTailLength(rtc::ArrayView<const float> filter_time_domain,
+                        FilterAnalysisState* st) const;
+
   void UpdateFilterGain(rtc::ArrayView<const float> filters_time_domain,
                         FilterAnalysisState* st);
   void PreProcessFilters(
@@ -120,12 +136,14 @@ class FilterAnalyzer {
     void Reset(float default_gain) {
       peak_index = 0;
       gain = default_gain;
+      tail_length_blocks = std::nullopt;
       consistent_filter_detector.Reset();
     }
 
     float gain;
     size_t peak_index;
     int filter_length_blocks;
+    std::optional<int> tail_length_blocks;
     bool consistent_estimate = false;
     ConsistentFilterDetector consistent_filter_detector;
   };
@@ -134,6 +152,8 @@ class FilterAnalyzer {
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const bool bounded_erl_;
   const float default_gain_;
+  const bool estimate_tail_length_;
+  const float tail_threshold_;
   std::vector<std::vector<float>> h_highpass_;
 
   size_t blocks_since_reset_ = 0;
@@ -143,6 +163,7 @@ class FilterAnalyzer {
   std::vector<int> filter_delays_blocks_;
 
   int min_filter_delay_blocks_ = 0;
+  std::optional<int> tail_length_blocks_;
 };
 
 }  // namespace webrtc
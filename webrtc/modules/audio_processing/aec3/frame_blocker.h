@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -41,6 +42,8 @@ class FrameBlocker {
   // Extracts a multiband block of 64 samples.
   void ExtractBlock(Block* block);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer_); }
+
  private:
   const size_t num_bands_;
   const size_t num_channels_;
@@ -56,6 +56,14 @@ void FullBandErleEstimator::Reset() {
             hold_counters_instantaneous_erle_.end(), 0);
 }
 
+void FullBandErleEstimator::GetState(StateWriter* writer) const {
+  writer->WriteFloats(erle_time_domain_log2_);
+}
+
+void FullBandErleEstimator::SetState(StateReader* reader) {
+  reader->ReadFloats(erle_time_domain_log2_);
+}
+
 void FullBandErleEstimator::Update(
     rtc::ArrayView<const float> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 
 namespace webrtc {
@@ -54,6 +55,12 @@ class FullBandErleEstimator {
     return linear_filters_qualities_;
   }
 
+  // Writes the fullband ERLE estimates to `writer`.
+  void GetState(StateWriter* writer) const;
+
+  // Restores the fullband ERLE estimates written by GetState().
+  void SetState(StateReader* reader);
+
   void Dump(const std::unique_ptr<ApmDataDumper>& data_dumper) const;
 
  private:
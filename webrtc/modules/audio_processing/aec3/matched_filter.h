@@ -19,6 +19,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -147,6 +148,12 @@ class MatchedFilter {
                            size_t shift,
                            size_t downsampling_factor) const;
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(filters_) + HeapBytes(accumulated_error_) +
+           HeapBytes(instantaneous_accumulated_error_) +
+           HeapBytes(scratch_memory_) + HeapBytes(filters_offsets_);
+  }
+
  private:
   void Dump();
 
@@ -17,6 +17,7 @@
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -53,6 +54,11 @@ class MatchedFilterLagAggregator {
     return highest_peak_aggregator_.candidate();
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(highest_peak_aggregator_) +
+           HeapBytes(pre_echo_lag_aggregator_);
+  }
+
  private:
   class PreEchoLagAggregator {
    public:
@@ -61,6 +67,9 @@ class MatchedFilterLagAggregator {
     void Aggregate(int pre_echo_lag);
     int pre_echo_candidate() const { return pre_echo_candidate_; }
     void Dump(ApmDataDumper* const data_dumper);
+    size_t MemoryUsage() const {
+      return sizeof(*this) + HeapBytes(histogram_);
+    }
 
    private:
     const int block_size_log2_;
@@ -78,6 +87,9 @@ class MatchedFilterLagAggregator {
     void Aggregate(int lag);
     int candidate() const { return candidate_; }
     rtc::ArrayView<const int> histogram() const { return histogram_; }
+    size_t MemoryUsage() const {
+      return sizeof(*this) + HeapBytes(histogram_);
+    }
 
    private:
     std::vector<int> histogram_;
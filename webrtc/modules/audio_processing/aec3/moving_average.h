@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace aec3 {
@@ -31,6 +32,8 @@ class MovingAverage {
   // result in output.
   void Average(rtc::ArrayView<const float> input, rtc::ArrayView<float> output);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(memory_); }
+
  private:
   const size_t num_elem_;
   const size_t mem_len_;
@@ -18,16 +18,21 @@
 
 namespace webrtc {
 
-RenderBuffer::RenderBuffer(BlockBuffer* block_buffer,
-                           SpectrumBuffer* spectrum_buffer,
-                           FftBuffer* fft_buffer)
+RenderBuffer::RenderBuffer(
+    BlockBuffer* block_buffer,
+    std::vector<std::vector<UpperBandsLevels>>* upper_bands_levels,
+    SpectrumBuffer* spectrum_buffer,
+    FftBuffer* fft_buffer)
     : block_buffer_(block_buffer),
+      upper_bands_levels_(upper_bands_levels),
       spectrum_buffer_(spectrum_buffer),
       fft_buffer_(fft_buffer) {
   RTC_DCHECK(block_buffer_);
+  RTC_DCHECK(upper_bands_levels_);
   RTC_DCHECK(spectrum_buffer_);
   RTC_DCHECK(fft_buffer_);
   RTC_DCHECK_EQ(block_buffer_->buffer.size(), fft_buffer_->buffer.size());
+  RTC_DCHECK_EQ(block_buffer_->buffer.size(), upper_bands_levels_->size());
   RTC_DCHECK_EQ(spectrum_buffer_->buffer.size(), fft_buffer_->buffer.size());
   RTC_DCHECK_EQ(spectrum_buffer_->read, fft_buffer_->read);
   RTC_DCHECK_EQ(spectrum_buffer_->write, fft_buffer_->write);
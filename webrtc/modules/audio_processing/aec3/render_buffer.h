@@ -26,10 +26,21 @@
 
 namespace webrtc {
 
+// Levels of the upper bands of a render channel. Only the lowest band of the
+// render blocks is buffered, and these levels are all that the echo remover
+// uses from the upper bands.
+struct UpperBandsLevels {
+  // Largest energy among the upper bands.
+  float energy = 0.f;
+  // Largest absolute value of the first upper band.
+  float peak = 0.f;
+};
+
 // Provides a buffer of the render data for the echo remover.
 class RenderBuffer {
  public:
   RenderBuffer(BlockBuffer* block_buffer,
+               std::vector<std::vector<UpperBandsLevels>>* upper_bands_levels,
                SpectrumBuffer* spectrum_buffer,
                FftBuffer* fft_buffer);
 
@@ -46,6 +57,15 @@ class RenderBuffer {
     return block_buffer_->buffer[position];
   }
 
+  // Get the upper bands levels of the render channels of a block. These are
+  // empty when the render signal has a single band.
+  rtc::ArrayView<const UpperBandsLevels> GetUpperBandsLevels(
+      int buffer_offset_blocks) const {
+    int position =
+        block_buffer_->OffsetIndex(block_buffer_->read, buffer_offset_blocks);
+    return (*upper_bands_levels_)[position];
+  }
+
   // Get the spectrum from one of the FFTs in the buffer.
   rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Spectrum(
       int buffer_offset_ffts) const {
@@ -105,6 +125,7 @@ class RenderBuffer {
 
  private:
   const BlockBuffer* const block_buffer_;
+  const std::vector<std::vector<UpperBandsLevels>>* const upper_bands_levels_;
   const SpectrumBuffer* const spectrum_buffer_;
   const FftBuffer* const fft_buffer_;
   bool render_activity_ = false;
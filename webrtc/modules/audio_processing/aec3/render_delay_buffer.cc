@@ -31,15 +31,34 @@
 #include "modules/audio_processing/aec3/fft_buffer.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/render_drift_compensator.h"
 #include "modules/audio_processing/aec3/spectrum_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
 
+// Computes the levels of the upper bands of a render channel.
+UpperBandsLevels ComputeUpperBandsLevels(const Block& block, int channel) {
+  RTC_DCHECK_LT(1, block.NumBands());
+  const auto sum_of_squares = [](float a, float b) { return a + b * b; };
+  UpperBandsLevels levels;
+  for (int band = 1; band < block.NumBands(); ++band) {
+    const float energy =
+        std::accumulate(block.begin(band, channel), block.end(band, channel),
+                        0.f, sum_of_squares);
+    levels.energy = std::max(levels.energy, energy);
+  }
+  const auto min_max = std::minmax_element(block.begin(/*band=*/1, channel),
+                                           block.end(/*band=*/1, channel));
+  levels.peak = std::max(fabsf(*min_max.first), fabsf(*min_max.second));
+  return levels;
+}
+
 class RenderDelayBufferImpl final : public RenderDelayBuffer {
  public:
   RenderDelayBufferImpl(const EchoCanceller3Config& config,
@@ -67,6 +86,8 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   int BufferLatency() const;
   void SetAudioBufferDelay(int delay_ms) override;
   bool HasReceivedBufferDelay() override;
+  void SetClockdriftRate(float rate) override;
+  size_t MemoryUsage() const override;
 
  private:
   static std::atomic<int> instance_count_;
@@ -77,7 +98,10 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   const rtc::LoggingSeverity delay_log_level_;
   size_t down_sampling_factor_;
   const int sub_block_size_;
+  // Only the lowest band of the render blocks is buffered.
   BlockBuffer blocks_;
+  std::vector<std::vector<UpperBandsLevels>> upper_bands_levels_;
+  Block render_block_;
   SpectrumBuffer spectra_;
   FftBuffer ffts_;
   std::optional<size_t> delay_;
@@ -87,6 +111,8 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   Decimator render_decimator_;
   const Aec3Fft fft_;
   std::vector<float> render_ds_;
+  // Only created if clockdrift compensation is enabled.
+  std::unique_ptr<RenderDriftCompensator> drift_compensator_;
   const int buffer_headroom_;
   bool last_call_was_render_ = false;
   int num_api_calls_in_a_row_ = 0;
@@ -133,18 +159,29 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
       blocks_(GetRenderDelayBufferSize(down_sampling_factor_,
                                        config.delay.num_filters,
                                        config.filter.refined.length_blocks),
-              NumBandsForRate(sample_rate_hz),
+              /*num_bands=*/1,
               num_render_channels),
+      upper_bands_levels_(blocks_.buffer.size(),
+                          std::vector<UpperBandsLevels>(
+                              NumBandsForRate(sample_rate_hz) > 1
+                                  ? num_render_channels
+                                  : 0)),
+      render_block_(NumBandsForRate(sample_rate_hz), num_render_channels),
       spectra_(blocks_.buffer.size(), num_render_channels),
       ffts_(blocks_.buffer.size(), num_render_channels),
       delay_(config_.delay.default_delay),
-      echo_remover_buffer_(&blocks_, &spectra_, &ffts_),
+      echo_remover_buffer_(&blocks_, &upper_bands_levels_, &spectra_, &ffts_),
       low_rate_(GetDownSampledBufferSize(down_sampling_factor_,
                                          config.delay.num_filters)),
       render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
       render_decimator_(down_sampling_factor_),
       fft_(),
       render_ds_(sub_block_size_, 0.f),
+      drift_compensator_(config.delay.compensate_clockdrift
+                             ? std::make_unique<RenderDriftCompensator>(
+                                   NumBandsForRate(sample_rate_hz),
+                                   num_render_channels)
+                             : nullptr),
       buffer_headroom_(config.filter.refined.length_blocks) {
   RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
   RTC_DCHECK_EQ(spectra_.buffer.size(), ffts_.buffer.size());
@@ -343,6 +380,20 @@ bool RenderDelayBufferImpl::HasReceivedBufferDelay() {
   return external_audio_buffer_delay_.has_value();
 }
 
+void RenderDelayBufferImpl::SetClockdriftRate(float rate) {
+  if (drift_compensator_) {
+    drift_compensator_->SetRate(rate);
+  }
+}
+
+size_t RenderDelayBufferImpl::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(blocks_) + HeapBytes(upper_bands_levels_) +
+         HeapBytes(render_block_) + HeapBytes(spectra_) + HeapBytes(ffts_) +
+         HeapBytes(low_rate_) + HeapBytes(render_mixer_) +
+         HeapBytes(render_decimator_) + HeapBytes(fft_) +
+         HeapBytes(render_ds_) + HeapBytes(drift_compensator_);
+}
+
 // Maps the externally computed delay to the delay used internally.
 int RenderDelayBufferImpl::MapDelayToTotalDelay(
     size_t external_delay_blocks) const {
@@ -388,22 +439,27 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
   auto& ds = render_ds_;
   auto& f = ffts_;
   auto& s = spectra_;
-  const size_t num_bands = b.buffer[b.write].NumBands();
-  const size_t num_render_channels = b.buffer[b.write].NumChannels();
+  const int num_bands = render_block_.NumBands();
+  const int num_render_channels = render_block_.NumChannels();
   RTC_DCHECK_EQ(block.NumBands(), num_bands);
   RTC_DCHECK_EQ(block.NumChannels(), num_render_channels);
-  for (size_t band = 0; band < num_bands; ++band) {
-    for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      std::copy(block.begin(band, ch), block.end(band, ch),
-                b.buffer[b.write].begin(band, ch));
-    }
+
+  // The drift compensation and the render gain apply to all bands, and are
+  // done on a copy of the block before its lowest band is buffered.
+  const Block* render = &block;
+  if (drift_compensator_ || render_linear_amplitude_gain_ != 1.f) {
+    render_block_ = block;
+    render = &render_block_;
+  }
+
+  if (drift_compensator_) {
+    drift_compensator_->Process(&render_block_);
   }
 
   if (render_linear_amplitude_gain_ != 1.f) {
-    for (size_t band = 0; band < num_bands; ++band) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        rtc::ArrayView<float, kBlockSize> b_view =
-            b.buffer[b.write].View(band, ch);
+    for (int band = 0; band < num_bands; ++band) {
+      for (int ch = 0; ch < num_render_channels; ++ch) {
+        rtc::ArrayView<float, kBlockSize> b_view = render_block_.View(band, ch);
         for (float& sample : b_view) {
           sample *= render_linear_amplitude_gain_;
         }
@@ -411,16 +467,28 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
     }
   }
 
-  std::array<float, kBlockSize> downmixed_render;
-  render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
-  render_decimator_.Decimate(downmixed_render, ds);
-  data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
-                        16000 / down_sampling_factor_, 1);
-  std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
+  std::vector<UpperBandsLevels>& levels = upper_bands_levels_[b.write];
+  for (int ch = 0; ch < num_render_channels; ++ch) {
+    std::copy(render->begin(/*band=*/0, ch), render->end(/*band=*/0, ch),
+              b.buffer[b.write].begin(/*band=*/0, ch));
+    if (!levels.empty()) {
+      levels[ch] = ComputeUpperBandsLevels(*render, ch);
+    }
+  }
+
+  // With a pinned delay, the downsampled render signal is never analyzed and
+  // only its indices are maintained for tracking the buffer latency.
+  if (!config_.delay.use_pinned_delay) {
+    std::array<float, kBlockSize> downmixed_render;
+    render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
+    render_decimator_.Decimate(downmixed_render, ds);
+    data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
+                          16000 / down_sampling_factor_, 1);
+    std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
+  }
+  fft_.PaddedFft(b.buffer[b.write], b.buffer[previous_write],
+                 Aec3Fft::Window::kRectangular, f.buffer[f.write]);
   for (int channel = 0; channel < b.buffer[b.write].NumChannels(); ++channel) {
-    fft_.PaddedFft(b.buffer[b.write].View(/*band=*/0, channel),
-                   b.buffer[previous_write].View(/*band=*/0, channel),
-                   &f.buffer[f.write][channel]);
     f.buffer[f.write][channel].Spectrum(optimization_,
                                         s.buffer[s.write][channel]);
   }
@@ -79,6 +79,14 @@ class RenderDelayBuffer {
   // Returns whether an external delay estimate has been reported via
   // SetAudioBufferDelay.
   virtual bool HasReceivedBufferDelay() = 0;
+
+  // Sets the clockdrift, as the change of the delay per sample, that the
+  // render signal is resampled to compensate for. Has no effect unless
+  // clockdrift compensation is enabled in the config.
+  virtual void SetClockdriftRate(float rate) = 0;
+
+  // Returns the size of the buffer, including the render data it holds.
+  virtual size_t MemoryUsage() const = 0;
 };
 
 }  // namespace webrtc
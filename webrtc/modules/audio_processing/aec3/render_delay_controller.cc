@@ -25,6 +25,7 @@
 #include "modules/audio_processing/aec3/render_delay_controller_metrics.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -49,6 +50,12 @@ class RenderDelayControllerImpl final : public RenderDelayController {
       size_t render_delay_buffer_delay,
       const Block& capture) override;
   bool HasClockdrift() const override;
+  std::optional<float> ClockdriftRate() const override;
+  void ResetClockdriftRate() override;
+  void SetDelay(size_t delay_blocks) override;
+  size_t MemoryUsage() const override {
+    return sizeof(*this) + HeapBytes(delay_estimator_);
+  }
 
  private:
   static std::atomic<int> instance_count_;
@@ -172,6 +179,21 @@ bool RenderDelayControllerImpl::HasClockdrift() const {
   return delay_estimator_.Clockdrift() != ClockdriftDetector::Level::kNone;
 }
 
+std::optional<float> RenderDelayControllerImpl::ClockdriftRate() const {
+  return delay_estimator_.ClockdriftRate();
+}
+
+void RenderDelayControllerImpl::ResetClockdriftRate() {
+  delay_estimator_.ResetClockdriftRate();
+}
+
+void RenderDelayControllerImpl::SetDelay(size_t delay_blocks) {
+  delay_samples_ = DelayEstimate(DelayEstimate::Quality::kRefined,
+                                 delay_blocks << kBlockSizeLog2);
+  delay_ = ComputeBufferDelay(std::nullopt, 0, *delay_samples_);
+  last_delay_estimate_quality_ = DelayEstimate::Quality::kRefined;
+}
+
 }  // namespace
 
 RenderDelayController* RenderDelayController::Create(
@@ -46,6 +46,19 @@ class RenderDelayController {
 
   // Returns true if clockdrift has been detected.
   virtual bool HasClockdrift() const = 0;
+
+  // Returns the estimated rate of the clockdrift, as the change of the delay
+  // per sample, once enough data has been observed.
+  virtual std::optional<float> ClockdriftRate() const = 0;
+
+  // Restarts the estimation of the clockdrift rate.
+  virtual void ResetClockdriftRate() = 0;
+
+  // Sets the delay to report until the delay estimator produces an estimate.
+  virtual void SetDelay(size_t delay_blocks) = 0;
+
+  // Returns the size of the delay controller, including the delay estimator.
+  virtual size_t MemoryUsage() const = 0;
 };
 }  // namespace webrtc
 
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/render_drift_compensator.h"
+
+#include <algorithm>
+
+#include "api/array_view.h"
+#include "common_audio/resampler/sinc_resampler.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
+
+namespace webrtc {
+namespace {
+
+// Maximum latency, in samples, used for absorbing the drift before a block is
+// dropped.
+constexpr size_t kMaxLatency = 16 * kBlockSize;
+constexpr size_t kFifoCapacity = kMaxLatency + 2 * kBlockSize;
+
+// Number of blocks of silence inserted when the FIFO runs empty. Inserting
+// more than one block makes the delay changes, which are then towards shorter
+// delays, less frequent.
+constexpr size_t kUnderrunRefillBlocks = 4;
+
+}  // namespace
+
+// Resamples one channel of one band. The resampler requests the input in
+// chunks of one block, which are read from a FIFO holding the not yet consumed
+// render samples. When the FIFO runs empty, silence is returned instead.
+class RenderDriftCompensator::ChannelResampler : public SincResamplerCallback {
+ public:
+  ChannelResampler()
+      : fifo_(kFifoCapacity, 0.f), resampler_(1.0, kBlockSize, this) {
+    // The first call to the resampler consumes two blocks, of which the first
+    // is silence.
+    size_ = kBlockSize;
+  }
+
+  size_t Level() const { return size_; }
+  bool Underrun() const { return underrun_; }
+
+  void SetRatio(double io_sample_rate_ratio) {
+    resampler_.SetRatio(io_sample_rate_ratio);
+  }
+
+  void Drop(size_t num_samples) {
+    RTC_DCHECK_LE(num_samples, size_);
+    read_ = (read_ + num_samples) % kFifoCapacity;
+    size_ -= num_samples;
+  }
+
+  void PushSilence(size_t num_samples) {
+    RTC_DCHECK_LE(size_ + num_samples, kFifoCapacity);
+    size_t write = (read_ + size_) % kFifoCapacity;
+    for (size_t k = 0; k < num_samples; ++k) {
+      fifo_[write] = 0.f;
+      write = write + 1 < kFifoCapacity ? write + 1 : 0;
+    }
+    size_ += num_samples;
+    underrun_ = false;
+  }
+
+  void Push(rtc::ArrayView<const float> x) {
+    RTC_DCHECK_LE(size_ + x.size(), kFifoCapacity);
+    size_t write = (read_ + size_) % kFifoCapacity;
+    for (float sample : x) {
+      fifo_[write] = sample;
+      write = write + 1 < kFifoCapacity ? write + 1 : 0;
+    }
+    size_ += x.size();
+  }
+
+  void Resample(rtc::ArrayView<float> y) {
+    resampler_.Resample(y.size(), y.data());
+  }
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fifo_) + HeapBytes(resampler_);
+  }
+
+  // SincResamplerCallback implementation.
+  void Run(size_t frames, float* destination) override {
+    const size_t num_available = std::min(frames, size_);
+    for (size_t k = 0; k < num_available; ++k) {
+      destination[k] = fifo_[read_];
+      read_ = read_ + 1 < kFifoCapacity ? read_ + 1 : 0;
+    }
+    size_ -= num_available;
+    std::fill(destination + num_available, destination + frames, 0.f);
+    underrun_ = underrun_ || num_available < frames;
+  }
+
+ private:
+  std::vector<float> fifo_;
+  size_t read_ = 0;
+  size_t size_ = 0;
+  bool underrun_ = false;
+  SincResampler resampler_;
+};
+
+RenderDriftCompensator::RenderDriftCompensator(size_t num_bands,
+                                               size_t num_channels) {
+  resamplers_.reserve(num_bands * num_channels);
+  for (size_t k = 0; k < num_bands * num_channels; ++k) {
+    resamplers_.push_back(std::make_unique<ChannelResampler>());
+  }
+}
+
+RenderDriftCompensator::~RenderDriftCompensator() = default;
+
+void RenderDriftCompensator::SetRate(float rate) {
+  // A growing delay is compensated for by consuming the render samples at a
+  // slower pace.
+  const double io_sample_rate_ratio = 1.0 - static_cast<double>(rate);
+  for (auto& resampler : resamplers_) {
+    resampler->SetRatio(io_sample_rate_ratio);
+  }
+}
+
+size_t RenderDriftCompensator::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(resamplers_);
+}
+
+void RenderDriftCompensator::Process(Block* block) {
+  RTC_DCHECK_EQ(resamplers_.size(),
+                static_cast<size_t>(block->NumBands() * block->NumChannels()));
+
+  // All resamplers use the same ratio and consume their input in the same
+  // pattern, which means that the FIFO levels are identical.
+  const bool drop_block = resamplers_[0]->Level() > kMaxLatency;
+  const bool refill = resamplers_[0]->Underrun();
+
+  size_t k = 0;
+  for (int band = 0; band < block->NumBands(); ++band) {
+    for (int ch = 0; ch < block->NumChannels(); ++ch, ++k) {
+      ChannelResampler& resampler = *resamplers_[k];
+      if (drop_block) {
+        resampler.Drop(kBlockSize);
+      }
+      if (refill) {
+        // One block of silence was already inserted by the underrun.
+        resampler.PushSilence((kUnderrunRefillBlocks - 1) * kBlockSize);
+      }
+      resampler.Push(block->View(band, ch));
+      resampler.Resample(block->View(band, ch));
+    }
+  }
+}
+
+}  // namespace webrtc
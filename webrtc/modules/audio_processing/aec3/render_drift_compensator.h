@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_RENDER_DRIFT_COMPENSATOR_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_RENDER_DRIFT_COMPENSATOR_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "modules/audio_processing/aec3/block.h"
+
+namespace webrtc {
+
+// Resamples the render signal with a ratio close to one to compensate for a
+// rate mismatch between the render and capture clocks. The drift is absorbed
+// by a latency that varies slowly with the accumulated drift. When that
+// latency leaves its allowed range, a block of render samples is dropped or a
+// block of silence is inserted, which the delay estimator handles as a regular
+// delay change.
+class RenderDriftCompensator {
+ public:
+  RenderDriftCompensator(size_t num_bands, size_t num_channels);
+  ~RenderDriftCompensator();
+
+  RenderDriftCompensator(const RenderDriftCompensator&) = delete;
+  RenderDriftCompensator& operator=(const RenderDriftCompensator&) = delete;
+
+  // Sets the drift to compensate for, as the change of the echo path delay per
+  // sample.
+  void SetRate(float rate);
+
+  // Resamples `block` in place.
+  void Process(Block* block);
+
+  size_t MemoryUsage() const;
+
+ private:
+  class ChannelResampler;
+
+  std::vector<std::unique_ptr<ChannelResampler>> resamplers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_RENDER_DRIFT_COMPENSATOR_H_
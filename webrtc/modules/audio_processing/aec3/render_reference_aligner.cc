@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/render_reference_aligner.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RenderReferenceAligner::Reference::Reference(size_t down_sampling_factor,
+                                             size_t downsampled_buffer_size)
+    : decimator(std::make_unique<Decimator>(down_sampling_factor)),
+      low_rate(downsampled_buffer_size) {}
+
+RenderReferenceAligner::RenderReferenceAligner(
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_references,
+    size_t num_capture_channels)
+    : buffering_config_(config.buffering),
+      render_linear_amplitude_gain_(
+          std::pow(10.0f, config.render_levels.render_power_gain_db / 20.f)),
+      sub_block_size_(static_cast<int>(
+          config.delay.down_sampling_factor > 0
+              ? kBlockSize / config.delay.down_sampling_factor
+              : kBlockSize)),
+      default_delay_blocks_(static_cast<int>(config.delay.default_delay)),
+      render_buffer_size_blocks_(static_cast<int>(
+          GetRenderDelayBufferSize(config.delay.down_sampling_factor,
+                                   config.delay.num_filters,
+                                   config.filter.refined.length_blocks))),
+      max_delay_spread_blocks_(
+          config.multi_channel.max_reference_delay_spread_blocks),
+      blocks_(max_delay_spread_blocks_ + 1,
+              NumBandsForRate(sample_rate_hz),
+              num_references) {
+  const size_t downsampled_buffer_size = GetDownSampledBufferSize(
+      config.delay.down_sampling_factor, config.delay.num_filters);
+  references_.reserve(num_references);
+  for (size_t ch = 0; ch < num_references; ++ch) {
+    references_.emplace_back(config.delay.down_sampling_factor,
+                             downsampled_buffer_size);
+    references_.back().delay_controller.reset(RenderDelayController::Create(
+        config, sample_rate_hz, num_capture_channels));
+  }
+  ResetBuffers();
+}
+
+RenderReferenceAligner::~RenderReferenceAligner() = default;
+
+void RenderReferenceAligner::Reset() {
+  ResetBuffers();
+  ResetDelayControllers(true);
+  render_overrun_ = false;
+}
+
+void RenderReferenceAligner::ResetDelayControllers(
+    bool reset_delay_confidence) {
+  // The alignment of the references is kept until new delay estimates are
+  // available.
+  for (Reference& reference : references_) {
+    reference.delay_controller->Reset(reset_delay_confidence);
+    reference.delay = std::nullopt;
+  }
+}
+
+void RenderReferenceAligner::BufferRender(const Block& block,
+                                          Block* aligned_block) {
+  RTC_DCHECK(aligned_block);
+  RTC_DCHECK_EQ(references_.size(), block.NumChannels());
+  RTC_DCHECK_EQ(references_.size(), aligned_block->NumChannels());
+  const int num_bands = block.NumBands();
+
+  if (InsertBlock(block)) {
+    render_overrun_ = true;
+  }
+
+  blocks_.IncWriteIndex();
+  blocks_.buffer[blocks_.write] = block;
+  for (size_t ch = 0; ch < references_.size(); ++ch) {
+    const int offset = -static_cast<int>(references_[ch].alignment_delay_blocks);
+    const Block& delayed_block =
+        blocks_.buffer[blocks_.OffsetIndex(blocks_.write, offset)];
+    for (int band = 0; band < num_bands; ++band) {
+      std::copy(delayed_block.begin(band, ch), delayed_block.end(band, ch),
+                aligned_block->begin(band, ch));
+    }
+  }
+}
+
+std::optional<DelayEstimate> RenderReferenceAligner::EstimateDelay(
+    const Block& capture,
+    bool* alignment_change) {
+  RTC_DCHECK(alignment_change);
+  *alignment_change = false;
+
+  if (render_overrun_) {
+    ResetDelayControllers(true);
+    render_overrun_ = false;
+  }
+
+  const bool render_underrun = PrepareCaptureProcessing();
+  // The render delay, as RenderDelayBuffer::Delay() reports it.
+  const size_t render_delay =
+      static_cast<size_t>(render_delay_blocks_ - BufferLatency());
+
+  const Reference* earliest_reference = nullptr;
+  for (Reference& reference : references_) {
+    if (render_underrun) {
+      reference.delay_controller->Reset(false);
+    }
+    reference.delay = reference.delay_controller->GetDelay(
+        reference.low_rate, render_delay, capture);
+    if (reference.delay &&
+        (!earliest_reference ||
+         reference.delay->delay < earliest_reference->delay->delay)) {
+      earliest_reference = &reference;
+    }
+  }
+
+  if (!earliest_reference) {
+    return std::nullopt;
+  }
+
+  for (Reference& reference : references_) {
+    if (!reference.delay) {
+      continue;
+    }
+    const size_t alignment_delay_blocks =
+        std::min(reference.delay->delay - earliest_reference->delay->delay,
+                 max_delay_spread_blocks_);
+    if (alignment_delay_blocks != reference.alignment_delay_blocks) {
+      reference.alignment_delay_blocks = alignment_delay_blocks;
+      *alignment_change = true;
+    }
+  }
+  return earliest_reference->delay;
+}
+
+bool RenderReferenceAligner::HasClockdrift() const {
+  return std::any_of(references_.begin(), references_.end(),
+                     [](const Reference& reference) {
+                       return reference.delay_controller->HasClockdrift();
+                     });
+}
+
+void RenderReferenceAligner::ResetBuffers() {
+  min_latency_blocks_ = 0;
+  excess_render_detection_counter_ = 0;
+  for (Reference& reference : references_) {
+    DownsampledRenderBuffer& lr = reference.low_rate;
+    // Initialize the read index to one sub-block before the write index.
+    lr.read = lr.OffsetIndex(lr.write, sub_block_size_);
+  }
+  render_delay_blocks_ = default_delay_blocks_ % render_buffer_size_blocks_;
+}
+
+// Returns true on a render buffer overrun, after which the buffers are reset.
+bool RenderReferenceAligner::InsertBlock(const Block& block) {
+  for (Reference& reference : references_) {
+    reference.low_rate.UpdateWriteIndex(-sub_block_size_);
+  }
+  render_delay_blocks_ =
+      (render_delay_blocks_ + 1) % render_buffer_size_blocks_;
+  const DownsampledRenderBuffer& first = references_[0].low_rate;
+  const bool overrun = first.read == first.write || render_delay_blocks_ == 0;
+
+  std::array<float, kBlockSize> render;
+  std::array<float, kBlockSize> ds_storage;
+  rtc::ArrayView<float> ds(ds_storage.data(), sub_block_size_);
+  for (size_t ch = 0; ch < references_.size(); ++ch) {
+    std::copy(block.begin(/*band=*/0, ch), block.end(/*band=*/0, ch),
+              render.begin());
+    if (render_linear_amplitude_gain_ != 1.f) {
+      for (float& sample : render) {
+        sample *= render_linear_amplitude_gain_;
+      }
+    }
+    DownsampledRenderBuffer& lr = references_[ch].low_rate;
+    references_[ch].decimator->Decimate(render, ds);
+    std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
+  }
+
+  if (overrun) {
+    ResetBuffers();
+  }
+  return overrun;
+}
+
+// Returns true on a render buffer underrun.
+bool RenderReferenceAligner::PrepareCaptureProcessing() {
+  if (DetectExcessRenderBlocks()) {
+    ResetBuffers();
+    return false;
+  }
+  const DownsampledRenderBuffer& first = references_[0].low_rate;
+  const bool underrun = first.read == first.write;
+  if (!underrun) {
+    for (Reference& reference : references_) {
+      reference.low_rate.UpdateReadIndex(-sub_block_size_);
+    }
+  }
+  if (render_delay_blocks_ > 0) {
+    --render_delay_blocks_;
+  }
+  return underrun;
+}
+
+bool RenderReferenceAligner::DetectExcessRenderBlocks() {
+  bool excess_render_detected = false;
+  const size_t latency_blocks = static_cast<size_t>(BufferLatency());
+  min_latency_blocks_ = std::min(min_latency_blocks_, latency_blocks);
+  if (++excess_render_detection_counter_ >=
+      buffering_config_.excess_render_detection_interval_blocks) {
+    excess_render_detected = min_latency_blocks_ >
+                             buffering_config_.max_allowed_excess_render_blocks;
+    min_latency_blocks_ = latency_blocks;
+    excess_render_detection_counter_ = 0;
+  }
+  return excess_render_detected;
+}
+
+// Returns the number of unread blocks in the downsampled render buffers.
+int RenderReferenceAligner::BufferLatency() const {
+  const DownsampledRenderBuffer& l = references_[0].low_rate;
+  int latency_samples = (l.buffer.size() + l.read - l.write) % l.buffer.size();
+  return latency_samples / sub_block_size_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_RENDER_REFERENCE_ALIGNER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_RENDER_REFERENCE_ALIGNER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/block_buffer.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "rtc_base/memory/heap_bytes.h"
+
+namespace webrtc {
+
+// Aligns render references that reach the capture signal with different
+// delays. Each render channel is treated as a separate reference, with its own
+// downsampled render buffer and delay controller. Before the references are
+// passed on to the linear filters, each of them is delayed to align with the
+// reference that has the shortest delay.
+class RenderReferenceAligner {
+ public:
+  RenderReferenceAligner(const EchoCanceller3Config& config,
+                         int sample_rate_hz,
+                         size_t num_references,
+                         size_t num_capture_channels);
+  ~RenderReferenceAligner();
+
+  RenderReferenceAligner(const RenderReferenceAligner&) = delete;
+  RenderReferenceAligner& operator=(const RenderReferenceAligner&) = delete;
+
+  // Resets the buffer alignments and the delay estimates.
+  void Reset();
+
+  // Resets the delay controllers. If the delay confidence is reset, the reset
+  // behavior is as if the call is restarted.
+  void ResetDelayControllers(bool reset_delay_confidence);
+
+  // Buffers a render block with one channel per reference, and writes the
+  // block with the references aligned to each other to `aligned_block`.
+  void BufferRender(const Block& block, Block* aligned_block);
+
+  // Estimates the delays of the references using `capture`. Returns the delay
+  // estimate for the aligned references, which is that of the reference with
+  // the shortest delay. `alignment_change` is set to whether the alignment of
+  // the references to each other changed.
+  std::optional<DelayEstimate> EstimateDelay(const Block& capture,
+                                             bool* alignment_change);
+
+  // Returns true if clockdrift has been detected for any of the references.
+  bool HasClockdrift() const;
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(references_) + HeapBytes(blocks_);
+  }
+
+ private:
+  // Only what the delay controller reads is kept per reference: the decimated
+  // render signal. All references are written and read in lockstep, so the
+  // buffer indices and the render delay bookkeeping are the same for all of
+  // them and are maintained once by the aligner.
+  struct Reference {
+    Reference(size_t down_sampling_factor, size_t downsampled_buffer_size);
+
+    std::unique_ptr<Decimator> decimator;
+    DownsampledRenderBuffer low_rate;
+    std::unique_ptr<RenderDelayController> delay_controller;
+    std::optional<DelayEstimate> delay;
+    size_t alignment_delay_blocks = 0;
+
+    size_t MemoryUsage() const {
+      return sizeof(*this) + HeapBytes(decimator) + HeapBytes(low_rate) +
+             HeapBytes(delay_controller);
+    }
+  };
+
+  // Mirror the buffering of RenderDelayBuffer for the downsampled signals.
+  void ResetBuffers();
+  bool InsertBlock(const Block& block);
+  bool PrepareCaptureProcessing();
+  bool DetectExcessRenderBlocks();
+  int BufferLatency() const;
+
+  const EchoCanceller3Config::Buffering buffering_config_;
+  const float render_linear_amplitude_gain_;
+  const int sub_block_size_;
+  const int default_delay_blocks_;
+  // Size of the block buffer of RenderDelayBuffer, in which the render delay
+  // is expressed.
+  const int render_buffer_size_blocks_;
+  const size_t max_delay_spread_blocks_;
+  std::vector<Reference> references_;
+  BlockBuffer blocks_;
+  // Distance between the read and the write positions of the block buffer of
+  // RenderDelayBuffer.
+  int render_delay_blocks_ = 0;
+  size_t min_latency_blocks_ = 0;
+  size_t excess_render_detection_counter_ = 0;
+  bool render_overrun_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_RENDER_REFERENCE_ALIGNER_H_
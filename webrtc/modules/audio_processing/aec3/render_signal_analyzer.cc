@@ -67,6 +67,8 @@ void IdentifyStrongNarrowBandComponent(const RenderBuffer& render_buffer,
   }
 
   const Block& x_latest = render_buffer.GetBlock(0);
+  rtc::ArrayView<const UpperBandsLevels> upper_bands_latest =
+      render_buffer.GetUpperBandsLevels(0);
   float max_peak_level = 0.f;
   for (int channel = 0; channel < x_latest.NumChannels(); ++channel) {
     rtc::ArrayView<const float, kFftLengthBy2Plus1> X2_latest =
@@ -93,13 +95,8 @@ void IdentifyStrongNarrowBandComponent(const RenderBuffer& render_buffer,
                                        x_latest.end(/*band=*/0, channel));
     float max_abs = std::max(fabs(*result0.first), fabs(*result0.second));
 
-    if (x_latest.NumBands() > 1) {
-      const auto result1 =
-          std::minmax_element(x_latest.begin(/*band=*/1, channel),
-                              x_latest.end(/*band=*/1, channel));
-      max_abs =
-          std::max(max_abs, static_cast<float>(std::max(
-                                fabs(*result1.first), fabs(*result1.second))));
+    if (!upper_bands_latest.empty()) {
+      max_abs = std::max(max_abs, upper_bands_latest[channel].peak);
     }
 
     // Detect whether the spectral peak has as strong narrowband nature.
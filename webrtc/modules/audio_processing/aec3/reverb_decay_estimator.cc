@@ -85,8 +85,9 @@ float BlockEnergyAverage(rtc::ArrayView<const float> h, int block_index) {
 }  // namespace
 
 ReverbDecayEstimator::ReverbDecayEstimator(const EchoCanceller3Config& config)
-    : filter_length_blocks_(config.filter.refined.length_blocks),
-      filter_length_coefficients_(GetTimeDomainLength(filter_length_blocks_)),
+    : filter_length_coefficients_(
+          GetTimeDomainLength(config.filter.refined.length_blocks)),
+      adaptive_filter_length_(config.filter.adaptive_refined_length.enabled),
       use_adaptive_echo_decay_(config.ep_strength.default_len < 0.f),
       early_reverb_estimator_(config.filter.refined.length_blocks -
                               kEarlyReverbMinSizeBlocks),
@@ -107,16 +108,25 @@ void ReverbDecayEstimator::Update(rtc::ArrayView<const float> filter,
                                   bool usable_linear_filter,
                                   bool stationary_signal) {
   const int filter_size = static_cast<int>(filter.size());
+  const int filter_length_blocks = filter_size >> kFftLengthBy2Log2;
+  RTC_DCHECK_LE(filter_size, filter_length_coefficients_);
 
   if (stationary_signal) {
     return;
   }
 
+  // With an adaptive filter length, the filter may be analyzed at any length
+  // but the analysis restarts whenever the length changes. Otherwise only the
+  // configured length is analyzed.
+  const bool filter_size_settled =
+      adaptive_filter_length_ ? filter_size == previous_filter_size_
+                              : filter_size == filter_length_coefficients_;
+  previous_filter_size_ = filter_size;
+
   bool estimation_feasible =
       filter_delay_blocks <=
-      filter_length_blocks_ - kEarlyReverbMinSizeBlocks - 1;
-  estimation_feasible =
-      estimation_feasible && filter_size == filter_length_coefficients_;
+      filter_length_blocks - kEarlyReverbMinSizeBlocks - 1;
+  estimation_feasible = estimation_feasible && filter_size_settled;
   estimation_feasible = estimation_feasible && filter_delay_blocks > 0;
   estimation_feasible = estimation_feasible && usable_linear_filter;
 
@@ -135,7 +145,7 @@ void ReverbDecayEstimator::Update(rtc::ArrayView<const float> filter,
     return;
   }
 
-  if (block_to_analyze_ < filter_length_blocks_) {
+  if (block_to_analyze_ < filter_length_blocks) {
     // Analyze the filter and accumulate data for reverb estimation.
     AnalyzeFilter(filter);
     ++block_to_analyze_;
@@ -162,15 +172,16 @@ void ReverbDecayEstimator::EstimateDecay(rtc::ArrayView<const float> filter,
   auto& h = filter;
   RTC_DCHECK_EQ(0, h.size() % kFftLengthBy2);
 
+  const int h_size_blocks = static_cast<int>(h.size() >> kFftLengthBy2Log2);
+
   // Reset the block analysis counter.
   block_to_analyze_ =
-      std::min(peak_block + kEarlyReverbMinSizeBlocks, filter_length_blocks_);
+      std::min(peak_block + kEarlyReverbMinSizeBlocks, h_size_blocks);
 
   // To estimate the reverb decay, the energy of the first filter section must
   // be substantially larger than the last. Also, the first filter section
   // energy must not deviate too much from the max peak.
   const float first_reverb_gain = BlockEnergyAverage(h, block_to_analyze_);
-  const size_t h_size_blocks = h.size() >> kFftLengthBy2Log2;
   tail_gain_ = BlockEnergyAverage(h, h_size_blocks - 1);
   float peak_energy = BlockEnergyPeak(h, peak_block);
   const bool sufficient_reverb_decay = first_reverb_gain > 4.f * tail_gain_;
@@ -98,14 +98,15 @@ class ReverbDecayEstimator {
     int n_sections_ = 0;
   };
 
-  const int filter_length_blocks_;
   const int filter_length_coefficients_;
+  const bool adaptive_filter_length_;
   const bool use_adaptive_echo_decay_;
   LateReverbLinearRegressor late_reverb_decay_estimator_;
   EarlyReverbLengthEstimator early_reverb_estimator_;
   int late_reverb_start_;
   int late_reverb_end_;
   int block_to_analyze_ = 0;
+  int previous_filter_size_ = 0;
   int estimation_region_candidate_size_ = 0;
   bool estimation_region_identified_ = false;
   std::vector<float> previous_gains_;
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -61,6 +62,14 @@ class SignalDependentErleEstimator {
 
   static constexpr size_t kSubbands = 6;
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(section_boundaries_blocks_) +
+           HeapBytes(erle_) + HeapBytes(erle_onset_compensated_) +
+           HeapBytes(S2_section_accum_) + HeapBytes(erle_estimators_) +
+           HeapBytes(erle_ref_) + HeapBytes(correction_factors_) +
+           HeapBytes(num_updates_) + HeapBytes(n_active_sections_);
+  }
+
  private:
   void ComputeNumberOfActiveFilterSections(
       const RenderBuffer& render_buffer,
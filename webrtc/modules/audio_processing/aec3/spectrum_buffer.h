@@ -18,6 +18,7 @@
 
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -51,6 +52,8 @@ struct SpectrumBuffer {
   void IncReadIndex() { read = IncIndex(read); }
   void DecReadIndex() { read = DecIndex(read); }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer); }
+
   const int size;
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> buffer;
   int write = 0;
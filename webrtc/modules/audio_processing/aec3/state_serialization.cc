@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/state_serialization.h"
+
+#include <string.h>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+StateWriter::StateWriter(std::vector<uint8_t>* buffer) : buffer_(buffer) {
+  RTC_DCHECK(buffer_);
+}
+
+void StateWriter::WriteUint32(uint32_t value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer_->insert(buffer_->end(), bytes, bytes + sizeof(value));
+}
+
+void StateWriter::WriteFloat(float value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer_->insert(buffer_->end(), bytes, bytes + sizeof(value));
+}
+
+void StateWriter::WriteFloats(rtc::ArrayView<const float> values) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+  buffer_->insert(buffer_->end(), bytes, bytes + values.size() * sizeof(float));
+}
+
+StateReader::StateReader(rtc::ArrayView<const uint8_t> buffer)
+    : buffer_(buffer) {}
+
+uint32_t StateReader::ReadUint32() {
+  uint32_t value = 0;
+  Read(&value, sizeof(value));
+  return value;
+}
+
+float StateReader::ReadFloat() {
+  float value = 0.f;
+  Read(&value, sizeof(value));
+  return value;
+}
+
+void StateReader::ReadFloats(rtc::ArrayView<float> values) {
+  Read(values.data(), values.size() * sizeof(float));
+}
+
+void StateReader::Read(void* data, size_t num_bytes) {
+  RTC_DCHECK_LE(num_bytes, BytesLeft());
+  if (num_bytes > BytesLeft()) {
+    return;
+  }
+  memcpy(data, buffer_.data() + position_, num_bytes);
+  position_ += num_bytes;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_STATE_SERIALIZATION_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_STATE_SERIALIZATION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Appends values to a byte buffer holding a snapshot of the AEC3 state. The
+// values are stored in the native byte order, and the layout is defined by the
+// order of the write calls.
+class StateWriter {
+ public:
+  explicit StateWriter(std::vector<uint8_t>* buffer);
+
+  void WriteUint32(uint32_t value);
+  void WriteFloat(float value);
+  void WriteFloats(rtc::ArrayView<const float> values);
+
+ private:
+  std::vector<uint8_t>* const buffer_;
+};
+
+// Reads back the values written by StateWriter, in the same order. The caller
+// is expected to have verified the size of the buffer beforehand. Reads beyond
+// the end of the buffer leave the output values unchanged.
+class StateReader {
+ public:
+  explicit StateReader(rtc::ArrayView<const uint8_t> buffer);
+
+  uint32_t ReadUint32();
+  float ReadFloat();
+  void ReadFloats(rtc::ArrayView<float> values);
+
+  // Returns the number of bytes that have not yet been read.
+  size_t BytesLeft() const { return buffer_.size() - position_; }
+
+ private:
+  void Read(void* data, size_t num_bytes);
+
+  const rtc::ArrayView<const uint8_t> buffer_;
+  size_t position_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_STATE_SERIALIZATION_H_
@@ -71,6 +71,22 @@ void SubbandErleEstimator::Reset() {
   ResetAccumulatedSpectra();
 }
 
+void SubbandErleEstimator::GetState(StateWriter* writer) const {
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    writer->WriteFloats(erle_[ch]);
+    writer->WriteFloats(erle_onset_compensated_[ch]);
+    writer->WriteFloats(erle_unbounded_[ch]);
+  }
+}
+
+void SubbandErleEstimator::SetState(StateReader* reader) {
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    reader->ReadFloats(erle_[ch]);
+    reader->ReadFloats(erle_onset_compensated_[ch]);
+    reader->ReadFloats(erle_unbounded_[ch]);
+  }
+}
+
 void SubbandErleEstimator::Update(
     rtc::ArrayView<const float, kFftLengthBy2Plus1> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
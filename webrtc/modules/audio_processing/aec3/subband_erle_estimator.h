@@ -20,7 +20,9 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -59,8 +61,24 @@ class SubbandErleEstimator {
     return erle_during_onsets_;
   }
 
+  // Writes the subband ERLE estimates to `writer`.
+  void GetState(StateWriter* writer) const;
+
+  // Restores the subband ERLE estimates written by GetState().
+  void SetState(StateReader* reader);
+
   void Dump(const std::unique_ptr<ApmDataDumper>& data_dumper) const;
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(accum_spectra_.Y2) +
+           HeapBytes(accum_spectra_.E2) +
+           HeapBytes(accum_spectra_.low_render_energy) +
+           HeapBytes(accum_spectra_.num_points) + HeapBytes(erle_) +
+           HeapBytes(erle_onset_compensated_) + HeapBytes(erle_unbounded_) +
+           HeapBytes(erle_during_onsets_) + HeapBytes(coming_onset_) +
+           HeapBytes(hold_counters_);
+  }
+
  private:
   struct AccumulatedSpectra {
     explicit AccumulatedSpectra(size_t num_capture_channels)
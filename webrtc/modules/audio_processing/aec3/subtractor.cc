@@ -60,6 +60,41 @@ void ScaleFilterOutput(rtc::ArrayView<const float> y,
   }
 }
 
+void WriteFilter(const AdaptiveFirFilter& filter, StateWriter* writer) {
+  writer->WriteUint32(filter.SizePartitions());
+  for (const auto& H_p : filter.GetFilter()) {
+    for (const FftData& H_p_ch : H_p) {
+      writer->WriteFloats(H_p_ch.re);
+      writer->WriteFloats(H_p_ch.im);
+    }
+  }
+}
+
+void ReadFilter(StateReader* reader,
+                AdaptiveFirFilter* filter,
+                std::vector<float>* impulse_response) {
+  const size_t size_partitions =
+      rtc::SafeClamp<size_t>(reader->ReadUint32(), 1,
+                             filter->max_filter_size_partitions());
+  std::vector<std::vector<FftData>> H = filter->GetFilter();
+  for (auto& H_p : H) {
+    for (FftData& H_p_ch : H_p) {
+      reader->ReadFloats(H_p_ch.re);
+      reader->ReadFloats(H_p_ch.im);
+    }
+  }
+  filter->SetSizePartitions(size_partitions, /*immediate_effect=*/true);
+  filter->SetFilter(size_partitions, H);
+
+  // The stored filter is already constrained, so running the cyclic
+  // constraint once over all partitions only recomputes the impulse response.
+  if (impulse_response) {
+    for (size_t p = 0; p < size_partitions; ++p) {
+      filter->SkipAdaptation(impulse_response);
+    }
+  }
+}
+
 }  // namespace
 
 Subtractor::Subtractor(const EchoCanceller3Config& config,
@@ -80,6 +115,7 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
       filter_misadjustment_estimators_(num_capture_channels_),
       poor_coarse_filter_counters_(num_capture_channels_, 0),
       coarse_filter_reset_hangover_(num_capture_channels_, 0),
+      refined_filter_target_size_(config_.filter.refined_initial.length_blocks),
       refined_frequency_responses_(
           num_capture_channels_,
           std::vector<std::array<float, kFftLengthBy2Plus1>>(
@@ -155,6 +191,8 @@ void Subtractor::HandleEchoPathChange(
   if (echo_path_variability.delay_change !=
       EchoPathVariability::DelayAdjustment::kNone) {
     full_reset();
+    refined_filter_target_size_ = config_.filter.refined_initial.length_blocks;
+    refined_filter_shrink_counter_ = 0;
   }
 
   if (echo_path_variability.gain_change) {
@@ -164,6 +202,28 @@ void Subtractor::HandleEchoPathChange(
   }
 }
 
+void Subtractor::GetState(StateWriter* writer) const {
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    WriteFilter(*refined_filters_[ch], writer);
+    WriteFilter(*coarse_filter_[ch], writer);
+  }
+}
+
+void Subtractor::SetState(StateReader* reader) {
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    ReadFilter(reader, refined_filters_[ch].get(),
+               &refined_impulse_responses_[ch]);
+    refined_filters_[ch]->ComputeFrequencyResponse(
+        &refined_frequency_responses_[ch]);
+    ReadFilter(reader, coarse_filter_[ch].get(),
+               ApmDataDumper::IsAvailable() ? &coarse_impulse_responses_[ch]
+                                            : nullptr);
+    poor_coarse_filter_counters_[ch] = 0;
+  }
+  refined_filter_target_size_ = refined_filters_[0]->SizePartitions();
+  refined_filter_shrink_counter_ = 0;
+}
+
 void Subtractor::ExitInitialState() {
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     refined_gains_[ch]->SetConfig(config_.filter.refined, false);
@@ -173,6 +233,39 @@ void Subtractor::ExitInitialState() {
     coarse_filter_[ch]->SetSizePartitions(config_.filter.coarse.length_blocks,
                                           false);
   }
+  refined_filter_target_size_ = config_.filter.refined.length_blocks;
+  refined_filter_shrink_counter_ = 0;
+  refined_filter_size_adaptation_active_ =
+      config_.filter.adaptive_refined_length.enabled;
+}
+
+void Subtractor::UpdateRefinedFilterSize(int tail_length_blocks) {
+  if (!refined_filter_size_adaptation_active_) {
+    return;
+  }
+
+  const auto& cfg = config_.filter.adaptive_refined_length;
+  const size_t target_size = rtc::SafeClamp<size_t>(
+      tail_length_blocks + cfg.headroom_blocks, cfg.min_length_blocks,
+      std::min(cfg.max_length_blocks, config_.filter.refined.length_blocks));
+
+  // Grow the filters as soon as the tail reaches into the headroom, but only
+  // shrink them when the tail has been shorter for a while.
+  constexpr int kShrinkHoldBlocks = 2 * kNumBlocksPerSecond;
+  if (target_size == refined_filter_target_size_) {
+    refined_filter_shrink_counter_ = 0;
+    return;
+  }
+  if (target_size < refined_filter_target_size_ &&
+      ++refined_filter_shrink_counter_ < kShrinkHoldBlocks) {
+    return;
+  }
+
+  refined_filter_shrink_counter_ = 0;
+  refined_filter_target_size_ = target_size;
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    refined_filters_[ch]->SetSizePartitions(target_size, false);
+  }
 }
 
 void Subtractor::Process(const RenderBuffer& render_buffer,
@@ -324,6 +417,28 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
   }
 }
 
+void Subtractor::Bypass(const Block& capture,
+                        rtc::ArrayView<SubtractorOutput> outputs) {
+  RTC_DCHECK_EQ(num_capture_channels_, capture.NumChannels());
+
+  // Without render signal the echo estimates are zero, and neither the filters
+  // nor their adaptation state are updated.
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    SubtractorOutput& output = outputs[ch];
+    rtc::ArrayView<const float> y = capture.View(/*band=*/0, ch);
+    output.s_refined.fill(0.f);
+    output.s_coarse.fill(0.f);
+    std::copy(y.begin(), y.end(), output.e_refined.begin());
+    std::copy(y.begin(), y.end(), output.e_coarse.begin());
+    output.ComputeMetrics(y);
+    coarse_filter_reset_hangover_[ch] =
+        std::max(coarse_filter_reset_hangover_[ch] - 1, 0);
+
+    std::for_each(output.e_refined.begin(), output.e_refined.end(),
+                  [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+  }
+}
+
 void Subtractor::FilterMisadjustmentEstimator::Update(
     const SubtractorOutput& output) {
   e2_acum_ += output.e2_refined;
@@ -29,9 +29,11 @@
 #include "modules/audio_processing/aec3/refined_filter_update_gain.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
+#include "modules/audio_processing/aec3/state_serialization.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -54,11 +56,28 @@ class Subtractor {
                const AecState& aec_state,
                rtc::ArrayView<SubtractorOutput> outputs);
 
+  // Forms the outputs without applying or adapting the filters. Used when the
+  // render signal covered by the filters is silent, so that the echo estimates
+  // are zero. The filters and their adaptation gains are left untouched.
+  void Bypass(const Block& capture, rtc::ArrayView<SubtractorOutput> outputs);
+
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
   // Exits the initial state.
   void ExitInitialState();
 
+  // Adjusts the size of the refined filters to cover an echo tail of
+  // `tail_length_blocks` blocks. Only has an effect after the initial state
+  // has been left, and when the refined filter length is adaptive.
+  void UpdateRefinedFilterSize(int tail_length_blocks);
+
+  // Writes the sizes and coefficients of the adaptive filters to `writer`.
+  void GetState(StateWriter* writer) const;
+
+  // Restores the adaptive filters written by GetState(). The adaptation gains
+  // are left unchanged.
+  void SetState(StateReader* reader);
+
   // Returns the block-wise frequency responses for the refined adaptive
   // filters.
   const std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>&
@@ -93,6 +112,17 @@ class Subtractor {
     coarse_filter_[0]->DumpFilter("aec3_subtractor_H_coarse");
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(refined_filters_) +
+           HeapBytes(coarse_filter_) + HeapBytes(refined_gains_) +
+           HeapBytes(coarse_gains_) +
+           HeapBytes(filter_misadjustment_estimators_) +
+           HeapBytes(poor_coarse_filter_counters_) +
+           HeapBytes(coarse_filter_reset_hangover_) +
+           HeapBytes(refined_impulse_responses_) +
+           HeapBytes(coarse_impulse_responses_);
+  }
+
  private:
   class FilterMisadjustmentEstimator {
    public:
@@ -139,6 +169,9 @@ class Subtractor {
   std::vector<FilterMisadjustmentEstimator> filter_misadjustment_estimators_;
   std::vector<size_t> poor_coarse_filter_counters_;
   std::vector<int> coarse_filter_reset_hangover_;
+  bool refined_filter_size_adaptation_active_ = false;
+  size_t refined_filter_target_size_;
+  int refined_filter_shrink_counter_ = 0;
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
       refined_frequency_responses_;
   std::vector<std::vector<float>> refined_impulse_responses_;
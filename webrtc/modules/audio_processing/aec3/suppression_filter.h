@@ -18,6 +18,7 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/fft_data.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -38,6 +39,10 @@ class SuppressionFilter {
                  rtc::ArrayView<const FftData> E_lowest_band,
                  Block* e);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(e_output_old_);
+  }
+
  private:
   const Aec3Optimization optimization_;
   const int sample_rate_hz_;
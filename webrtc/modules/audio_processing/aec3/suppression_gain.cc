@@ -110,12 +110,14 @@ float SuppressionGain::UpperBandsGain(
     const std::optional<int>& narrow_peak_band,
     bool saturated_echo,
     const Block& render,
+    rtc::ArrayView<const UpperBandsLevels> render_upper_bands,
     const std::array<float, kFftLengthBy2Plus1>& low_band_gain) const {
-  RTC_DCHECK_LT(0, render.NumBands());
-  if (render.NumBands() == 1) {
+  if (render_upper_bands.empty()) {
     return 1.f;
   }
   const int num_render_channels = render.NumChannels();
+  RTC_DCHECK_EQ(render_upper_bands.size(),
+                static_cast<size_t>(num_render_channels));
 
   if (narrow_peak_band &&
       (*narrow_peak_band > static_cast<int>(kFftLengthBy2Plus1 - 10))) {
@@ -141,12 +143,8 @@ float SuppressionGain::UpperBandsGain(
     low_band_energy = std::max(low_band_energy, channel_energy);
   }
   float high_band_energy = 0.f;
-  for (int k = 1; k < render.NumBands(); ++k) {
-    for (int ch = 0; ch < num_render_channels; ++ch) {
-      const float energy = std::accumulate(
-          render.begin(k, ch), render.end(k, ch), 0.f, sum_of_squares);
-      high_band_energy = std::max(high_band_energy, energy);
-    }
+  for (const UpperBandsLevels& levels : render_upper_bands) {
+    high_band_energy = std::max(high_band_energy, levels.energy);
   }
 
   // If there is more power in the lower frequencies than the upper frequencies,
@@ -372,6 +370,7 @@ void SuppressionGain::GetGain(
     const RenderSignalAnalyzer& render_signal_analyzer,
     const AecState& aec_state,
     const Block& render,
+    rtc::ArrayView<const UpperBandsLevels> render_upper_bands,
     bool clock_drift,
     float* high_bands_gain,
     std::array<float, kFftLengthBy2Plus1>* low_band_gain) {
@@ -399,7 +398,8 @@ void SuppressionGain::GetGain(
 
   *high_bands_gain =
       UpperBandsGain(echo_spectrum, comfort_noise_spectrum, narrow_peak_band,
-                     aec_state.SaturatedEcho(), render, *low_band_gain);
+                     aec_state.SaturatedEcho(), render, render_upper_bands,
+                     *low_band_gain);
 
   data_dumper_->DumpRaw("aec3_dominant_nearend",
                         dominant_nearend_detector_->IsNearendState());
@@ -24,8 +24,10 @@
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/moving_average.h"
 #include "modules/audio_processing/aec3/nearend_detector.h"
+#include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -53,6 +55,7 @@ class SuppressionGain {
       const RenderSignalAnalyzer& render_signal_analyzer,
       const AecState& aec_state,
       const Block& render,
+      rtc::ArrayView<const UpperBandsLevels> render_upper_bands,
       bool clock_drift,
       float* high_bands_gain,
       std::array<float, kFftLengthBy2Plus1>* low_band_gain);
@@ -64,6 +67,11 @@ class SuppressionGain {
   // Toggles the usage of the initial state.
   void SetInitialState(bool state);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(last_nearend_) + HeapBytes(last_echo_) +
+           HeapBytes(nearend_smoothers_);
+  }
+
  private:
   // Computes the gain to apply for the bands beyond the first band.
   float UpperBandsGain(
@@ -73,6 +81,7 @@ class SuppressionGain {
       const std::optional<int>& narrow_peak_band,
       bool saturated_echo,
       const Block& render,
+      rtc::ArrayView<const UpperBandsLevels> render_upper_bands,
       const std::array<float, kFftLengthBy2Plus1>& low_band_gain) const;
 
   void GainToNoAudibleEcho(const std::array<float, kFftLengthBy2Plus1>& nearend,
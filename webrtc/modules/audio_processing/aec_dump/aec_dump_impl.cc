@@ -0,0 +1,400 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/aec_dump_impl.h"
+
+#include <utility>
+
+#include "absl/base/nullability.h"
+#include "absl/strings/string_view.h"
+#include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Number of events that can be pending for the worker queue, corresponding
+// to more than a second of capture and render frames.
+constexpr size_t kEventQueueSize = 256;
+
+// Initial capacity of the event slots, enough for a 10 ms stereo 48 kHz float
+// capture frame with input and output.
+constexpr size_t kInitialEventCapacity = 8 * 1024;
+
+void CopyFromConfigToEvent(const InternalAPMConfig& config,
+                           audioproc::Config* pb_cfg) {
+  pb_cfg->set_aec_enabled(config.aec_enabled);
+  pb_cfg->set_aec_delay_agnostic_enabled(config.aec_delay_agnostic_enabled);
+  pb_cfg->set_aec_drift_compensation_enabled(
+      config.aec_drift_compensation_enabled);
+  pb_cfg->set_aec_extended_filter_enabled(config.aec_extended_filter_enabled);
+  pb_cfg->set_aec_suppression_level(config.aec_suppression_level);
+
+  pb_cfg->set_aecm_enabled(config.aecm_enabled);
+
+  pb_cfg->set_agc_enabled(config.agc_enabled);
+  pb_cfg->set_agc_mode(config.agc_mode);
+  pb_cfg->set_agc_limiter_enabled(config.agc_limiter_enabled);
+  pb_cfg->set_noise_robust_agc_enabled(config.noise_robust_agc_enabled);
+
+  pb_cfg->set_hpf_enabled(config.hpf_enabled);
+
+  pb_cfg->set_ns_enabled(config.ns_enabled);
+  pb_cfg->set_ns_level(config.ns_level);
+
+  pb_cfg->set_transient_suppression_enabled(
+      config.transient_suppression_enabled);
+
+  pb_cfg->set_pre_amplifier_enabled(config.pre_amplifier_enabled);
+  pb_cfg->set_pre_amplifier_fixed_gain_factor(
+      config.pre_amplifier_fixed_gain_factor);
+
+  pb_cfg->set_experiments_description(config.experiments_description);
+}
+
+}  // namespace
+
+struct AecDumpImpl::EventQueue::Slot {
+  // Position of the event that the slot can be written with, or, once the
+  // event is written, that position plus one.
+  std::atomic<size_t> sequence;
+  std::string data;
+};
+
+AecDumpImpl::EventQueue::EventQueue(size_t size)
+    : mask_(size - 1),
+      slots_(new Slot[size]),
+      insert_position_(0),
+      read_position_(0) {
+  RTC_DCHECK_GT(size, 0);
+  RTC_DCHECK_EQ(size & mask_, 0);
+  for (size_t i = 0; i < size; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+    slots_[i].data.reserve(kInitialEventCapacity);
+  }
+}
+
+AecDumpImpl::EventQueue::~EventQueue() = default;
+
+bool AecDumpImpl::EventQueue::Insert(const audioproc::Event& event) {
+  size_t position = insert_position_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[position & mask_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (insert_position_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < position) {
+      // The slot still holds the event written one lap earlier.
+      return false;
+    } else {
+      position = insert_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Serializing into the existing string reuses its allocation.
+  event.SerializeToString(&slot->data);
+  slot->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+const std::string* AecDumpImpl::EventQueue::Front() {
+  Slot& slot = slots_[read_position_ & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != read_position_ + 1) {
+    return nullptr;
+  }
+  return &slot.data;
+}
+
+void AecDumpImpl::EventQueue::PopFront() {
+  Slot& slot = slots_[read_position_ & mask_];
+  RTC_DCHECK_EQ(slot.sequence.load(std::memory_order_relaxed),
+                read_position_ + 1);
+  // Makes the slot available to the producers on the next lap.
+  slot.sequence.store(read_position_ + mask_ + 1, std::memory_order_release);
+  ++read_position_;
+}
+
+AecDumpImpl::AecDumpImpl(FileWrapper debug_file,
+                         int64_t max_log_size_bytes,
+                         TaskQueueBase* worker_queue)
+    : worker_queue_(worker_queue),
+      queue_(kEventQueueSize),
+      num_dropped_events_(0),
+      file_closed_(false),
+      debug_file_(std::move(debug_file)),
+      num_bytes_left_for_log_(max_log_size_bytes) {}
+
+AecDumpImpl::~AecDumpImpl() {
+  // Block until the pending events have been written. By then all previously
+  // posted tasks will have finished.
+  rtc::Event thread_sync_event;
+  worker_queue_->PostTask([this, &thread_sync_event] {
+    WritePendingEvents();
+    thread_sync_event.Set();
+  });
+  thread_sync_event.Wait(rtc::Event::kForever);
+}
+
+void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
+                                   int64_t time_now_ms) {
+  audioproc::Event event;
+  event.set_type(audioproc::Event::INIT);
+  audioproc::Init* msg = event.mutable_init();
+
+  msg->set_sample_rate(api_format.input_stream().sample_rate_hz());
+  msg->set_output_sample_rate(api_format.output_stream().sample_rate_hz());
+  msg->set_reverse_sample_rate(
+      api_format.reverse_input_stream().sample_rate_hz());
+  msg->set_reverse_output_sample_rate(
+      api_format.reverse_output_stream().sample_rate_hz());
+
+  msg->set_num_input_channels(
+      static_cast<int32_t>(api_format.input_stream().num_channels()));
+  msg->set_num_output_channels(
+      static_cast<int32_t>(api_format.output_stream().num_channels()));
+  msg->set_num_reverse_channels(
+      static_cast<int32_t>(api_format.reverse_input_stream().num_channels()));
+  msg->set_num_reverse_output_channels(
+      api_format.reverse_output_stream().num_channels());
+  msg->set_timestamp_ms(time_now_ms);
+
+  Enqueue(event);
+}
+
+void AecDumpImpl::AddCaptureStreamInput(
+    const AudioFrameView<const float>& src) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_stream_info_.AddInput(src);
+}
+
+void AecDumpImpl::AddCaptureStreamOutput(
+    const AudioFrameView<const float>& src) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_stream_info_.AddOutput(src);
+}
+
+void AecDumpImpl::AddCaptureStreamInput(const int16_t* const data,
+                                        int num_channels,
+                                        int samples_per_channel) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_stream_info_.AddInput(data, num_channels, samples_per_channel);
+}
+
+void AecDumpImpl::AddCaptureStreamOutput(const int16_t* const data,
+                                         int num_channels,
+                                         int samples_per_channel) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_stream_info_.AddOutput(data, num_channels, samples_per_channel);
+}
+
+void AecDumpImpl::AddAudioProcessingState(const AudioProcessingState& state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_stream_info_.AddAudioProcessingState(state);
+}
+
+void AecDumpImpl::WriteCaptureStreamMessage() {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  if (!file_closed_.load(std::memory_order_relaxed)) {
+    Enqueue(capture_stream_info_.event());
+  }
+  capture_stream_info_.Clear();
+}
+
+void AecDumpImpl::WriteRenderStreamMessage(const int16_t* const data,
+                                           int num_channels,
+                                           int samples_per_channel) {
+  RTC_DCHECK_RUNS_SERIALIZED(&render_race_checker_);
+  if (file_closed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  render_event_.Clear();
+  render_event_.set_type(audioproc::Event::REVERSE_STREAM);
+  audioproc::ReverseStream* msg = render_event_.mutable_reverse_stream();
+  const size_t data_size = sizeof(int16_t) * samples_per_channel * num_channels;
+  msg->set_data(data, data_size);
+
+  Enqueue(render_event_);
+}
+
+void AecDumpImpl::WriteRenderStreamMessage(
+    const AudioFrameView<const float>& src) {
+  RTC_DCHECK_RUNS_SERIALIZED(&render_race_checker_);
+  if (file_closed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  render_event_.Clear();
+  render_event_.set_type(audioproc::Event::REVERSE_STREAM);
+
+  audioproc::ReverseStream* msg = render_event_.mutable_reverse_stream();
+
+  for (int i = 0; i < src.num_channels(); ++i) {
+    const auto& channel_view = src.channel(i);
+    msg->add_channel(channel_view.data(), sizeof(float) * channel_view.size());
+  }
+
+  Enqueue(render_event_);
+}
+
+void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
+  audioproc::Event event;
+  event.set_type(audioproc::Event::CONFIG);
+  CopyFromConfigToEvent(config, event.mutable_config());
+  Enqueue(event);
+}
+
+void AecDumpImpl::WriteRuntimeSetting(
+    const AudioProcessing::RuntimeSetting& runtime_setting) {
+  audioproc::Event event;
+  event.set_type(audioproc::Event::RUNTIME_SETTING);
+  audioproc::RuntimeSetting* setting = event.mutable_runtime_setting();
+  switch (runtime_setting.type()) {
+    case AudioProcessing::RuntimeSetting::Type::kCapturePreGain: {
+      float x;
+      runtime_setting.GetFloat(&x);
+      setting->set_capture_pre_gain(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kCapturePostGain: {
+      float x;
+      runtime_setting.GetFloat(&x);
+      setting->set_capture_post_gain(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::
+        kCustomRenderProcessingRuntimeSetting: {
+      float x;
+      runtime_setting.GetFloat(&x);
+      setting->set_custom_render_processing_setting(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kCaptureCompressionGain:
+      // The AGC1 compression gain has no field in debug.proto.
+      return;
+    case AudioProcessing::RuntimeSetting::Type::kCaptureFixedPostGain: {
+      float x;
+      runtime_setting.GetFloat(&x);
+      setting->set_capture_fixed_post_gain(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kCaptureOutputUsed: {
+      bool x;
+      runtime_setting.GetBool(&x);
+      setting->set_capture_output_used(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kPlayoutVolumeChange: {
+      int x;
+      runtime_setting.GetInt(&x);
+      setting->set_playout_volume_change(x);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kPlayoutAudioDeviceChange: {
+      AudioProcessing::RuntimeSetting::PlayoutAudioDeviceInfo src;
+      runtime_setting.GetPlayoutAudioDeviceInfo(&src);
+      auto* dst = setting->mutable_playout_audio_device_change();
+      dst->set_id(src.id);
+      dst->set_max_volume(src.max_volume);
+      break;
+    }
+    case AudioProcessing::RuntimeSetting::Type::kNotSpecified:
+      RTC_DCHECK_NOTREACHED();
+      return;
+  }
+  Enqueue(event);
+}
+
+void AecDumpImpl::Enqueue(const audioproc::Event& event) {
+  // Nothing more can be written once the file is closed, so the event is not
+  // serialized.
+  if (file_closed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (!queue_.Insert(event)) {
+    num_dropped_events_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // The writer is signaled for every event. A task may find its event already
+  // written by an earlier one, but an event that is published after a task
+  // has stopped draining is never left waiting for the next event.
+  worker_queue_->PostTask([this] { WritePendingEvents(); });
+}
+
+void AecDumpImpl::WritePendingEvents() {
+  RTC_DCHECK(worker_queue_->IsCurrent());
+  const int num_dropped_events =
+      num_dropped_events_.exchange(0, std::memory_order_relaxed);
+  if (num_dropped_events > 0) {
+    RTC_LOG(LS_WARNING) << "AecDump dropped " << num_dropped_events
+                        << " events since the writer fell behind.";
+  }
+
+  for (const std::string* event = queue_.Front(); event != nullptr;
+       queue_.PopFront(), event = queue_.Front()) {
+    if (!debug_file_.is_open()) {
+      continue;
+    }
+
+    const int32_t event_byte_size = static_cast<int32_t>(event->size());
+    if (num_bytes_left_for_log_ >= 0) {
+      // The size of the event is written before the event itself.
+      const int64_t bytes_needed = event_byte_size + sizeof(int32_t);
+      if (num_bytes_left_for_log_ < bytes_needed) {
+        // Ensure that the file is never larger than the maximum size.
+        debug_file_.Close();
+        file_closed_.store(true, std::memory_order_relaxed);
+        continue;
+      }
+      num_bytes_left_for_log_ -= bytes_needed;
+    }
+
+    // Write message preceded by its size.
+    if (!debug_file_.Write(&event_byte_size, sizeof(int32_t)) ||
+        !debug_file_.Write(event->data(), event->size())) {
+      RTC_LOG(LS_ERROR) << "AecDump failed to write to the debug file.";
+      debug_file_.Close();
+      file_closed_.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    FileWrapper file,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  RTC_DCHECK(worker_queue);
+  if (!file.is_open())
+    return nullptr;
+
+  return std::make_unique<AecDumpImpl>(std::move(file), max_log_size_bytes,
+                                       worker_queue);
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    absl::string_view file_name,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  return Create(FileWrapper::OpenWriteOnly(file_name), max_log_size_bytes,
+                worker_queue);
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    absl::Nonnull<FILE*> handle,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  return Create(FileWrapper(handle), max_log_size_bytes, worker_queue);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_AEC_DUMP_IMPL_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_AEC_DUMP_IMPL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "api/task_queue/task_queue_base.h"
+#include "modules/audio_processing/aec_dump/capture_stream_info.h"
+#include "modules/audio_processing/include/aec_dump.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/thread_annotations.h"
+
+// Files generated at build-time by the protobuf compiler.
+#include "modules/audio_processing/debug.pb.h"
+
+namespace webrtc {
+
+// Task-queue based implementation of AecDump. The events are serialized on
+// the calling thread into a fixed number of preallocated slots of a lock-free
+// queue, and written to file on `worker_queue`. If the worker falls behind so
+// that the queue is full, events are dropped instead of blocking the audio
+// threads. Once the file is closed, e.g. when the maximum log size is reached,
+// the events are no longer serialized. It is thread safe.
+class AecDumpImpl : public AecDump {
+ public:
+  // `max_log_size_bytes` - maximum number of bytes to write to the debug file,
+  // `max_log_size_bytes == -1` means the log size will be unlimited.
+  AecDumpImpl(FileWrapper debug_file,
+              int64_t max_log_size_bytes,
+              TaskQueueBase* worker_queue);
+  AecDumpImpl(const AecDumpImpl&) = delete;
+  AecDumpImpl& operator=(const AecDumpImpl&) = delete;
+  ~AecDumpImpl() override;
+
+  void WriteInitMessage(const ProcessingConfig& api_format,
+                        int64_t time_now_ms) override;
+  void AddCaptureStreamInput(const AudioFrameView<const float>& src) override;
+  void AddCaptureStreamOutput(const AudioFrameView<const float>& src) override;
+  void AddCaptureStreamInput(const int16_t* const data,
+                             int num_channels,
+                             int samples_per_channel) override;
+  void AddCaptureStreamOutput(const int16_t* const data,
+                              int num_channels,
+                              int samples_per_channel) override;
+  void AddAudioProcessingState(const AudioProcessingState& state) override;
+  void WriteCaptureStreamMessage() override;
+
+  void WriteRenderStreamMessage(const int16_t* const data,
+                                int num_channels,
+                                int samples_per_channel) override;
+  void WriteRenderStreamMessage(
+      const AudioFrameView<const float>& src) override;
+
+  void WriteConfig(const InternalAPMConfig& config) override;
+
+  void WriteRuntimeSetting(
+      const AudioProcessing::RuntimeSetting& runtime_setting) override;
+
+ private:
+  // Bounded multi-producer single-consumer queue of serialized events. The
+  // producers claim a slot with a compare-and-swap and never wait for the
+  // consumer.
+  class EventQueue {
+   public:
+    // `size` must be a power of two.
+    explicit EventQueue(size_t size);
+    ~EventQueue();
+
+    // Serializes `event` into the next free slot. Returns false if the queue
+    // is full.
+    bool Insert(const audioproc::Event& event);
+
+    // Returns the oldest serialized event, or null if there is none. The event
+    // stays valid until PopFront() is called.
+    const std::string* Front();
+    void PopFront();
+
+   private:
+    struct Slot;
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> insert_position_;
+    size_t read_position_;
+  };
+
+  void Enqueue(const audioproc::Event& event);
+  void WritePendingEvents();
+
+  TaskQueueBase* const worker_queue_;
+  EventQueue queue_;
+  std::atomic<int> num_dropped_events_;
+  // Set on `worker_queue_` when `debug_file_` is closed.
+  std::atomic<bool> file_closed_;
+
+  // Only accessed on `worker_queue_`.
+  FileWrapper debug_file_;
+  int64_t num_bytes_left_for_log_;
+
+  rtc::RaceChecker capture_race_checker_;
+  rtc::RaceChecker render_race_checker_;
+  CaptureStreamInfo capture_stream_info_ RTC_GUARDED_BY(capture_race_checker_);
+  audioproc::Event render_event_ RTC_GUARDED_BY(render_race_checker_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_AEC_DUMP_IMPL_H_
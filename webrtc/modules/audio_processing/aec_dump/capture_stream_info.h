@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_CAPTURE_STREAM_INFO_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_CAPTURE_STREAM_INFO_H_
+
+#include <stdint.h>
+
+#include "modules/audio_processing/include/aec_dump.h"
+#include "modules/audio_processing/include/audio_frame_view.h"
+
+// Files generated at build-time by the protobuf compiler.
+#include "modules/audio_processing/debug.pb.h"
+
+namespace webrtc {
+
+// Collects the input, output and state of a capture frame into a STREAM
+// event. The event is reused between frames, so that its buffers are only
+// allocated when the stream format grows.
+class CaptureStreamInfo {
+ public:
+  CaptureStreamInfo();
+  ~CaptureStreamInfo();
+
+  CaptureStreamInfo(const CaptureStreamInfo&) = delete;
+  CaptureStreamInfo& operator=(const CaptureStreamInfo&) = delete;
+
+  void AddInput(const AudioFrameView<const float>& src);
+  void AddOutput(const AudioFrameView<const float>& src);
+
+  void AddInput(const int16_t* const data,
+                int num_channels,
+                int samples_per_channel);
+  void AddOutput(const int16_t* const data,
+                 int num_channels,
+                 int samples_per_channel);
+
+  void AddAudioProcessingState(const AecDump::AudioProcessingState& state);
+
+  const audioproc::Event& event() const { return event_; }
+
+  // Clears the collected data while keeping the allocated buffers.
+  void Clear();
+
+ private:
+  audioproc::Event event_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_CAPTURE_STREAM_INFO_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aecm/aecm_core.h"
+
+namespace webrtc {
+
+namespace {
+
+// Computes the 32 bit products of the signed 16 bit values in `a` and the
+// unsigned 16 bit values in `b`, as WEBRTC_SPL_MUL_16_U16() does. The products
+// of the lower and upper eight elements are returned in `low` and `high`.
+inline void MultiplySignedUnsigned(__m256i a,
+                                   __m256i b,
+                                   __m256i* low,
+                                   __m256i* high) {
+  const __m256i product_low = _mm256_mullo_epi16(a, b);
+  // The unsigned high half is corrected by subtracting `b` where `a` is
+  // negative.
+  const __m256i product_high = _mm256_sub_epi16(
+      _mm256_mulhi_epu16(a, b), _mm256_and_si256(_mm256_srai_epi16(a, 15), b));
+  // The unpacking operates within 128 bit lanes, so the halves are reordered
+  // to restore the element order.
+  const __m256i unpacked_low = _mm256_unpacklo_epi16(product_low, product_high);
+  const __m256i unpacked_high =
+      _mm256_unpackhi_epi16(product_low, product_high);
+  *low = _mm256_permute2x128_si256(unpacked_low, unpacked_high, 0x20);
+  *high = _mm256_permute2x128_si256(unpacked_low, unpacked_high, 0x31);
+}
+
+inline uint32_t AddLanes(__m256i v) {
+  __m128i v128 = _mm_add_epi32(_mm256_castsi256_si128(v),
+                               _mm256_extracti128_si256(v, 1));
+  v128 = _mm_add_epi32(v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(1, 0, 3, 2)));
+  v128 = _mm_add_epi32(v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(v128));
+}
+
+}  // namespace
+
+void WebRtcAecm_CalcLinearEnergiesAvx2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i far_energy_v = zero;
+  __m256i echo_adapt_v = zero;
+  __m256i echo_stored_v = zero;
+
+  // Get energy for the delayed far end signal and estimated
+  // echo using both stored and adapted channels.
+  for (int i = 0; i < PART_LEN; i += 16) {
+    const __m256i spectrum_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&far_spectrum[i]));
+    const __m256i stored_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelStored[i]));
+    const __m256i adapt_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelAdapt16[i]));
+
+    // The order of the elements does not matter for the sums.
+    far_energy_v =
+        _mm256_add_epi32(far_energy_v, _mm256_unpacklo_epi16(spectrum_v, zero));
+    far_energy_v =
+        _mm256_add_epi32(far_energy_v, _mm256_unpackhi_epi16(spectrum_v, zero));
+
+    __m256i echo_est_low, echo_est_high;
+    MultiplySignedUnsigned(stored_v, spectrum_v, &echo_est_low,
+                           &echo_est_high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i]),
+                        echo_est_low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i + 8]),
+                        echo_est_high);
+    echo_stored_v = _mm256_add_epi32(echo_stored_v, echo_est_low);
+    echo_stored_v = _mm256_add_epi32(echo_stored_v, echo_est_high);
+
+    __m256i echo_adapt_low, echo_adapt_high;
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &echo_adapt_low,
+                           &echo_adapt_high);
+    echo_adapt_v = _mm256_add_epi32(echo_adapt_v, echo_adapt_low);
+    echo_adapt_v = _mm256_add_epi32(echo_adapt_v, echo_adapt_high);
+  }
+
+  *far_energy += AddLanes(far_energy_v);
+  *echo_energy_stored += AddLanes(echo_stored_v);
+  *echo_energy_adapt += AddLanes(echo_adapt_v);
+
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+  *echo_energy_stored += (uint32_t)echo_est[PART_LEN];
+  *far_energy += (uint32_t)far_spectrum[PART_LEN];
+  *echo_energy_adapt += aecm->channelAdapt16[PART_LEN] * far_spectrum[PART_LEN];
+}
+
+void WebRtcAecm_StoreAdaptiveChannelAvx2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est) {
+  // During startup we store the channel every block, and recalculate the echo
+  // estimate.
+  for (int i = 0; i < PART_LEN; i += 16) {
+    const __m256i spectrum_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&far_spectrum[i]));
+    const __m256i adapt_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelAdapt16[i]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&aecm->channelStored[i]),
+                        adapt_v);
+
+    __m256i echo_est_low, echo_est_high;
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &echo_est_low,
+                           &echo_est_high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i]),
+                        echo_est_low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i + 8]),
+                        echo_est_high);
+  }
+  aecm->channelStored[PART_LEN] = aecm->channelAdapt16[PART_LEN];
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+}
+
+void WebRtcAecm_ResetAdaptiveChannelAvx2(AecmCore* aecm) {
+  // The stored channel has a significantly lower MSE than the adaptive one for
+  // two consecutive calculations. Reset the adaptive channel and restore the
+  // W32 channel, where sign extension followed by a shift gives the left shift
+  // by 16.
+  for (int i = 0; i < PART_LEN; i += 16) {
+    const __m256i stored_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelStored[i]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&aecm->channelAdapt16[i]),
+                        stored_v);
+    const __m256i adapt32_low = _mm256_slli_epi32(
+        _mm256_cvtepi16_epi32(_mm256_castsi256_si128(stored_v)), 16);
+    const __m256i adapt32_high = _mm256_slli_epi32(
+        _mm256_cvtepi16_epi32(_mm256_extracti128_si256(stored_v, 1)), 16);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&aecm->channelAdapt32[i]),
+                        adapt32_low);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(&aecm->channelAdapt32[i + 8]),
+        adapt32_high);
+  }
+  aecm->channelAdapt16[PART_LEN] = aecm->channelStored[PART_LEN];
+  aecm->channelAdapt32[PART_LEN] = (int32_t)aecm->channelStored[PART_LEN] << 16;
+}
+
+}  // namespace webrtc
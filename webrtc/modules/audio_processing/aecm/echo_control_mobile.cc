@@ -88,6 +88,14 @@ static int WebRtcAecm_EstBufDelay(AecMobile* aecm, short msInSndCardBuf);
 // Stuffs the farend buffer if the estimated delay is too large
 static int WebRtcAecm_DelayComp(AecMobile* aecm);
 
+// Runs the AECM on an instance for which the arguments have been checked.
+static int32_t WebRtcAecm_ProcessInstance(AecMobile* aecm,
+                                          const int16_t* nearendNoisy,
+                                          const int16_t* nearendClean,
+                                          int16_t* out,
+                                          size_t nrOfSamples,
+                                          int16_t msInSndCardBuf);
+
 void* WebRtcAecm_Create() {
   // Allocate zero-filled memory.
   AecMobile* aecm = static_cast<AecMobile*>(calloc(1, sizeof(AecMobile)));
@@ -141,6 +149,20 @@ void WebRtcAecm_Free(void* aecmInst) {
   free(aecm);
 }
 
+static size_t RingBufferMemoryUsage(const RingBuffer* buffer) {
+  return sizeof(RingBuffer) + buffer->element_count * buffer->element_size;
+}
+
+size_t WebRtcAecm_MemoryUsage(const void* aecmInst) {
+  const AecMobile* aecm = static_cast<const AecMobile*>(aecmInst);
+  const AecmCore* core = aecm->aecmCore;
+  return sizeof(AecMobile) + RingBufferMemoryUsage(aecm->farendBuf) +
+         sizeof(AecmCore) + RingBufferMemoryUsage(core->farFrameBuf) +
+         RingBufferMemoryUsage(core->nearNoisyFrameBuf) +
+         RingBufferMemoryUsage(core->nearCleanFrameBuf) +
+         RingBufferMemoryUsage(core->outFrameBuf);
+}
+
 int32_t WebRtcAecm_Init(void* aecmInst, int32_t sampFreq) {
   AecMobile* aecm = static_cast<AecMobile*>(aecmInst);
   AecmConfig aecConfig;
@@ -242,14 +264,6 @@ int32_t WebRtcAecm_Process(void* aecmInst,
                            size_t nrOfSamples,
                            int16_t msInSndCardBuf) {
   AecMobile* aecm = static_cast<AecMobile*>(aecmInst);
-  int32_t retVal = 0;
-  size_t i;
-  short nmbrOfFilledBuffers;
-  size_t nBlocks10ms;
-  size_t nFrames;
-#ifdef AEC_DEBUG
-  short msInAECBuf;
-#endif
 
   if (aecm == NULL) {
     return -1;
@@ -271,6 +285,84 @@ int32_t WebRtcAecm_Process(void* aecmInst,
     return AECM_BAD_PARAMETER_ERROR;
   }
 
+  return WebRtcAecm_ProcessInstance(aecm, nearendNoisy, nearendClean, out,
+                                    nrOfSamples, msInSndCardBuf);
+}
+
+size_t WebRtcAecm_BufferFarendBatch(void* const* aecmInsts,
+                                    size_t numInstances,
+                                    const int16_t* farend,
+                                    size_t nrOfSamples,
+                                    int32_t* retVals) {
+  size_t numErrors = 0;
+  for (size_t k = 0; k < numInstances; k++) {
+    retVals[k] = WebRtcAecm_BufferFarend(
+        aecmInsts[k], farend ? &farend[k * nrOfSamples] : NULL, nrOfSamples);
+    if (retVals[k] != 0) {
+      numErrors++;
+    }
+  }
+  return numErrors;
+}
+
+size_t WebRtcAecm_ProcessBatch(void* const* aecmInsts,
+                               size_t numInstances,
+                               const int16_t* nearendNoisy,
+                               const int16_t* nearendClean,
+                               int16_t* out,
+                               size_t nrOfSamples,
+                               const int16_t* msInSndCardBuf,
+                               int32_t* retVals) {
+  size_t k;
+  int32_t batchError = 0;
+  size_t numErrors = 0;
+
+  // The checks that apply to the whole batch are only done once.
+  if (nearendNoisy == NULL || out == NULL || msInSndCardBuf == NULL) {
+    batchError = AECM_NULL_POINTER_ERROR;
+  } else if (nrOfSamples != 80 && nrOfSamples != 160) {
+    batchError = AECM_BAD_PARAMETER_ERROR;
+  }
+
+  for (k = 0; k < numInstances; k++) {
+    AecMobile* aecm = static_cast<AecMobile*>(aecmInsts[k]);
+    const size_t offset = k * nrOfSamples;
+
+    if (batchError != 0) {
+      retVals[k] = batchError;
+    } else if (aecm == NULL) {
+      retVals[k] = -1;
+    } else if (aecm->initFlag != kInitCheck) {
+      retVals[k] = AECM_UNINITIALIZED_ERROR;
+    } else {
+      retVals[k] = WebRtcAecm_ProcessInstance(
+          aecm, &nearendNoisy[offset],
+          nearendClean ? &nearendClean[offset] : NULL, &out[offset],
+          nrOfSamples, msInSndCardBuf[k]);
+    }
+
+    if (retVals[k] != 0 && retVals[k] != AECM_BAD_PARAMETER_WARNING) {
+      numErrors++;
+    }
+  }
+  return numErrors;
+}
+
+static int32_t WebRtcAecm_ProcessInstance(AecMobile* aecm,
+                                          const int16_t* nearendNoisy,
+                                          const int16_t* nearendClean,
+                                          int16_t* out,
+                                          size_t nrOfSamples,
+                                          int16_t msInSndCardBuf) {
+  int32_t retVal = 0;
+  size_t i;
+  short nmbrOfFilledBuffers;
+  size_t nBlocks10ms;
+  size_t nFrames;
+#ifdef AEC_DEBUG
+  short msInAECBuf;
+#endif
+
   if (msInSndCardBuf < 0) {
     msInSndCardBuf = 0;
     retVal = AECM_BAD_PARAMETER_WARNING;
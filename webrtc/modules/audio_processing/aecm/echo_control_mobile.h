@@ -53,6 +53,16 @@ void* WebRtcAecm_Create();
  */
 void WebRtcAecm_Free(void* aecmInst);
 
+/*
+ * Returns the size of the memory allocated by WebRtcAecm_Create(), apart from
+ * the small delay estimator states.
+ *
+ * Inputs                       Description
+ * -------------------------------------------------------------------
+ * void*    aecmInst            Pointer to the AECM instance
+ */
+size_t WebRtcAecm_MemoryUsage(const void* aecmInst);
+
 /*
  * Initializes an AECM instance.
  *
@@ -138,6 +148,74 @@ int32_t WebRtcAecm_Process(void* aecmInst,
                            size_t nrOfSamples,
                            int16_t msInSndCardBuf);
 
+/*
+ * Inserts an 80 or 160 sample block of farend data into the farend buffers of
+ * several independent AECM instances. The data is laid out instance by
+ * instance, i.e., the samples of instance k start at farend[k * nrOfSamples].
+ *
+ * Inputs                       Description
+ * -------------------------------------------------------------------
+ * void* const*   aecmInsts     Pointers to the AECM instances
+ * size_t         numInstances  Number of AECM instances
+ * int16_t*       farend        In buffer containing one frame of
+ *                              farend signal per instance
+ * int16_t        nrOfSamples   Number of samples per instance
+ *
+ * Outputs                      Description
+ * -------------------------------------------------------------------
+ * int32_t*       retVals       Per instance return values, see
+ *                              WebRtcAecm_BufferFarend()
+ * size_t         return        Number of instances for which an
+ *                              error was returned
+ */
+size_t WebRtcAecm_BufferFarendBatch(void* const* aecmInsts,
+                                    size_t numInstances,
+                                    const int16_t* farend,
+                                    size_t nrOfSamples,
+                                    int32_t* retVals);
+
+/*
+ * Runs several independent AECM instances, which must all have been
+ * initialized with the same sampling frequency, on an 80 or 160 sample block
+ * of data each. The data is laid out instance by instance, i.e., the samples
+ * of instance k start at k * nrOfSamples in each of the buffers. This avoids
+ * one call, with its argument checks, per instance when a large number of
+ * calls are processed together.
+ *
+ * Inputs                        Description
+ * -------------------------------------------------------------------
+ * void* const*   aecmInsts      Pointers to the AECM instances
+ * size_t         numInstances   Number of AECM instances
+ * int16_t*       nearendNoisy   In buffer containing one frame of
+ *                               reference nearend+echo signal per
+ *                               instance
+ * int16_t*       nearendClean   In buffer containing one frame of
+ *                               nearend+echo signal per instance, or
+ *                               a NULL pointer, as for
+ *                               WebRtcAecm_Process()
+ * int16_t        nrOfSamples    Number of samples per instance
+ * int16_t*       msInSndCardBuf Per instance delay estimates for sound
+ *                               card and system buffers
+ *
+ * Outputs                       Description
+ * -------------------------------------------------------------------
+ * int16_t*       out            Out buffer, one frame of processed
+ *                               nearend per instance
+ * int32_t*       retVals        Per instance return values, see
+ *                               WebRtcAecm_Process()
+ * size_t         return         Number of instances for which an
+ *                               error, not counting warnings, was
+ *                               returned
+ */
+size_t WebRtcAecm_ProcessBatch(void* const* aecmInsts,
+                               size_t numInstances,
+                               const int16_t* nearendNoisy,
+                               const int16_t* nearendClean,
+                               int16_t* out,
+                               size_t nrOfSamples,
+                               const int16_t* msInSndCardBuf,
+                               int32_t* retVals);
+
 /*
  * This function enables the user to set certain parameters on-the-fly
  *
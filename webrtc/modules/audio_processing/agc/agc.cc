@@ -17,6 +17,7 @@
 #include "modules/audio_processing/agc/loudness_histogram.h"
 #include "modules/audio_processing/agc/utility.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace {
@@ -95,4 +96,9 @@ float Agc::voice_probability() const {
   return vad_.last_voice_probability();
 }
 
+size_t Agc::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(histogram_) +
+         HeapBytes(inactive_histogram_) + HeapBytes(vad_);
+}
+
 }  // namespace webrtc
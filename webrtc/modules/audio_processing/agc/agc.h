@@ -39,6 +39,9 @@ class Agc {
   virtual int target_level_dbfs() const;
   virtual float voice_probability() const;
 
+  // Returns the size of the AGC, including its loudness histograms and VAD.
+  virtual size_t MemoryUsage() const;
+
  private:
   double target_level_loudness_;
   int target_level_dbfs_;
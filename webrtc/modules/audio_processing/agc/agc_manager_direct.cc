@@ -503,6 +503,11 @@ AgcManagerDirect::AgcManagerDirect(int num_capture_channels,
 
 AgcManagerDirect::~AgcManagerDirect() {}
 
+size_t AgcManagerDirect::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(channel_agcs_) +
+         HeapBytes(new_compressions_to_set_);
+}
+
 void AgcManagerDirect::Initialize() {
   RTC_DLOG(LS_INFO) << "AgcManagerDirect::Initialize";
   data_dumper_->InitiateNewSetOfRecordings();
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -110,6 +111,9 @@ class AgcManagerDirect final {
     return use_clipping_predictor_step_;
   }
 
+  // Returns the size of the manager and of its per-channel AGCs.
+  size_t MemoryUsage() const;
+
  private:
   friend class AgcManagerDirectTestHelper;
 
@@ -226,6 +230,8 @@ class MonoAgc {
   void set_agc(Agc* agc) { agc_.reset(agc); }
   int min_mic_level() const { return min_mic_level_; }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(agc_); }
+
  private:
   // Sets a new input volume, after first checking that it hasn't been updated
   // by the user, in which case no action is taken.
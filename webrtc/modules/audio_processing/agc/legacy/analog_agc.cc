@@ -932,15 +932,19 @@ int32_t WebRtcAgc_ProcessAnalog(void* state,
   return 0;
 }
 
-int WebRtcAgc_Analyze(void* agcInst,
-                      const int16_t* const* in_near,
-                      size_t num_bands,
-                      size_t samples,
-                      int32_t inMicLevel,
-                      int32_t* outMicLevel,
-                      int16_t echo,
-                      uint8_t* saturationWarning,
-                      int32_t gains[11]) {
+namespace {
+
+// Shared implementation of WebRtcAgc_Analyze() and WebRtcAgc_AnalyzeFloat(),
+// where `compute_digital_gains` computes the digital gains of the frame and
+// returns -1 on error.
+template <typename ComputeDigitalGains>
+int Analyze(void* agcInst,
+            size_t samples,
+            int32_t inMicLevel,
+            int32_t* outMicLevel,
+            int16_t echo,
+            uint8_t* saturationWarning,
+            ComputeDigitalGains compute_digital_gains) {
   LegacyAgc* stt = reinterpret_cast<LegacyAgc*>(agcInst);
 
   if (stt == NULL) {
@@ -963,10 +967,7 @@ int WebRtcAgc_Analyze(void* agcInst,
   // TODO(minyue): PUT IN RANGE CHECKING FOR INPUT LEVELS
   *outMicLevel = inMicLevel;
 
-  int32_t error =
-      WebRtcAgc_ComputeDigitalGains(&stt->digitalAgc, in_near, num_bands,
-                                    stt->fs, stt->lowLevelSignal, gains);
-  if (error == -1) {
+  if (compute_digital_gains(stt) == -1) {
     return -1;
   }
 
@@ -992,6 +993,41 @@ int WebRtcAgc_Analyze(void* agcInst,
   return 0;
 }
 
+}  // namespace
+
+int WebRtcAgc_Analyze(void* agcInst,
+                      const int16_t* const* in_near,
+                      size_t num_bands,
+                      size_t samples,
+                      int32_t inMicLevel,
+                      int32_t* outMicLevel,
+                      int16_t echo,
+                      uint8_t* saturationWarning,
+                      int32_t gains[11]) {
+  return Analyze(agcInst, samples, inMicLevel, outMicLevel, echo,
+                 saturationWarning, [&](LegacyAgc* stt) {
+                   return WebRtcAgc_ComputeDigitalGains(
+                       &stt->digitalAgc, in_near, num_bands, stt->fs,
+                       stt->lowLevelSignal, gains);
+                 });
+}
+
+int WebRtcAgc_AnalyzeFloat(void* agcInst,
+                           const float* in_near,
+                           size_t samples,
+                           int32_t inMicLevel,
+                           int32_t* outMicLevel,
+                           int16_t echo,
+                           uint8_t* saturationWarning,
+                           float gains[11]) {
+  return Analyze(agcInst, samples, inMicLevel, outMicLevel, echo,
+                 saturationWarning, [&](LegacyAgc* stt) {
+                   return WebRtcAgc_ComputeDigitalGainsFloat(
+                       &stt->digitalAgc, in_near, stt->fs,
+                       stt->lowLevelSignal, gains);
+                 });
+}
+
 int WebRtcAgc_Process(const void* agcInst,
                       const int32_t gains[11],
                       const int16_t* const* in_near,
@@ -1090,6 +1126,10 @@ void WebRtcAgc_Free(void* state) {
   free(stt);
 }
 
+size_t WebRtcAgc_MemoryUsage() {
+  return sizeof(LegacyAgc);
+}
+
 /* minLevel     - Minimum volume level
  * maxLevel     - Maximum volume level
  */
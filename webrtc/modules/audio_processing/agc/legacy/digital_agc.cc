@@ -12,6 +12,10 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <cmath>
+
+#include "common_audio/include/audio_util.h"
 #include "modules/audio_processing/agc/legacy/gain_control.h"
 #include "rtc_base/checks.h"
 
@@ -61,6 +65,75 @@ static const int16_t kAvgDecayTime = 250;  // frames; < 3000
 #define AGC_SCALEDIFF32(A, B, C) \
   ((C) + ((B) >> 16) * (A) + (((0x0000FFFF & (B)) * (A)) >> 16))
 
+// Runs the near end VAD on `in_near` and returns the decay factor of the slow
+// envelope follower (Q16).
+int16_t ComputeDecay(DigitalAgc* stt,
+                     const int16_t* in_near,
+                     size_t num_samples,
+                     int16_t lowlevelSignal) {
+  // VAD for near end
+  int16_t logratio =
+      WebRtcAgc_ProcessVad(&stt->vadNearend, in_near, num_samples);
+
+  // Account for far end VAD
+  if (stt->vadFarend.counter > 10) {
+    int32_t tmp32 = 3 * logratio;
+    logratio = (int16_t)((tmp32 - stt->vadFarend.logRatio) >> 2);
+  }
+
+  // Determine decay factor depending on VAD
+  //  upper_thr = 1.0f;
+  //  lower_thr = 0.25f;
+  const int16_t upper_thr = 1024;  // Q10
+  const int16_t lower_thr = 0;     // Q10
+  int16_t decay;
+  if (logratio > upper_thr) {
+    // decay = -2^17 / DecayTime;  ->  -65
+    decay = -65;
+  } else if (logratio < lower_thr) {
+    decay = 0;
+  } else {
+    // decay = (int16_t)(((lower_thr - logratio)
+    //       * (2^27/(DecayTime*(upper_thr-lower_thr)))) >> 10);
+    // SUBSTITUTED: 2^27/(DecayTime*(upper_thr-lower_thr))  ->  65
+    int32_t tmp32 = (lower_thr - logratio) * 65;
+    decay = (int16_t)(tmp32 >> 10);
+  }
+
+  // adjust decay factor for long silence (detected as low standard deviation)
+  // This is only done in the adaptive modes
+  if (stt->agcMode != kAgcModeFixedDigital) {
+    if (stt->vadNearend.stdLongTerm < 4000) {
+      decay = 0;
+    } else if (stt->vadNearend.stdLongTerm < 8096) {
+      // decay = (int16_t)(((stt->vadNearend.stdLongTerm - 4000) * decay) >>
+      // 12);
+      int32_t tmp32 = (stt->vadNearend.stdLongTerm - 4000) * decay;
+      decay = (int16_t)(tmp32 >> 12);
+    }
+
+    if (lowlevelSignal != 0) {
+      decay = 0;
+    }
+  }
+  return decay;
+}
+
+// Floating point counterpart of the leading zeros and Q12 fraction computed
+// from a level in WebRtcAgc_ComputeDigitalGains(): returns 31 - log2(level)
+// rounded up, and sets `fraction` to the position of `level` between the
+// two neighboring powers of two.
+int LevelToZeros(float level, float* fraction) {
+  if (level < 1.f) {
+    *fraction = 0.f;
+    return 31;
+  }
+  int exponent;
+  const float mantissa = std::frexp(level, &exponent);
+  *fraction = 2.f * mantissa - 1.f;
+  return std::max(1, 32 - exponent);
+}
+
 }  // namespace
 
 int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,       // Q16
@@ -251,6 +324,12 @@ int32_t WebRtcAgc_InitDigital(DigitalAgc* stt, int16_t agcMode) {
   stt->gatePrevious = 0;
   stt->agcMode = agcMode;
 
+  stt->capacitorSlowFloat =
+      agcMode == kAgcModeFixedDigital ? 0.f : 0.125f * 32768.f * 32768.f;
+  stt->capacitorFastFloat = 0.f;
+  stt->gainFloat = 1.f;
+  stt->gatePreviousFloat = 0.f;
+
   // initialize VADs
   WebRtcAgc_InitVad(&stt->vadNearend);
   WebRtcAgc_InitVad(&stt->vadFarend);
@@ -280,8 +359,6 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
   int32_t max_nrg;
   int32_t cur_level;
   int32_t gain32;
-  int16_t logratio;
-  int16_t lower_thr, upper_thr;
   int16_t zeros = 0, zeros_fast, frac = 0;
   int16_t decay;
   int16_t gate, gain_adj;
@@ -297,49 +374,8 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
     return -1;
   }
 
-  // VAD for near end
-  logratio = WebRtcAgc_ProcessVad(&stt->vadNearend, in_near[0], L * 10);
-
-  // Account for far end VAD
-  if (stt->vadFarend.counter > 10) {
-    tmp32 = 3 * logratio;
-    logratio = (int16_t)((tmp32 - stt->vadFarend.logRatio) >> 2);
-  }
-
-  // Determine decay factor depending on VAD
-  //  upper_thr = 1.0f;
-  //  lower_thr = 0.25f;
-  upper_thr = 1024;  // Q10
-  lower_thr = 0;     // Q10
-  if (logratio > upper_thr) {
-    // decay = -2^17 / DecayTime;  ->  -65
-    decay = -65;
-  } else if (logratio < lower_thr) {
-    decay = 0;
-  } else {
-    // decay = (int16_t)(((lower_thr - logratio)
-    //       * (2^27/(DecayTime*(upper_thr-lower_thr)))) >> 10);
-    // SUBSTITUTED: 2^27/(DecayTime*(upper_thr-lower_thr))  ->  65
-    tmp32 = (lower_thr - logratio) * 65;
-    decay = (int16_t)(tmp32 >> 10);
-  }
-
-  // adjust decay factor for long silence (detected as low standard deviation)
-  // This is only done in the adaptive modes
-  if (stt->agcMode != kAgcModeFixedDigital) {
-    if (stt->vadNearend.stdLongTerm < 4000) {
-      decay = 0;
-    } else if (stt->vadNearend.stdLongTerm < 8096) {
-      // decay = (int16_t)(((stt->vadNearend.stdLongTerm - 4000) * decay) >>
-      // 12);
-      tmp32 = (stt->vadNearend.stdLongTerm - 4000) * decay;
-      decay = (int16_t)(tmp32 >> 12);
-    }
+  decay = ComputeDecay(stt, in_near[0], L * 10, lowlevelSignal);
 
-    if (lowlevelSignal != 0) {
-      decay = 0;
-    }
-  }
   // Find max amplitude per sub frame
   // iterate over sub frames
   for (k = 0; k < 10; k++) {
@@ -473,6 +509,114 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
   return 0;
 }
 
+int32_t WebRtcAgc_ComputeDigitalGainsFloat(DigitalAgc* stt,
+                                           const float* in_near,
+                                           uint32_t FS,
+                                           int16_t lowlevelSignal,
+                                           float gains[11]) {
+  constexpr float kQ16ToLinear = 1.f / 65536.f;
+  constexpr float kFastDecay = 1.f - 1000.f * kQ16ToLinear;
+  constexpr float kSlowAttack = 500.f * kQ16ToLinear;
+  constexpr float kMaxAbsSample = 32768.f;
+  // Maximum energy times squared gain before the limiter kicks in.
+  constexpr float kMaxOutputEnergy = 32767.f * 32768.f;
+  // Corresponds to -0.1 dB.
+  constexpr float kLimiterStep = 253.f / 256.f;
+  size_t L;
+
+  // determine number of samples per ms
+  if (FS == 8000) {
+    L = 8;
+  } else if (FS == 16000 || FS == 32000 || FS == 48000) {
+    L = 16;
+  } else {
+    return -1;
+  }
+
+  // The VAD operates on 16 bit samples.
+  int16_t in_near_s16[160];
+  FloatS16ToS16(in_near, L * 10, in_near_s16);
+  const float decay =
+      ComputeDecay(stt, in_near_s16, L * 10, lowlevelSignal) * kQ16ToLinear;
+
+  // Find max energy per sub frame.
+  float env[10];
+  for (size_t k = 0; k < 10; ++k) {
+    float max_abs = 0.f;
+    for (size_t n = 0; n < L; ++n) {
+      max_abs = std::max(max_abs, std::fabs(in_near[k * L + n]));
+    }
+    max_abs = std::min(max_abs, kMaxAbsSample);
+    env[k] = max_abs * max_abs;
+  }
+
+  // Calculate gain per sub frame.
+  const float min_gain = stt->gainTable[0] * kQ16ToLinear;
+  int zeros = 31;
+  float fraction = 0.f;
+  gains[0] = stt->gainFloat;
+  for (size_t k = 0; k < 10; ++k) {
+    // Fast envelope follower, decay time 131 ms.
+    stt->capacitorFastFloat =
+        std::max(stt->capacitorFastFloat * kFastDecay, env[k]);
+    // Slow envelope follower.
+    if (env[k] > stt->capacitorSlowFloat) {
+      stt->capacitorSlowFloat +=
+          (env[k] - stt->capacitorSlowFloat) * kSlowAttack;
+    } else {
+      stt->capacitorSlowFloat += stt->capacitorSlowFloat * decay;
+    }
+
+    // Translate the maximum of both capacitors into a gain by interpolating
+    // between gainTable[zeros] and gainTable[zeros - 1].
+    const float cur_level =
+        std::max(stt->capacitorFastFloat, stt->capacitorSlowFloat);
+    zeros = LevelToZeros(cur_level, &fraction);
+    gains[k + 1] = (stt->gainTable[zeros] +
+                    (stt->gainTable[zeros - 1] - stt->gainTable[zeros]) *
+                        fraction) *
+                   kQ16ToLinear;
+  }
+
+  // Gate processing (lower gain during absence of speech), in Q9 like the
+  // fixed-point version.
+  float fraction_fast;
+  const int zeros_fast =
+      LevelToZeros(stt->capacitorFastFloat, &fraction_fast);
+  float gate = 1000.f + 512.f * (zeros_fast - fraction_fast) -
+               512.f * (zeros - fraction) - stt->vadNearend.stdShortTerm;
+  if (gate < 0.f) {
+    stt->gatePreviousFloat = 0.f;
+  } else {
+    gate = (gate + 7.f * stt->gatePreviousFloat) * 0.125f;
+    stt->gatePreviousFloat = gate;
+  }
+  // gate < 0     -> no gate
+  // gate > 2500  -> max gate
+  if (gate > 0.f) {
+    const float gain_adj = gate < 2500.f ? (2500.f - gate) / 32.f : 0.f;
+    const float scaling = (178.f + gain_adj) / 256.f;
+    for (size_t k = 0; k < 10; ++k) {
+      gains[k + 1] = min_gain + (gains[k + 1] - min_gain) * scaling;
+    }
+  }
+
+  // Limit gain to avoid overload distortion.
+  for (size_t k = 0; k < 10; ++k) {
+    while (env[k] * gains[k + 1] * gains[k + 1] > kMaxOutputEnergy) {
+      gains[k + 1] *= kLimiterStep;
+    }
+  }
+  // gain reductions should be done 1 ms earlier than gain increases
+  for (size_t k = 1; k < 10; ++k) {
+    gains[k] = std::min(gains[k], gains[k + 1]);
+  }
+  // save start gain for next frame
+  stt->gainFloat = gains[10];
+
+  return 0;
+}
+
 int32_t WebRtcAgc_ApplyDigitalGains(const int32_t gains[11],
                                     size_t num_bands,
                                     uint32_t FS,
@@ -35,6 +35,12 @@ typedef struct {
   int32_t gainTable[32];
   int16_t gatePrevious;
   int16_t agcMode;
+  // State of WebRtcAgc_ComputeDigitalGainsFloat(), in the same units as the
+  // corresponding fixed-point fields above.
+  float capacitorSlowFloat;
+  float capacitorFastFloat;
+  float gainFloat;
+  float gatePreviousFloat;
   AgcVad vadNearend;
   AgcVad vadFarend;
 } DigitalAgc;
@@ -48,6 +54,15 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* digitalAgcInst,
                                       int16_t lowLevelSignal,
                                       int32_t gains[11]);
 
+// Floating point version of WebRtcAgc_ComputeDigitalGains() operating on the
+// lowest band in the FloatS16 format. Produces linear gains (i.e., Q0 instead
+// of Q16) and only uses the 16 bit representation of `in_near` for the VAD.
+int32_t WebRtcAgc_ComputeDigitalGainsFloat(DigitalAgc* digitalAgcInst,
+                                           const float* in_near,
+                                           uint32_t FS,
+                                           int16_t lowLevelSignal,
+                                           float gains[11]);
+
 int32_t WebRtcAgc_ApplyDigitalGains(const int32_t gains[11],
                                     size_t num_bands,
                                     uint32_t FS,
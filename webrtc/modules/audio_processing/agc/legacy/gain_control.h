@@ -160,6 +160,21 @@ int WebRtcAgc_Analyze(void* agcInst,
                       uint8_t* saturationWarning,
                       int32_t gains[11]);
 
+/*
+ * Floating point version of WebRtcAgc_Analyze(). Analyzes the lowest band
+ * `in_near` in the FloatS16 format and produces linear digital gains instead
+ * of Q16 ones. Uses a separate digital gain state from WebRtcAgc_Analyze(), so
+ * the two functions should not be mixed on the same instance.
+ */
+int WebRtcAgc_AnalyzeFloat(void* agcInst,
+                           const float* in_near,
+                           size_t samples,
+                           int32_t inMicLevel,
+                           int32_t* outMicLevel,
+                           int16_t echo,
+                           uint8_t* saturationWarning,
+                           float gains[11]);
+
 /*
  * This function processes a 10 ms frame by applying precomputed digital gains.
  *
@@ -229,6 +244,11 @@ void* WebRtcAgc_Create(void);
  */
 void WebRtcAgc_Free(void* agcInst);
 
+/*
+ * Returns the size of the AGC instance created by WebRtcAgc_Create().
+ */
+size_t WebRtcAgc_MemoryUsage(void);
+
 /*
  * This function initializes an AGC instance.
  *
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_AGC_LOUDNESS_HISTOGRAM_H_
 #define MODULES_AUDIO_PROCESSING_AGC_LOUDNESS_HISTOGRAM_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -45,6 +46,10 @@ class LoudnessHistogram {
   // Number of times the histogram has been updated.
   int num_updates() const { return num_updates_; }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + 2 * len_circular_buffer_ * sizeof(int);
+  }
+
  private:
   LoudnessHistogram();
   explicit LoudnessHistogram(int window);
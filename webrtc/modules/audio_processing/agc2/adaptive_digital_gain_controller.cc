@@ -125,13 +125,26 @@ AdaptiveDigitalGainController::AdaptiveDigitalGainController(
 
 void AdaptiveDigitalGainController::Process(const FrameInfo& info,
                                             DeinterleavedView<float> frame) {
-  RTC_DCHECK_GE(info.speech_level_dbfs, -150.0f);
   RTC_DCHECK_GE(frame.num_channels(), 1);
   RTC_DCHECK(
       frame.samples_per_channel() == 80 || frame.samples_per_channel() == 160 ||
       frame.samples_per_channel() == 320 || frame.samples_per_channel() == 480)
       << "`frame` does not look like a 10 ms frame for an APM supported sample "
          "rate";
+  UpdateGain(info);
+  gain_applier_.ApplyGain(frame);
+}
+
+AdaptiveDigitalGainController::GainRamp
+AdaptiveDigitalGainController::ComputeGain(const FrameInfo& info) {
+  // The gain applier ramps from the gain of the previous frame.
+  const float start = gain_applier_.GetGainFactor();
+  UpdateGain(info);
+  return {start, gain_applier_.GetGainFactor()};
+}
+
+void AdaptiveDigitalGainController::UpdateGain(const FrameInfo& info) {
+  RTC_DCHECK_GE(info.speech_level_dbfs, -150.0f);
 
   // Compute the input level used to select the desired gain.
   RTC_DCHECK_GT(info.headroom_db, 0.0f);
@@ -183,8 +196,6 @@ void AdaptiveDigitalGainController::Process(const FrameInfo& info,
         DbToRatio(last_gain_db_ + gain_change_this_frame_db));
   }
 
-  gain_applier_.ApplyGain(frame);
-
   // Remember that the gain has changed for the next iteration.
   last_gain_db_ = last_gain_db_ + gain_change_this_frame_db;
   apm_data_dumper_->DumpRaw("agc2_adaptive_gain_applier_applied_gain_db",
@@ -44,11 +44,24 @@ class AdaptiveDigitalGainController {
   AdaptiveDigitalGainController& operator=(
       const AdaptiveDigitalGainController&) = delete;
 
+  // Linear gains at the start and at the end of a frame. The gain is ramped
+  // linearly in between.
+  struct GainRamp {
+    float start;
+    float end;
+  };
+
   // Analyzes `info`, updates the digital gain and applies it to a 10 ms
   // `frame`. Supports any sample rate supported by APM.
   void Process(const FrameInfo& info, DeinterleavedView<float> frame);
 
+  // Analyzes `info` and updates the digital gain as `Process()` does, but
+  // returns the gain to apply to the frame instead of applying it.
+  GainRamp ComputeGain(const FrameInfo& info);
+
  private:
+  void UpdateGain(const FrameInfo& info);
+
   ApmDataDumper* const apm_data_dumper_;
   GainApplier gain_applier_;
 
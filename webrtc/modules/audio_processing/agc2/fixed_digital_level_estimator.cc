@@ -10,6 +10,16 @@
 
 #include "modules/audio_processing/agc2/fixed_digital_level_estimator.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 
@@ -32,12 +42,76 @@ constexpr float kAttackFilterConstant = 0.0f;
 // - `kDecayMs` is defined in agc2_testing_common.h.
 constexpr float kDecayFilterConstant = 0.9971259f;
 
+// Updates `envelope` with the peak absolute value of each sub-frame of
+// `channel`.
+void UpdateEnvelope(MonoView<const float> channel,
+                    int samples_in_sub_frame,
+                    std::array<float, kSubFramesInFrame>& envelope) {
+  for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
+    for (int sample_in_sub_frame = 0;
+         sample_in_sub_frame < samples_in_sub_frame; ++sample_in_sub_frame) {
+      envelope[sub_frame] =
+          std::max(envelope[sub_frame],
+                   std::abs(channel[sub_frame * samples_in_sub_frame +
+                                    sample_in_sub_frame]));
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+void UpdateEnvelopeSse2(MonoView<const float> channel,
+                        int samples_in_sub_frame,
+                        std::array<float, kSubFramesInFrame>& envelope) {
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
+    const float* x = &channel[sub_frame * samples_in_sub_frame];
+    // The samples are the first operand of the maximum, which makes NaNs be
+    // ignored as in UpdateEnvelope().
+    __m128 peak = _mm_set1_ps(envelope[sub_frame]);
+    int k = 0;
+    for (; k + 4 <= samples_in_sub_frame; k += 4) {
+      peak = _mm_max_ps(_mm_and_ps(abs_mask, _mm_loadu_ps(&x[k])), peak);
+    }
+    peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+    peak = _mm_max_ps(peak, _mm_shuffle_ps(peak, peak, 1));
+    float envelope_value = _mm_cvtss_f32(peak);
+    for (; k < samples_in_sub_frame; ++k) {
+      envelope_value = std::max(envelope_value, std::abs(x[k]));
+    }
+    envelope[sub_frame] = envelope_value;
+  }
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+void UpdateEnvelopeNeon(MonoView<const float> channel,
+                        int samples_in_sub_frame,
+                        std::array<float, kSubFramesInFrame>& envelope) {
+  for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
+    const float* x = &channel[sub_frame * samples_in_sub_frame];
+    // The numeric maximum ignores NaNs as in UpdateEnvelope().
+    float32x4_t peak = vdupq_n_f32(envelope[sub_frame]);
+    int k = 0;
+    for (; k + 4 <= samples_in_sub_frame; k += 4) {
+      peak = vmaxnmq_f32(peak, vabsq_f32(vld1q_f32(&x[k])));
+    }
+    float envelope_value = vmaxvq_f32(peak);
+    for (; k < samples_in_sub_frame; ++k) {
+      envelope_value = std::max(envelope_value, std::abs(x[k]));
+    }
+    envelope[sub_frame] = envelope_value;
+  }
+}
+#endif
+
 }  // namespace
 
 FixedDigitalLevelEstimator::FixedDigitalLevelEstimator(
     size_t samples_per_channel,
-    ApmDataDumper* apm_data_dumper)
+    ApmDataDumper* apm_data_dumper,
+    AvailableCpuFeatures cpu_features)
     : apm_data_dumper_(apm_data_dumper),
+      cpu_features_(cpu_features),
       filter_state_level_(kInitialFilterStateLevel) {
   SetSamplesPerChannel(samples_per_channel);
   CheckParameterCombination();
@@ -57,6 +131,21 @@ void FixedDigitalLevelEstimator::CheckParameterCombination() {
 
 std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
     DeinterleavedView<const float> float_frame) {
+  // Dump data for debug.
+  RTC_DCHECK(apm_data_dumper_);
+  const auto channel = float_frame[0];
+  for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
+    apm_data_dumper_->DumpRaw("agc2_level_estimator_samples",
+                              samples_in_sub_frame_,
+                              &channel[sub_frame * samples_in_sub_frame_]);
+  }
+
+  return ComputeLevelFromPeaks(ComputeSubFramePeaks(float_frame));
+}
+
+std::array<float, kSubFramesInFrame>
+FixedDigitalLevelEstimator::ComputeSubFramePeaks(
+    DeinterleavedView<const float> float_frame) const {
   RTC_DCHECK_GT(float_frame.num_channels(), 0);
   RTC_DCHECK_EQ(float_frame.samples_per_channel(), samples_in_frame_);
 
@@ -65,16 +154,27 @@ std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
   for (size_t channel_idx = 0; channel_idx < float_frame.num_channels();
        ++channel_idx) {
     const auto channel = float_frame[channel_idx];
-    for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
-      for (int sample_in_sub_frame = 0;
-           sample_in_sub_frame < samples_in_sub_frame_; ++sample_in_sub_frame) {
-        envelope[sub_frame] =
-            std::max(envelope[sub_frame],
-                     std::abs(channel[sub_frame * samples_in_sub_frame_ +
-                                      sample_in_sub_frame]));
-      }
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+    if (cpu_features_.sse2) {
+      UpdateEnvelopeSse2(channel, samples_in_sub_frame_, envelope);
+      continue;
+    }
+#endif
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      UpdateEnvelopeNeon(channel, samples_in_sub_frame_, envelope);
+      continue;
     }
+#endif
+    UpdateEnvelope(channel, samples_in_sub_frame_, envelope);
   }
+  return envelope;
+}
+
+std::array<float, kSubFramesInFrame>
+FixedDigitalLevelEstimator::ComputeLevelFromPeaks(
+    const std::array<float, kSubFramesInFrame>& sub_frame_peaks) {
+  std::array<float, kSubFramesInFrame> envelope = sub_frame_peaks;
 
   // Make sure envelope increases happen one step earlier so that the
   // corresponding *gain decrease* doesn't miss a sudden signal
@@ -98,11 +198,6 @@ std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
     filter_state_level_ = envelope[sub_frame];
 
     // Dump data for debug.
-    RTC_DCHECK(apm_data_dumper_);
-    const auto channel = float_frame[0];
-    apm_data_dumper_->DumpRaw("agc2_level_estimator_samples",
-                              samples_in_sub_frame_,
-                              &channel[sub_frame * samples_in_sub_frame_]);
     apm_data_dumper_->DumpRaw("agc2_level_estimator_level",
                               envelope[sub_frame]);
   }
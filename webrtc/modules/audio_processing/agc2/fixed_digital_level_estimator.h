@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "modules/audio_processing/agc2/agc2_common.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
 
 namespace webrtc {
@@ -33,9 +34,11 @@ class FixedDigitalLevelEstimator {
   // expectation is that samples per channel is divisible by
   // kSubFramesInSample. For kFrameDurationMs=10 and
   // kSubFramesInSample=20, this means that the original sample rate has to be
-  // divisible by 2000 and therefore `samples_per_channel` by 20.
+  // divisible by 2000 and therefore `samples_per_channel` by 20. The
+  // envelope is computed with SIMD instructions when `cpu_features` allows.
   FixedDigitalLevelEstimator(size_t samples_per_channel,
-                             ApmDataDumper* apm_data_dumper);
+                             ApmDataDumper* apm_data_dumper,
+                             AvailableCpuFeatures cpu_features);
 
   FixedDigitalLevelEstimator(const FixedDigitalLevelEstimator&) = delete;
   FixedDigitalLevelEstimator& operator=(const FixedDigitalLevelEstimator&) =
@@ -48,6 +51,16 @@ class FixedDigitalLevelEstimator {
   std::array<float, kSubFramesInFrame> ComputeLevel(
       DeinterleavedView<const float> float_frame);
 
+  // Returns the peak absolute value of each sub-frame of `float_frame` over
+  // all the channels. The frame is not analyzed any further.
+  std::array<float, kSubFramesInFrame> ComputeSubFramePeaks(
+      DeinterleavedView<const float> float_frame) const;
+
+  // Same as `ComputeLevel()`, for a frame whose sub-frame peaks, as computed
+  // by `ComputeSubFramePeaks()`, are `sub_frame_peaks`.
+  std::array<float, kSubFramesInFrame> ComputeLevelFromPeaks(
+      const std::array<float, kSubFramesInFrame>& sub_frame_peaks);
+
   // Rate may be changed at any time (but not concurrently) from the
   // value passed to the constructor. The class is not thread safe.
   void SetSamplesPerChannel(size_t samples_per_channel);
@@ -61,6 +74,7 @@ class FixedDigitalLevelEstimator {
   void CheckParameterCombination();
 
   ApmDataDumper* const apm_data_dumper_ = nullptr;
+  const AvailableCpuFeatures cpu_features_;
   float filter_state_level_;
   int samples_in_frame_;
   int samples_in_sub_frame_;
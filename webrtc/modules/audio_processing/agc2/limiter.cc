@@ -10,12 +10,21 @@
 
 #include "modules/audio_processing/agc2/limiter.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cmath>
 
 #include "absl/strings/string_view.h"
-#include "api/array_view.h"
 #include "modules/audio_processing/agc2/agc2_common.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -33,64 +42,136 @@ namespace {
 // the fixed gain effectiveness.
 constexpr float kAttackFirstSubframeInterpolationPower = 8.0f;
 
-void InterpolateFirstSubframe(float last_factor,
-                              float current_factor,
-                              rtc::ArrayView<float> subframe) {
-  const int n = rtc::dchecked_cast<int>(subframe.size());
+// Returns the scaling factor for the first sub-frame in case of attack. The
+// power function is evaluated at `1 - i / n` for the i-th of the n samples,
+// which, as an integer division, is one throughout the sub-frame.
+float AttackFirstSubframeFactor(float last_factor, float current_factor) {
   constexpr float p = kAttackFirstSubframeInterpolationPower;
-  for (int i = 0; i < n; ++i) {
-    subframe[i] = std::pow(1.f - i / n, p) * (last_factor - current_factor) +
-                  current_factor;
-  }
+  return std::pow(1.f, p) * (last_factor - current_factor) + current_factor;
 }
 
-void ComputePerSampleSubframeFactors(
-    const std::array<float, kSubFramesInFrame + 1>& scaling_factors,
-    MonoView<float> per_sample_scaling_factors) {
-  const size_t num_subframes = scaling_factors.size() - 1;
-  const int subframe_size = rtc::CheckedDivExact(
-      SamplesPerChannel(per_sample_scaling_factors), num_subframes);
+Limiter::FrameGains ComputeSubframeGains(
+    const std::array<float, kSubFramesInFrame + 1>& scaling_factors) {
+  Limiter::FrameGains gains;
+  for (size_t i = 0; i < gains.size(); ++i) {
+    gains[i] = {scaling_factors[i], scaling_factors[i + 1]};
+  }
 
   // Handle first sub-frame differently in case of attack.
-  const bool is_attack = scaling_factors[0] > scaling_factors[1];
-  if (is_attack) {
-    InterpolateFirstSubframe(
-        scaling_factors[0], scaling_factors[1],
-        per_sample_scaling_factors.subview(0, subframe_size));
+  if (scaling_factors[0] > scaling_factors[1]) {
+    const float factor =
+        AttackFirstSubframeFactor(scaling_factors[0], scaling_factors[1]);
+    gains[0] = {factor, factor};
   }
+  return gains;
+}
 
-  for (size_t i = is_attack ? 1 : 0; i < num_subframes; ++i) {
-    const int subframe_start = i * subframe_size;
-    const float scaling_start = scaling_factors[i];
-    const float scaling_end = scaling_factors[i + 1];
-    const float scaling_diff = (scaling_end - scaling_start) / subframe_size;
-    for (int j = 0; j < subframe_size; ++j) {
-      per_sample_scaling_factors[subframe_start + j] =
-          scaling_start + scaling_diff * j;
+// Scaling factors of the samples of a sub-frame, which are linearly
+// interpolated as `start + step * j` for the j-th sample.
+struct SubframeRamp {
+  float start;
+  float step;
+};
+
+SubframeRamp ToRamp(const Limiter::SubframeGain& gain, int subframe_size) {
+  return {gain.start, (gain.end - gain.start) / subframe_size};
+}
+
+// Scales and hard-clips the samples. The scaling factors are computed while
+// scaling, in the same way for all the channels.
+void ScaleSamples(const Limiter::FrameGains& gains,
+                  int subframe_size,
+                  DeinterleavedView<float> signal) {
+  for (size_t i = 0; i < signal.num_channels(); ++i) {
+    MonoView<float> channel = signal[i];
+    for (int k = 0; k < kSubFramesInFrame; ++k) {
+      const SubframeRamp ramp = ToRamp(gains[k], subframe_size);
+      float* x = &channel[k * subframe_size];
+      for (int j = 0; j < subframe_size; ++j) {
+        x[j] = rtc::SafeClamp(x[j] * (ramp.start + ramp.step * j),
+                              kMinFloatS16Value, kMaxFloatS16Value);
+      }
     }
   }
 }
 
-void ScaleSamples(MonoView<const float> per_sample_scaling_factors,
-                  DeinterleavedView<float> signal) {
-  const int samples_per_channel = signal.samples_per_channel();
-  RTC_DCHECK_EQ(samples_per_channel,
-                SamplesPerChannel(per_sample_scaling_factors));
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+void ScaleSamplesSse2(const Limiter::FrameGains& gains,
+                      int subframe_size,
+                      DeinterleavedView<float> signal) {
+  const __m128 min_value = _mm_set1_ps(kMinFloatS16Value);
+  const __m128 max_value = _mm_set1_ps(kMaxFloatS16Value);
+  const __m128 lane_index = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+  for (size_t i = 0; i < signal.num_channels(); ++i) {
+    MonoView<float> channel = signal[i];
+    for (int k = 0; k < kSubFramesInFrame; ++k) {
+      const SubframeRamp ramp = ToRamp(gains[k], subframe_size);
+      const __m128 start = _mm_set1_ps(ramp.start);
+      const __m128 step = _mm_set1_ps(ramp.step);
+      float* x = &channel[k * subframe_size];
+      int j = 0;
+      for (; j + 4 <= subframe_size; j += 4) {
+        const __m128 index =
+            _mm_add_ps(_mm_set1_ps(static_cast<float>(j)), lane_index);
+        const __m128 factor = _mm_add_ps(start, _mm_mul_ps(step, index));
+        // The clamped value is the second operand, which lets NaNs through
+        // as in ScaleSamples().
+        __m128 y = _mm_mul_ps(_mm_loadu_ps(&x[j]), factor);
+        y = _mm_min_ps(max_value, _mm_max_ps(min_value, y));
+        _mm_storeu_ps(&x[j], y);
+      }
+      for (; j < subframe_size; ++j) {
+        x[j] = rtc::SafeClamp(x[j] * (ramp.start + ramp.step * j),
+                              kMinFloatS16Value, kMaxFloatS16Value);
+      }
+    }
+  }
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+void ScaleSamplesNeon(const Limiter::FrameGains& gains,
+                      int subframe_size,
+                      DeinterleavedView<float> signal) {
+  const float32x4_t min_value = vdupq_n_f32(kMinFloatS16Value);
+  const float32x4_t max_value = vdupq_n_f32(kMaxFloatS16Value);
+  const float kLaneIndex[4] = {0.f, 1.f, 2.f, 3.f};
+  const float32x4_t lane_index = vld1q_f32(kLaneIndex);
   for (size_t i = 0; i < signal.num_channels(); ++i) {
     MonoView<float> channel = signal[i];
-    for (int j = 0; j < samples_per_channel; ++j) {
-      channel[j] = rtc::SafeClamp(channel[j] * per_sample_scaling_factors[j],
-                                  kMinFloatS16Value, kMaxFloatS16Value);
+    for (int k = 0; k < kSubFramesInFrame; ++k) {
+      const SubframeRamp ramp = ToRamp(gains[k], subframe_size);
+      const float32x4_t start = vdupq_n_f32(ramp.start);
+      const float32x4_t step = vdupq_n_f32(ramp.step);
+      float* x = &channel[k * subframe_size];
+      int j = 0;
+      for (; j + 4 <= subframe_size; j += 4) {
+        const float32x4_t index =
+            vaddq_f32(vdupq_n_f32(static_cast<float>(j)), lane_index);
+        // Separate multiplication and addition, as in ScaleSamples().
+        const float32x4_t factor = vaddq_f32(start, vmulq_f32(step, index));
+        float32x4_t y = vmulq_f32(vld1q_f32(&x[j]), factor);
+        y = vminq_f32(max_value, vmaxq_f32(min_value, y));
+        vst1q_f32(&x[j], y);
+      }
+      for (; j < subframe_size; ++j) {
+        x[j] = rtc::SafeClamp(x[j] * (ramp.start + ramp.step * j),
+                              kMinFloatS16Value, kMaxFloatS16Value);
+      }
     }
   }
 }
+#endif
+
 }  // namespace
 
 Limiter::Limiter(ApmDataDumper* apm_data_dumper,
                  size_t samples_per_channel,
-                 absl::string_view histogram_name)
-    : interp_gain_curve_(apm_data_dumper, histogram_name),
-      level_estimator_(samples_per_channel, apm_data_dumper),
+                 absl::string_view histogram_name,
+                 AvailableCpuFeatures cpu_features)
+    : cpu_features_(cpu_features),
+      interp_gain_curve_(apm_data_dumper, histogram_name),
+      level_estimator_(samples_per_channel, apm_data_dumper, cpu_features),
       apm_data_dumper_(apm_data_dumper) {
   RTC_DCHECK_LE(samples_per_channel, kMaximalNumberOfSamplesPerChannel);
 }
@@ -101,20 +182,49 @@ void Limiter::Process(DeinterleavedView<float> signal) {
   RTC_DCHECK_LE(signal.samples_per_channel(),
                 kMaximalNumberOfSamplesPerChannel);
 
-  const std::array<float, kSubFramesInFrame> level_estimate =
-      level_estimator_.ComputeLevel(signal);
+  const FrameGains gains =
+      ComputeGainsFromLevel(level_estimator_.ComputeLevel(signal));
 
+  // The per-sample scaling factors are interpolated while scaling the samples.
+  const int subframe_size = rtc::CheckedDivExact(
+      rtc::dchecked_cast<int>(signal.samples_per_channel()), kSubFramesInFrame);
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (cpu_features_.sse2) {
+    ScaleSamplesSse2(gains, subframe_size, signal);
+  } else {
+    ScaleSamples(gains, subframe_size, signal);
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    ScaleSamplesNeon(gains, subframe_size, signal);
+  } else {
+    ScaleSamples(gains, subframe_size, signal);
+  }
+#else
+  ScaleSamples(gains, subframe_size, signal);
+#endif
+}
+
+std::array<float, kSubFramesInFrame> Limiter::ComputeSubFramePeaks(
+    DeinterleavedView<const float> signal) const {
+  return level_estimator_.ComputeSubFramePeaks(signal);
+}
+
+Limiter::FrameGains Limiter::ComputeGains(
+    const std::array<float, kSubFramesInFrame>& sub_frame_peaks) {
+  return ComputeGainsFromLevel(
+      level_estimator_.ComputeLevelFromPeaks(sub_frame_peaks));
+}
+
+Limiter::FrameGains Limiter::ComputeGainsFromLevel(
+    const std::array<float, kSubFramesInFrame>& level_estimate) {
   RTC_DCHECK_EQ(level_estimate.size() + 1, scaling_factors_.size());
   scaling_factors_[0] = last_scaling_factor_;
   std::transform(level_estimate.begin(), level_estimate.end(),
                  scaling_factors_.begin() + 1, [this](float x) {
                    return interp_gain_curve_.LookUpGainToApply(x);
                  });
-
-  MonoView<float> per_sample_scaling_factors(&per_sample_scaling_factors_[0],
-                                             signal.samples_per_channel());
-  ComputePerSampleSubframeFactors(scaling_factors_, per_sample_scaling_factors);
-  ScaleSamples(per_sample_scaling_factors, signal);
+  const FrameGains gains = ComputeSubframeGains(scaling_factors_);
 
   last_scaling_factor_ = scaling_factors_.back();
 
@@ -124,6 +234,7 @@ void Limiter::Process(DeinterleavedView<float> signal) {
   apm_data_dumper_->DumpRaw(
       "agc2_limiter_region",
       static_cast<int>(interp_gain_curve_.get_stats().region));
+  return gains;
 }
 
 InterpolatedGainCurve::Stats Limiter::GetGainCurveStats() const {
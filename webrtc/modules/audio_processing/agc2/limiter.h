@@ -11,10 +11,12 @@
 #ifndef MODULES_AUDIO_PROCESSING_AGC2_LIMITER_H_
 #define MODULES_AUDIO_PROCESSING_AGC2_LIMITER_H_
 
+#include <array>
 #include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/audio/audio_frame.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/fixed_digital_level_estimator.h"
 #include "modules/audio_processing/agc2/interpolated_gain_curve.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
@@ -25,23 +27,43 @@ class ApmDataDumper;
 class Limiter {
  public:
   // See `SetSamplesPerChannel()` for valid values for `samples_per_channel`.
+  // SIMD instructions are used when `cpu_features` allows.
   Limiter(ApmDataDumper* apm_data_dumper,
           size_t samples_per_channel,
-          absl::string_view histogram_name_prefix);
+          absl::string_view histogram_name_prefix,
+          AvailableCpuFeatures cpu_features);
 
   Limiter(const Limiter& limiter) = delete;
   Limiter& operator=(const Limiter& limiter) = delete;
   ~Limiter();
 
+  // Scaling factor that the limiter applies to a sub-frame. The factor of the
+  // j-th of the n samples of the sub-frame is `start + (end - start) * j / n`.
+  struct SubframeGain {
+    float start;
+    float end;
+  };
+  using FrameGains = std::array<SubframeGain, kSubFramesInFrame>;
+
   // Applies limiter and hard-clipping to `signal`.
   void Process(DeinterleavedView<float> signal);
 
+  // Returns the peak absolute value of each sub-frame of `signal`, as analyzed
+  // by `Process()`.
+  std::array<float, kSubFramesInFrame> ComputeSubFramePeaks(
+      DeinterleavedView<const float> signal) const;
+
+  // Updates the limiter as `Process()` does for a frame whose sub-frame peaks
+  // are `sub_frame_peaks`, and returns the scaling factors instead of applying
+  // them. Hard-clipping is left to the caller.
+  FrameGains ComputeGains(
+      const std::array<float, kSubFramesInFrame>& sub_frame_peaks);
+
   InterpolatedGainCurve::Stats GetGainCurveStats() const;
 
   // Supported values must be
   // * Supported by FixedDigitalLevelEstimator
-  // * Below or equal to kMaximalNumberOfSamplesPerChannel so that samples
-  //   fit in the per_sample_scaling_factors_ array.
+  // * Below or equal to kMaximalNumberOfSamplesPerChannel.
   void SetSamplesPerChannel(size_t samples_per_channel);
 
   // Resets the internal state.
@@ -50,14 +72,16 @@ class Limiter {
   float LastAudioLevel() const;
 
  private:
+  FrameGains ComputeGainsFromLevel(
+      const std::array<float, kSubFramesInFrame>& level_estimate);
+
+  const AvailableCpuFeatures cpu_features_;
   const InterpolatedGainCurve interp_gain_curve_;
   FixedDigitalLevelEstimator level_estimator_;
   ApmDataDumper* const apm_data_dumper_ = nullptr;
 
   // Work array containing the sub-frame scaling factors to be interpolated.
   std::array<float, kSubFramesInFrame + 1> scaling_factors_ = {};
-  std::array<float, kMaximalNumberOfSamplesPerChannel>
-      per_sample_scaling_factors_ = {};
   float last_scaling_factor_ = 1.f;
 };
 
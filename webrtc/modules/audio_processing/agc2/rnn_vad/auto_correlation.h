@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
 #include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -36,6 +37,11 @@ class AutoCorrelationCalculator {
       rtc::ArrayView<const float, kBufSize12kHz> pitch_buf,
       rtc::ArrayView<float, kNumLags12kHz> auto_corr);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(tmp_) + HeapBytes(X_) +
+           HeapBytes(H_);
+  }
+
  private:
   Pffft fft_;
   std::unique_ptr<Pffft::FloatBuffer> tmp_;
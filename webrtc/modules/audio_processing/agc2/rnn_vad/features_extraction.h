@@ -19,6 +19,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/pitch_search.h"
 #include "modules/audio_processing/agc2/rnn_vad/sequence_buffer.h"
 #include "modules/audio_processing/agc2/rnn_vad/spectral_features.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -39,6 +40,12 @@ class FeaturesExtractor {
       rtc::ArrayView<const float, kFrameSize10ms24kHz> samples,
       rtc::ArrayView<float, kFeatureVectorSize> feature_vector);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(pitch_buf_24kHz_) +
+           HeapBytes(lp_residual_) + HeapBytes(pitch_estimator_) +
+           HeapBytes(spectral_features_extractor_);
+  }
+
  private:
   const bool use_high_pass_filter_;
   // TODO(bugs.webrtc.org/7494): Remove HPF depending on how AGC2 is used in APM
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/layer_params.h"
+
+#include <tuple>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/process_wide_cache.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+rtc::ArrayView<const float> GetSharedLayerParams(
+    rtc::ArrayView<const int8_t> params,
+    int output_size,
+    LayerParamsPreprocessor preprocess) {
+  RTC_DCHECK(preprocess);
+  // The parameters are looked up by value rather than by address, so that
+  // layers created from temporary buffers never get stale parameters.
+  using Key = std::tuple<LayerParamsPreprocessor, int, std::vector<int8_t>>;
+  static auto* const cache = new ProcessWideCache<Key, std::vector<float>>();
+  return cache->GetOrCreate(
+      Key(preprocess, output_size,
+          std::vector<int8_t>(params.begin(), params.end())),
+      [&] { return preprocess(params, output_size); });
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_LAYER_PARAMS_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_LAYER_PARAMS_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Casts, scales and re-arranges the quantized parameters of a layer with
+// `output_size` units.
+using LayerParamsPreprocessor =
+    std::vector<float> (*)(rtc::ArrayView<const int8_t> params,
+                           int output_size);
+
+// Returns `preprocess(params, output_size)`. The preprocessed parameters are
+// immutable, hence they are computed once per process for each distinct
+// input and shared by all the layers using them.
+rtc::ArrayView<const float> GetSharedLayerParams(
+    rtc::ArrayView<const int8_t> params,
+    int output_size,
+    LayerParamsPreprocessor preprocess);
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_LAYER_PARAMS_H_
@@ -20,6 +20,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
 #include "modules/audio_processing/agc2/rnn_vad/pitch_search_internal.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -34,6 +35,12 @@ class PitchEstimator {
   // Returns the estimated pitch period at 48 kHz.
   int Estimate(rtc::ArrayView<const float, kBufSize24kHz> pitch_buffer);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(auto_corr_calculator_) +
+           HeapBytes(y_energy_24kHz_) + HeapBytes(pitch_buffer_12kHz_) +
+           HeapBytes(auto_correlation_12kHz_);
+  }
+
  private:
   FRIEND_TEST_ALL_PREFIXES(RnnVadTest, PitchSearchWithinTolerance);
   float GetLastPitchStrengthForTesting() const {
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn_fc.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -41,6 +42,11 @@ class RnnVad {
       rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
       bool is_silence);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(input_) + HeapBytes(hidden_) +
+           HeapBytes(output_);
+  }
+
  private:
   FullyConnectedLayer input_;
   GatedRecurrentLayer hidden_;
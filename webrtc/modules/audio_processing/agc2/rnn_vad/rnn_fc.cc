@@ -12,7 +12,9 @@
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
 
+#include "modules/audio_processing/agc2/rnn_vad/layer_params.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -22,7 +24,9 @@ namespace webrtc {
 namespace rnn_vad {
 namespace {
 
-std::vector<float> GetScaledParams(rtc::ArrayView<const int8_t> params) {
+// Casts and scales `params`, whose layout does not depend on the output size.
+std::vector<float> GetScaledParams(rtc::ArrayView<const int8_t> params,
+                                   int /*output_size*/) {
   std::vector<float> scaled_params(params.size());
   std::transform(params.begin(), params.end(), scaled_params.begin(),
                  [](int8_t x) -> float {
@@ -37,7 +41,7 @@ std::vector<float> GetScaledParams(rtc::ArrayView<const int8_t> params) {
 std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
                                      int output_size) {
   if (output_size == 1) {
-    return GetScaledParams(weights);
+    return GetScaledParams(weights, output_size);
   }
   // Transpose, scale and cast.
   const int input_size = rtc::CheckedDivExact(
@@ -74,8 +78,8 @@ FullyConnectedLayer::FullyConnectedLayer(
     absl::string_view layer_name)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(GetScaledParams(bias)),
-      weights_(PreprocessWeights(weights, output_size)),
+      bias_(GetSharedLayerParams(bias, output_size, GetScaledParams)),
+      weights_(GetSharedLayerParams(weights, output_size, PreprocessWeights)),
       vector_math_(cpu_features),
       activation_function_(GetActivationFunction(activation_function)) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayerMaxUnits)
@@ -92,11 +96,10 @@ FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
-  rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
     output_[o] = activation_function_(
         bias_[o] + vector_math_.DotProduct(
-                       input, weights.subview(o * input_size_, input_size_)));
+                       input, weights_.subview(o * input_size_, input_size_)));
   }
 }
 
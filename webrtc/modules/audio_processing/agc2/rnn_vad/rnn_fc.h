@@ -12,7 +12,6 @@
 #define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_RNN_FC_H_
 
 #include <array>
-#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -30,7 +29,8 @@ enum class ActivationFunction { kTansigApproximated, kSigmoidApproximated };
 constexpr int kFullyConnectedLayerMaxUnits = 24;
 
 // Fully-connected layer with a custom activation function which owns the output
-// buffer.
+// buffer. The preprocessed bias and weights are shared by all the layers
+// created with the same parameters.
 class FullyConnectedLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kFullyConnectedLayerMaxUnits`.
@@ -55,11 +55,13 @@ class FullyConnectedLayer {
   // Computes the fully-connected layer output.
   void ComputeOutput(rtc::ArrayView<const float> input);
 
+  size_t MemoryUsage() const { return sizeof(*this); }
+
  private:
   const int input_size_;
   const int output_size_;
-  const std::vector<float> bias_;
-  const std::vector<float> weights_;
+  const rtc::ArrayView<const float> bias_;
+  const rtc::ArrayView<const float> weights_;
   const VectorMath vector_math_;
   rtc::FunctionView<float(float)> activation_function_;
   // Over-allocated array with size equal to `output_size_`.
@@ -10,6 +10,9 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
 
+#include <vector>
+
+#include "modules/audio_processing/agc2/rnn_vad/layer_params.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -131,9 +134,11 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     absl::string_view layer_name)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      bias_(GetSharedLayerParams(bias, output_size, PreprocessGruTensor)),
+      weights_(GetSharedLayerParams(weights, output_size, PreprocessGruTensor)),
+      recurrent_weights_(GetSharedLayerParams(recurrent_weights,
+                                              output_size,
+                                              PreprocessGruTensor)),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
@@ -12,7 +12,6 @@
 #define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_RNN_GRU_H_
 
 #include <array>
-#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -27,6 +26,8 @@ constexpr int kGruLayerMaxUnits = 24;
 
 // Recurrent layer with gated recurrent units (GRUs) with sigmoid and ReLU as
 // activation functions for the update/reset and output gates respectively.
+// The preprocessed tensors are shared by all the layers created with the same
+// parameters.
 class GatedRecurrentLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kGruLayerMaxUnits`.
@@ -53,12 +54,14 @@ class GatedRecurrentLayer {
   // Computes the recurrent layer output and updates the status.
   void ComputeOutput(rtc::ArrayView<const float> input);
 
+  size_t MemoryUsage() const { return sizeof(*this); }
+
  private:
   const int input_size_;
   const int output_size_;
-  const std::vector<float> bias_;
-  const std::vector<float> weights_;
-  const std::vector<float> recurrent_weights_;
+  const rtc::ArrayView<const float> bias_;
+  const rtc::ArrayView<const float> weights_;
+  const rtc::ArrayView<const float> recurrent_weights_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
@@ -18,6 +18,7 @@
 
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -69,6 +70,8 @@ class SequenceBuffer {
     std::memcpy(buffer_.data() + S - N, new_values.data(), N * sizeof(T));
   }
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(buffer_); }
+
  private:
   std::vector<T> buffer_;
 };
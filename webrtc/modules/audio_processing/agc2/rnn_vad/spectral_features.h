@@ -22,6 +22,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/spectral_features_internal.h"
 #include "modules/audio_processing/agc2/rnn_vad/symmetric_matrix_buffer.h"
 #include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -49,6 +50,12 @@ class SpectralFeaturesExtractor {
       rtc::ArrayView<float, kNumLowerBands> bands_cross_corr,
       float* variability);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) + HeapBytes(fft_buffer_) +
+           HeapBytes(reference_frame_fft_) + HeapBytes(lagged_frame_fft_) +
+           HeapBytes(spectral_correlator_);
+  }
+
  private:
   void ComputeAvgAndDerivatives(
       rtc::ArrayView<float, kNumLowerBands> average,
@@ -18,6 +18,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -68,6 +69,8 @@ class SpectralCorrelator {
       rtc::ArrayView<const float> y,
       rtc::ArrayView<float, kOpusBands24kHz> cross_corr) const;
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(weights_); }
+
  private:
   const std::vector<float> weights_;  // Weights for each Fourier coefficient.
 };
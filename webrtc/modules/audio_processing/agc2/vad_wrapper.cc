@@ -19,6 +19,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/features_extraction.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace {
@@ -43,6 +44,10 @@ class MonoVadImpl : public VoiceActivityDetectorWrapper::MonoVad {
         feature_vector);
     return rnn_vad_.ComputeVadProbability(feature_vector, is_silence);
   }
+  size_t MemoryUsage() const override {
+    return sizeof(*this) + HeapBytes(features_extractor_) +
+           HeapBytes(rnn_vad_);
+  }
 
  private:
   rnn_vad::FeaturesExtractor features_extractor_;
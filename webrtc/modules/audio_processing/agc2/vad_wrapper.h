@@ -17,6 +17,7 @@
 #include "api/audio/audio_view.h"
 #include "common_audio/resampler/include/push_resampler.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -37,6 +38,9 @@ class VoiceActivityDetectorWrapper {
     virtual void Reset() = 0;
     // Analyzes an audio frame and returns the speech probability.
     virtual float Analyze(MonoView<const float> frame) = 0;
+    // Returns the size of the VAD, including the memory it owns, or 0 if not
+    // supported.
+    virtual size_t MemoryUsage() const { return 0; }
   };
 
   // Ctor. Uses `cpu_features` to instantiate the default VAD.
@@ -64,6 +68,11 @@ class VoiceActivityDetectorWrapper {
   // `Initialize()` call.
   float Analyze(DeinterleavedView<const float> frame);
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(vad_) + HeapBytes(resampled_buffer_) +
+           HeapBytes(resampler_);
+  }
+
  private:
   const int vad_reset_period_frames_;
   const int frame_size_;
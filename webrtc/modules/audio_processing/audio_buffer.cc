@@ -12,12 +12,15 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <cstdint>
 
 #include "common_audio/channel_buffer.h"
+#include "common_audio/include/audio_util.h"
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "modules/audio_processing/splitting_filter.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 namespace {
@@ -35,6 +38,130 @@ size_t NumBandsFromFramesPerChannel(size_t num_frames) {
   return 1;
 }
 
+// Averages the channels of the interleaved `x` into `y`, with the channel
+// count known at compile time for the common layouts.
+template <int kNumChannels>
+void DownmixS16ToFloatS16(const int16_t* x, size_t num_frames, float* y) {
+  for (size_t j = 0; j < num_frames; ++j, x += kNumChannels) {
+    int32_t sum = 0;
+    for (int i = 0; i < kNumChannels; ++i) {
+      sum += x[i];
+    }
+    y[j] = sum / kNumChannels;
+  }
+}
+
+void DownmixS16ToFloatS16(const int16_t* x,
+                          size_t num_frames,
+                          size_t num_channels,
+                          float* y) {
+  switch (num_channels) {
+    case 2:
+      DownmixS16ToFloatS16<2>(x, num_frames, y);
+      return;
+    case 4:
+      DownmixS16ToFloatS16<4>(x, num_frames, y);
+      return;
+    case 6:
+      DownmixS16ToFloatS16<6>(x, num_frames, y);
+      return;
+  }
+  for (size_t j = 0, k = 0; j < num_frames; ++j) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < num_channels; ++i, ++k) {
+      sum += x[k];
+    }
+    y[j] = sum / static_cast<int16_t>(num_channels);
+  }
+}
+
+// Counterpart of DownmixS16ToFloatS16() for float channels.
+template <int kNumChannels>
+void DownmixFloat(const float* const* x, size_t num_frames, float* y) {
+  constexpr float kOneByNumChannels = 1.f / kNumChannels;
+  for (size_t j = 0; j < num_frames; ++j) {
+    float value = x[0][j];
+    for (int i = 1; i < kNumChannels; ++i) {
+      value += x[i][j];
+    }
+    y[j] = value * kOneByNumChannels;
+  }
+}
+
+void DownmixFloat(const float* const* x,
+                  size_t num_frames,
+                  size_t num_channels,
+                  float* y) {
+  switch (num_channels) {
+    case 2:
+      DownmixFloat<2>(x, num_frames, y);
+      return;
+    case 4:
+      DownmixFloat<4>(x, num_frames, y);
+      return;
+  }
+  // The channels are accumulated one at a time, in the same order as above,
+  // which keeps the loops vectorizable for any channel count.
+  const float kOneByNumChannels = 1.f / num_channels;
+  std::copy(x[0], x[0] + num_frames, y);
+  for (size_t i = 1; i < num_channels; ++i) {
+    for (size_t j = 0; j < num_frames; ++j) {
+      y[j] += x[i][j];
+    }
+  }
+  for (size_t j = 0; j < num_frames; ++j) {
+    y[j] *= kOneByNumChannels;
+  }
+}
+
+// Resampler sources deriving the channel to resample directly from the input
+// data.
+class StackedDownmixSource : public PushSincResampler::Source {
+ public:
+  StackedDownmixSource(const float* const* stacked_data, size_t num_channels)
+      : stacked_data_(stacked_data), num_channels_(num_channels) {}
+
+  void Read(size_t frames, float* destination) override {
+    DownmixFloat(stacked_data_, frames, num_channels_, destination);
+  }
+
+ private:
+  const float* const* const stacked_data_;
+  const size_t num_channels_;
+};
+
+class InterleavedDownmixSource : public PushSincResampler::Source {
+ public:
+  InterleavedDownmixSource(const int16_t* interleaved, size_t num_channels)
+      : interleaved_(interleaved), num_channels_(num_channels) {}
+
+  void Read(size_t frames, float* destination) override {
+    DownmixS16ToFloatS16(interleaved_, frames, num_channels_, destination);
+  }
+
+ private:
+  const int16_t* const interleaved_;
+  const size_t num_channels_;
+};
+
+class InterleavedChannelSource : public PushSincResampler::Source {
+ public:
+  InterleavedChannelSource(const int16_t* interleaved,
+                           size_t channel,
+                           size_t num_channels)
+      : interleaved_(interleaved + channel), num_channels_(num_channels) {}
+
+  void Read(size_t frames, float* destination) override {
+    for (size_t j = 0, k = 0; j < frames; ++j, k += num_channels_) {
+      destination[j] = interleaved_[k];
+    }
+  }
+
+ private:
+  const int16_t* const interleaved_;
+  const size_t num_channels_;
+};
+
 }  // namespace
 
 AudioBuffer::AudioBuffer(size_t input_rate,
@@ -88,6 +215,12 @@ AudioBuffer::AudioBuffer(size_t input_rate,
 
 AudioBuffer::~AudioBuffer() {}
 
+size_t AudioBuffer::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(data_) + HeapBytes(split_data_) +
+         HeapBytes(splitting_filter_) + HeapBytes(input_resamplers_) +
+         HeapBytes(output_resamplers_);
+}
+
 void AudioBuffer::set_downmixing_to_specific_channel(size_t channel) {
   downmix_by_averaging_ = false;
   RTC_DCHECK_GT(input_num_channels_, channel);
@@ -108,30 +241,28 @@ void AudioBuffer::CopyFrom(const float* const* stacked_data,
   const bool resampling_needed = input_num_frames_ != buffer_num_frames_;
 
   if (downmix_needed) {
-    RTC_DCHECK_GE(kMaxSamplesPerChannel10ms, input_num_frames_);
-
-    std::array<float, kMaxSamplesPerChannel10ms> downmix;
+    // The downmix is written directly to the buffer or, when resampling, to
+    // the resampler input.
+    float* mono = data_->channels()[0];
     if (downmix_by_averaging_) {
-      const float kOneByNumChannels = 1.f / input_num_channels_;
-      for (size_t i = 0; i < input_num_frames_; ++i) {
-        float value = stacked_data[0][i];
-        for (size_t j = 1; j < input_num_channels_; ++j) {
-          value += stacked_data[j][i];
-        }
-        downmix[i] = value * kOneByNumChannels;
+      if (resampling_needed) {
+        StackedDownmixSource source(stacked_data, input_num_channels_);
+        input_resamplers_[0]->Resample(source, input_num_frames_, mono,
+                                       buffer_num_frames_);
+      } else {
+        DownmixFloat(stacked_data, input_num_frames_, input_num_channels_,
+                     mono);
       }
+      FloatToFloatS16(mono, buffer_num_frames_, mono);
+    } else {
+      const float* channel = stacked_data[channel_for_downmixing_];
+      if (resampling_needed) {
+        input_resamplers_[0]->Resample(channel, input_num_frames_, mono,
+                                       buffer_num_frames_);
+        channel = mono;
+      }
+      FloatToFloatS16(channel, buffer_num_frames_, mono);
     }
-    const float* downmixed_data = downmix_by_averaging_
-                                      ? downmix.data()
-                                      : stacked_data[channel_for_downmixing_];
-
-    if (resampling_needed) {
-      input_resamplers_[0]->Resample(downmixed_data, input_num_frames_,
-                                     data_->channels()[0], buffer_num_frames_);
-    }
-    const float* data_to_convert =
-        resampling_needed ? data_->channels()[0] : downmixed_data;
-    FloatToFloatS16(data_to_convert, buffer_num_frames_, data_->channels()[0]);
   } else {
     if (resampling_needed) {
       for (size_t i = 0; i < num_channels_; ++i) {
@@ -236,55 +367,42 @@ void AudioBuffer::CopyFrom(const int16_t* const interleaved_data,
       } else {
         S16ToFloatS16(interleaved, input_num_frames_, data_->channels()[0]);
       }
-    } else {
-      std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
-      float* downmixed_data =
-          resampling_required ? float_buffer.data() : data_->channels()[0];
-      if (downmix_by_averaging_) {
-        for (size_t j = 0, k = 0; j < input_num_frames_; ++j) {
-          int32_t sum = 0;
-          for (size_t i = 0; i < input_num_channels_; ++i, ++k) {
-            sum += interleaved[k];
-          }
-          downmixed_data[j] = sum / static_cast<int16_t>(input_num_channels_);
-        }
+    } else if (downmix_by_averaging_) {
+      // The downmix is written directly to the buffer or, when resampling, to
+      // the resampler input.
+      if (resampling_required) {
+        InterleavedDownmixSource source(interleaved, input_num_channels_);
+        input_resamplers_[0]->Resample(source, input_num_frames_,
+                                       data_->channels()[0],
+                                       buffer_num_frames_);
       } else {
-        for (size_t j = 0, k = channel_for_downmixing_; j < input_num_frames_;
-             ++j, k += input_num_channels_) {
-          downmixed_data[j] = interleaved[k];
-        }
+        DownmixS16ToFloatS16(interleaved, input_num_frames_,
+                             input_num_channels_, data_->channels()[0]);
       }
-
+    } else {
+      InterleavedChannelSource source(interleaved, channel_for_downmixing_,
+                                      input_num_channels_);
       if (resampling_required) {
-        input_resamplers_[0]->Resample(downmixed_data, input_num_frames_,
+        input_resamplers_[0]->Resample(source, input_num_frames_,
                                        data_->channels()[0],
                                        buffer_num_frames_);
+      } else {
+        source.Read(input_num_frames_, data_->channels()[0]);
       }
     }
   } else {
-    auto deinterleave_channel = [](size_t channel, size_t num_channels,
-                                   size_t samples_per_channel, const int16_t* x,
-                                   float* y) {
-      for (size_t j = 0, k = channel; j < samples_per_channel;
-           ++j, k += num_channels) {
-        y[j] = x[k];
-      }
-    };
-
     if (resampling_required) {
-      std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
       for (size_t i = 0; i < num_channels_; ++i) {
-        deinterleave_channel(i, num_channels_, input_num_frames_, interleaved,
-                             float_buffer.data());
-        input_resamplers_[i]->Resample(float_buffer.data(), input_num_frames_,
+        InterleavedChannelSource source(interleaved, i, num_channels_);
+        input_resamplers_[i]->Resample(source, input_num_frames_,
                                        data_->channels()[i],
                                        buffer_num_frames_);
       }
     } else {
-      for (size_t i = 0; i < num_channels_; ++i) {
-        deinterleave_channel(i, num_channels_, input_num_frames_, interleaved,
-                             data_->channels()[i]);
-      }
+      DeinterleaveS16ToFloatS16(
+          InterleavedView<const int16_t>(interleaved, input_num_frames_,
+                                         num_channels_),
+          view());
     }
   }
 }
@@ -310,9 +428,7 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
         resampling_required ? float_buffer.data() : data_->channels()[0];
 
     if (config_num_channels == 1) {
-      for (size_t j = 0; j < output_num_frames_; ++j) {
-        interleaved[j] = FloatS16ToS16(deinterleaved[j]);
-      }
+      FloatS16ToS16(deinterleaved, output_num_frames_, interleaved);
     } else {
       for (size_t i = 0, k = 0; i < output_num_frames_; ++i) {
         float tmp = FloatS16ToS16(deinterleaved[i]);
@@ -341,10 +457,10 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
                            float_buffer.data(), interleaved);
       }
     } else {
-      for (size_t i = 0; i < num_channels_; ++i) {
-        interleave_channel(i, config_num_channels, output_num_frames_,
-                           data_->channels()[i], interleaved);
-      }
+      InterleaveFloatS16ToS16(view(),
+                              InterleavedView<int16_t>(interleaved,
+                                                       output_num_frames_,
+                                                       config_num_channels));
     }
 
     for (size_t i = num_channels_; i < config_num_channels; ++i) {
@@ -372,9 +488,7 @@ void AudioBuffer::ExportSplitChannelData(
 
     RTC_DCHECK(split_band_data[k]);
     RTC_DCHECK(band_data);
-    for (size_t i = 0; i < num_frames_per_band(); ++i) {
-      split_band_data[k][i] = FloatS16ToS16(band_data[i]);
-    }
+    FloatS16ToS16(band_data, num_frames_per_band(), split_band_data[k]);
   }
 }
 
@@ -385,9 +499,7 @@ void AudioBuffer::ImportSplitChannelData(
     float* band_data = split_bands(channel)[k];
     RTC_DCHECK(split_band_data[k]);
     RTC_DCHECK(band_data);
-    for (size_t i = 0; i < num_frames_per_band(); ++i) {
-      band_data[i] = split_band_data[k][i];
-    }
+    S16ToFloatS16(split_band_data[k], num_frames_per_band(), band_data);
   }
 }
 
@@ -71,6 +71,10 @@ class AudioBuffer {
   size_t num_frames_per_band() const { return num_split_frames_; }
   size_t num_bands() const { return num_bands_; }
 
+  // Returns the size of the buffer, including its band split and resampling
+  // state.
+  size_t MemoryUsage() const;
+
   // Returns pointer arrays to the full-band channels.
   // Usage:
   // channels()[channel][sample].
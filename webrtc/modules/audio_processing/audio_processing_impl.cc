@@ -34,6 +34,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/denormal_disabler.h"
@@ -115,6 +116,22 @@ static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 // TODO(peah): Decrease this once we properly handle hugely unbalanced
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
+// Maximum number of frames to buffer in the render queue when the low-memory
+// profile is used.
+static const size_t kLowMemoryMaxNumFramesToBuffer = 20;
+
+size_t MaxNumFramesToBuffer(const AudioProcessing::Config& config) {
+  return config.pipeline.low_memory ? kLowMemoryMaxNumFramesToBuffer
+                                    : kMaxNumFramesToBuffer;
+}
+
+// Shrinks the buffers of AEC3 that are sized by the maximum echo path delay and
+// by the render jitter to tolerate.
+void AdjustAec3ConfigForLowMemory(EchoCanceller3Config& config) {
+  config.delay.num_filters = 3;
+  config.buffering.render_transfer_queue_size_frames =
+      kLowMemoryMaxNumFramesToBuffer;
+}
 
 void PackRenderAudioBufferForEchoDetector(const AudioBuffer& audio,
                                           std::vector<float>& packed_buffer) {
@@ -139,7 +156,8 @@ enum class AudioFormatValidity {
   // The remaining enums values signal that the audio does not have a reasonable
   // interpretation and cannot be used.
   kInvalidSampleRate,
-  kInvalidChannelCount
+  kInvalidChannelCount,
+  kInvalidFrameSize
 };
 
 AudioFormatValidity ValidateAudioFormat(const StreamConfig& config) {
@@ -147,6 +165,9 @@ AudioFormatValidity ValidateAudioFormat(const StreamConfig& config) {
     return AudioFormatValidity::kInvalidSampleRate;
   if (config.num_channels() == 0)
     return AudioFormatValidity::kInvalidChannelCount;
+  if (config.frame_size_ms() <= 0 ||
+      config.frame_size_ms() % AudioProcessing::kChunkSizeMs != 0)
+    return AudioFormatValidity::kInvalidFrameSize;
 
   // Format has a reasonable interpretation, but may still be unsupported.
   if (config.sample_rate_hz() < 8000 ||
@@ -166,6 +187,8 @@ int AudioFormatValidityToErrorCode(AudioFormatValidity validity) {
       return AudioProcessing::kBadSampleRateError;
     case AudioFormatValidity::kInvalidChannelCount:
       return AudioProcessing::kBadNumberChannelsError;
+    case AudioFormatValidity::kInvalidFrameSize:
+      return AudioProcessing::kBadDataLengthError;
   }
   RTC_DCHECK(false);
 }
@@ -178,8 +201,11 @@ std::pair<int, FormatErrorOutputOption> ChooseErrorOutputOption(
   AudioFormatValidity input_validity = ValidateAudioFormat(input_config);
   AudioFormatValidity output_validity = ValidateAudioFormat(output_config);
 
+  const bool frame_sizes_match =
+      input_config.frame_size_ms() == output_config.frame_size_ms();
   if (input_validity == AudioFormatValidity::kValidAndSupported &&
       output_validity == AudioFormatValidity::kValidAndSupported &&
+      frame_sizes_match &&
       (output_config.num_channels() == 1 ||
        output_config.num_channels() == input_config.num_channels())) {
     return {AudioProcessing::kNoError, FormatErrorOutputOption::kDoNothing};
@@ -189,6 +215,9 @@ std::pair<int, FormatErrorOutputOption> ChooseErrorOutputOption(
   if (error_code == AudioProcessing::kNoError) {
     error_code = AudioFormatValidityToErrorCode(output_validity);
   }
+  if (error_code == AudioProcessing::kNoError && !frame_sizes_match) {
+    error_code = AudioProcessing::kBadDataLengthError;
+  }
   if (error_code == AudioProcessing::kNoError) {
     // The individual formats are valid but there is some error - must be
     // channel mismatch.
@@ -205,6 +234,9 @@ std::pair<int, FormatErrorOutputOption> ChooseErrorOutputOption(
                  AudioFormatValidity::kValidButUnsupportedSampleRate) {
     // The input format is uninterpretable: cannot use it, must output silence.
     output_option = FormatErrorOutputOption::kOutputSilence;
+  } else if (!frame_sizes_match) {
+    // The input does not cover the output: output silence.
+    output_option = FormatErrorOutputOption::kOutputSilence;
   } else if (input_config.sample_rate_hz() != output_config.sample_rate_hz()) {
     // Sample rates do not match: Cannot copy input into output, output silence.
     // Note: If the sample rates are in a supported range, we could resample.
@@ -303,6 +335,98 @@ int HandleUnsupportedAudioFormats(const float* const* src,
   return error_code;
 }
 
+// Returns the format of the 10 ms chunks of a frame in the format `config`.
+StreamConfig ChunkConfig(const StreamConfig& config) {
+  return StreamConfig(config.sample_rate_hz(), config.num_channels());
+}
+
+// Returns the channel pointers of chunk `chunk` of the deinterleaved `frame`,
+// using `chunk_channels` as storage if the chunk is not the first one.
+template <typename T>
+T* const* GetChunkChannels(T* const* frame,
+                           const StreamConfig& chunk_config,
+                           size_t chunk,
+                           std::vector<T*>* chunk_channels) {
+  if (chunk == 0) {
+    return frame;
+  }
+  chunk_channels->resize(chunk_config.num_channels());
+  for (size_t ch = 0; ch < chunk_config.num_channels(); ++ch) {
+    (*chunk_channels)[ch] = frame[ch] + chunk * chunk_config.num_frames();
+  }
+  return chunk_channels->data();
+}
+
+// Returns true if writing the chunks of a frame of `dest_size` elements to
+// `dest` may overwrite chunks of the frame of `src_size` elements at `src`
+// before they are read. Processing in place is safe as long as no output
+// chunk extends past the input chunk that it replaces.
+template <typename T>
+bool ChunkOutputMayOverwriteInput(const T* src,
+                                  size_t src_size,
+                                  size_t src_chunk_size,
+                                  const T* dest,
+                                  size_t dest_size,
+                                  size_t dest_chunk_size) {
+  const uintptr_t s = reinterpret_cast<uintptr_t>(src);
+  const uintptr_t d = reinterpret_cast<uintptr_t>(dest);
+  const bool overlap =
+      d < s + src_size * sizeof(T) && s < d + dest_size * sizeof(T);
+  return overlap && (d > s || dest_chunk_size > src_chunk_size);
+}
+
+// Returns `src`, or a copy of it in `storage` if the chunk by chunk
+// processing of the interleaved frame into `dest` could corrupt its input.
+const int16_t* StageInputIfNeeded(const int16_t* src,
+                                  const StreamConfig& input_config,
+                                  const int16_t* dest,
+                                  const StreamConfig& output_config,
+                                  std::vector<int16_t>* storage) {
+  if (input_config.num_chunks() < 2 ||
+      !ChunkOutputMayOverwriteInput(src, input_config.num_samples(),
+                                    ChunkConfig(input_config).num_samples(),
+                                    dest, output_config.num_samples(),
+                                    ChunkConfig(output_config).num_samples())) {
+    return src;
+  }
+  storage->assign(src, src + input_config.num_samples());
+  return storage->data();
+}
+
+// Deinterleaved version of the above, where any output channel may overlap
+// any input channel.
+const float* const* StageInputIfNeeded(const float* const* src,
+                                       const StreamConfig& input_config,
+                                       const float* const* dest,
+                                       const StreamConfig& output_config,
+                                       std::vector<float>* storage,
+                                       std::vector<const float*>* channels) {
+  if (input_config.num_chunks() < 2) {
+    return src;
+  }
+  const size_t num_input_frames = input_config.num_frames();
+  const size_t num_output_frames = output_config.num_frames();
+  bool overwrite = false;
+  for (size_t i = 0; i < input_config.num_channels() && !overwrite; ++i) {
+    for (size_t j = 0; j < output_config.num_channels() && !overwrite; ++j) {
+      overwrite = ChunkOutputMayOverwriteInput(
+          src[i], num_input_frames, ChunkConfig(input_config).num_frames(),
+          dest[j], num_output_frames, ChunkConfig(output_config).num_frames());
+    }
+  }
+  if (!overwrite) {
+    return src;
+  }
+  storage->resize(input_config.num_samples());
+  channels->resize(input_config.num_channels());
+  for (size_t ch = 0; ch < input_config.num_channels(); ++ch) {
+    float* channel = storage->data() + ch * num_input_frames;
+    std::copy(src[ch], src[ch] + num_input_frames, channel);
+    (*channels)[ch] = channel;
+  }
+  return channels->data();
+}
+
 using DownmixMethod = AudioProcessing::Config::Pipeline::DownmixMethod;
 
 void SetDownmixMethod(AudioBuffer& buffer, DownmixMethod method) {
@@ -500,16 +624,20 @@ int AudioProcessingImpl::Initialize(const ProcessingConfig& processing_config) {
 
 void AudioProcessingImpl::MaybeInitializeRender(
     const StreamConfig& input_config,
-    const StreamConfig& output_config) {
+    const StreamConfig& output_config,
+    bool independent_render_references) {
   ProcessingConfig processing_config = formats_.api_format;
   processing_config.reverse_input_stream() = input_config;
   processing_config.reverse_output_stream() = output_config;
 
-  if (processing_config == formats_.api_format) {
+  if (processing_config == formats_.api_format &&
+      independent_render_references ==
+          formats_.independent_render_references) {
     return;
   }
 
   MutexLock lock_capture(&mutex_capture_);
+  formats_.independent_render_references = independent_render_references;
   InitializeLocked(processing_config);
 }
 
@@ -591,6 +719,11 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
   UpdateActiveSubmoduleStates();
 
   formats_.api_format = config;
+  // Frames longer than 10 ms are processed in chunks, which is what the API
+  // formats describe.
+  for (StreamConfig& stream : formats_.api_format.streams) {
+    stream.set_frame_size_ms(kChunkSizeMs);
+  }
 
   // Choose maximum rate to use for the split filtering.
   RTC_DCHECK(config_.pipeline.maximum_internal_processing_rate == 48000 ||
@@ -638,8 +771,11 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
   if (submodule_states_.RenderMultiBandSubModulesActive()) {
     // By default, downmix the render stream to mono for analysis. This has been
     // demonstrated to work well for AEC in most practical scenarios.
-    const bool multi_channel_render = config_.pipeline.multi_channel_render &&
-                                      constants_.multi_channel_render_support;
+    // Independent render references are never downmixed.
+    const bool multi_channel_render =
+        formats_.independent_render_references ||
+        (config_.pipeline.multi_channel_render &&
+         constants_.multi_channel_render_support);
     int render_processing_num_channels =
         multi_channel_render
             ? formats_.api_format.reverse_input_stream().num_channels()
@@ -680,7 +816,8 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.pipeline.maximum_internal_processing_rate !=
           config.pipeline.maximum_internal_processing_rate ||
       config_.pipeline.capture_downmix_method !=
-          config.pipeline.capture_downmix_method;
+          config.pipeline.capture_downmix_method ||
+      config_.pipeline.low_memory != config.pipeline.low_memory;
 
   const bool aec_config_changed =
       config_.echo_canceller.enabled != config.echo_canceller.enabled ||
@@ -704,6 +841,12 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
   const bool gain_adjustment_config_changed =
       config_.capture_level_adjustment != config.capture_level_adjustment;
 
+  if (config_.pipeline.low_memory != config.pipeline.low_memory) {
+    // Reallocate the render queues with the new number of frames.
+    agc_render_queue_element_max_size_ = 0;
+    red_render_queue_element_max_size_ = 0;
+  }
+
   config_ = config;
 
   if (aec_config_changed) {
@@ -908,27 +1051,49 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   MaybeInitializeCapture(input_config, output_config);
 
   MutexLock lock_capture(&mutex_capture_);
+  PrepareCaptureFrameLocked();
+
+  src = StageInputIfNeeded(src, input_config, dest, output_config,
+                           &capture_.staged_src,
+                           &capture_.staged_src_channels);
+  const StreamConfig input_chunk_config = ChunkConfig(input_config);
+  const StreamConfig output_chunk_config = ChunkConfig(output_config);
+  for (size_t chunk = 0; chunk < input_config.num_chunks(); ++chunk) {
+    const float* const* chunk_src = GetChunkChannels(
+        src, input_chunk_config, chunk, &capture_.chunk_src);
+    float* const* chunk_dest = GetChunkChannels(
+        dest, output_chunk_config, chunk, &capture_.chunk_dest);
+    if (chunk > 0) {
+      // The applied input volume is set once per frame, so only the first
+      // chunk sees a change of it.
+      capture_.applied_input_volume_changed = false;
+    }
 
-  if (aec_dump_) {
-    RecordUnprocessedCaptureStream(src);
-  }
+    if (aec_dump_) {
+      RecordUnprocessedCaptureStream(chunk_src);
+    }
 
-  capture_.capture_audio->CopyFrom(src, formats_.api_format.input_stream());
-  if (capture_.capture_fullband_audio) {
-    capture_.capture_fullband_audio->CopyFrom(
-        src, formats_.api_format.input_stream());
-  }
-  RETURN_ON_ERR(ProcessCaptureStreamLocked());
-  if (capture_.capture_fullband_audio) {
-    capture_.capture_fullband_audio->CopyTo(formats_.api_format.output_stream(),
-                                            dest);
-  } else {
-    capture_.capture_audio->CopyTo(formats_.api_format.output_stream(), dest);
-  }
+    capture_.capture_audio->CopyFrom(chunk_src,
+                                     formats_.api_format.input_stream());
+    if (capture_.capture_fullband_audio) {
+      capture_.capture_fullband_audio->CopyFrom(
+          chunk_src, formats_.api_format.input_stream());
+    }
+    RETURN_ON_ERR(ProcessCaptureStreamLocked());
+    if (capture_.capture_fullband_audio) {
+      capture_.capture_fullband_audio->CopyTo(
+          formats_.api_format.output_stream(), chunk_dest);
+    } else {
+      capture_.capture_audio->CopyTo(formats_.api_format.output_stream(),
+                                     chunk_dest);
+    }
 
-  if (aec_dump_) {
-    RecordProcessedCaptureStream(dest);
+    if (aec_dump_) {
+      RecordProcessedCaptureStream(chunk_dest);
+    }
   }
+
+  FinishCaptureFrameLocked();
   return kNoError;
 }
 
@@ -1118,32 +1283,14 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
 }
 
 void AudioProcessingImpl::AllocateRenderQueue() {
-  const size_t new_agc_render_queue_element_max_size =
-      std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerBand);
-
   const size_t new_red_render_queue_element_max_size =
       std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerFrame);
 
   // Reallocate the queues if the queue item sizes are too small to fit the
   // data to put in the queues.
 
-  if (agc_render_queue_element_max_size_ <
-      new_agc_render_queue_element_max_size) {
-    agc_render_queue_element_max_size_ = new_agc_render_queue_element_max_size;
-
-    std::vector<int16_t> template_queue_element(
-        agc_render_queue_element_max_size_);
-
-    agc_render_signal_queue_.reset(
-        new SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>(
-            kMaxNumFramesToBuffer, template_queue_element,
-            RenderQueueItemVerifier<int16_t>(
-                agc_render_queue_element_max_size_)));
-
-    agc_render_queue_buffer_.resize(agc_render_queue_element_max_size_);
-    agc_capture_queue_buffer_.resize(agc_render_queue_element_max_size_);
-  } else {
-    agc_render_signal_queue_->Clear();
+  if (config_.gain_controller1.enabled) {
+    AllocateGainController1RenderQueue();
   }
 
   if (submodules_.echo_detector) {
@@ -1157,7 +1304,7 @@ void AudioProcessingImpl::AllocateRenderQueue() {
 
       red_render_signal_queue_.reset(
           new SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>(
-              kMaxNumFramesToBuffer, template_queue_element,
+              MaxNumFramesToBuffer(config_), template_queue_element,
               RenderQueueItemVerifier<float>(
                   red_render_queue_element_max_size_)));
 
@@ -1169,6 +1316,30 @@ void AudioProcessingImpl::AllocateRenderQueue() {
   }
 }
 
+void AudioProcessingImpl::AllocateGainController1RenderQueue() {
+  const size_t new_agc_render_queue_element_max_size =
+      std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerBand);
+
+  if (agc_render_queue_element_max_size_ <
+      new_agc_render_queue_element_max_size) {
+    agc_render_queue_element_max_size_ = new_agc_render_queue_element_max_size;
+
+    std::vector<int16_t> template_queue_element(
+        agc_render_queue_element_max_size_);
+
+    agc_render_signal_queue_.reset(
+        new SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>(
+            MaxNumFramesToBuffer(config_), template_queue_element,
+            RenderQueueItemVerifier<int16_t>(
+                agc_render_queue_element_max_size_)));
+
+    agc_render_queue_buffer_.resize(agc_render_queue_element_max_size_);
+    agc_capture_queue_buffer_.resize(agc_render_queue_element_max_size_);
+  } else {
+    agc_render_signal_queue_->Clear();
+  }
+}
+
 void AudioProcessingImpl::EmptyQueuedRenderAudio() {
   MutexLock lock_capture(&mutex_capture_);
   EmptyQueuedRenderAudioLocked();
@@ -1208,34 +1379,57 @@ int AudioProcessingImpl::ProcessStream(const int16_t* const src,
 
   MutexLock lock_capture(&mutex_capture_);
   DenormalDisabler denormal_disabler;
+  PrepareCaptureFrameLocked();
+
+  const int16_t* const frame_src = StageInputIfNeeded(
+      src, input_config, dest, output_config, &capture_.staged_src_s16);
+  const StreamConfig input_chunk_config = ChunkConfig(input_config);
+  const StreamConfig output_chunk_config = ChunkConfig(output_config);
+  for (size_t chunk = 0; chunk < input_config.num_chunks(); ++chunk) {
+    const int16_t* const chunk_src =
+        frame_src + chunk * input_chunk_config.num_samples();
+    int16_t* const chunk_dest =
+        dest + chunk * output_chunk_config.num_samples();
+    if (chunk > 0) {
+      // The applied input volume is set once per frame, so only the first
+      // chunk sees a change of it.
+      capture_.applied_input_volume_changed = false;
+    }
 
-  if (aec_dump_) {
-    RecordUnprocessedCaptureStream(src, input_config);
-  }
+    if (aec_dump_) {
+      RecordUnprocessedCaptureStream(chunk_src, input_chunk_config);
+    }
 
-  capture_.capture_audio->CopyFrom(src, input_config);
-  if (capture_.capture_fullband_audio) {
-    capture_.capture_fullband_audio->CopyFrom(src, input_config);
-  }
-  RETURN_ON_ERR(ProcessCaptureStreamLocked());
-  if (submodule_states_.CaptureMultiBandProcessingPresent() ||
-      submodule_states_.CaptureFullBandProcessingActive()) {
+    capture_.capture_audio->CopyFrom(chunk_src, input_chunk_config);
     if (capture_.capture_fullband_audio) {
-      capture_.capture_fullband_audio->CopyTo(output_config, dest);
-    } else {
-      capture_.capture_audio->CopyTo(output_config, dest);
+      capture_.capture_fullband_audio->CopyFrom(chunk_src, input_chunk_config);
+    }
+    RETURN_ON_ERR(ProcessCaptureStreamLocked());
+    if (submodule_states_.CaptureMultiBandProcessingPresent() ||
+        submodule_states_.CaptureFullBandProcessingActive()) {
+      if (capture_.capture_fullband_audio) {
+        capture_.capture_fullband_audio->CopyTo(output_chunk_config,
+                                                chunk_dest);
+      } else {
+        capture_.capture_audio->CopyTo(output_chunk_config, chunk_dest);
+      }
     }
-  }
 
-  if (aec_dump_) {
-    RecordProcessedCaptureStream(dest, output_config);
+    if (aec_dump_) {
+      RecordProcessedCaptureStream(chunk_dest, output_chunk_config);
+    }
   }
+
+  FinishCaptureFrameLocked();
   return kNoError;
 }
 
-int AudioProcessingImpl::ProcessCaptureStreamLocked() {
+void AudioProcessingImpl::PrepareCaptureFrameLocked() {
   EmptyQueuedRenderAudioLocked();
   HandleCaptureRuntimeSettings();
+}
+
+int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   DenormalDisabler denormal_disabler;
 
   // Ensure that not both the AEC and AECM are active at the same time.
@@ -1475,18 +1669,6 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
   }
 
-  // Compute echo-controller stats.
-  if (submodules_.echo_controller) {
-    auto ec_metrics = submodules_.echo_controller->GetMetrics();
-    capture_.stats.echo_return_loss = ec_metrics.echo_return_loss;
-    capture_.stats.echo_return_loss_enhancement =
-        ec_metrics.echo_return_loss_enhancement;
-    capture_.stats.delay_ms = ec_metrics.delay_ms;
-  }
-
-  // Pass stats for reporting.
-  stats_reporter_.UpdateStatistics(capture_.stats);
-
   UpdateRecommendedInputVolumeLocked();
   if (capture_.recommended_input_volume.has_value()) {
     recommended_input_volume_stats_reporter_.UpdateStatistics(
@@ -1521,8 +1703,6 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
   capture_.capture_output_used_last_frame = capture_.capture_output_used;
 
-  capture_.was_stream_delay_set = false;
-
   data_dumper_->DumpRaw("recommended_input_volume",
                         capture_.recommended_input_volume.value_or(
                             kUnspecifiedDataDumpInputVolume));
@@ -1530,6 +1710,22 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   return kNoError;
 }
 
+void AudioProcessingImpl::FinishCaptureFrameLocked() {
+  // Compute echo-controller stats.
+  if (submodules_.echo_controller) {
+    auto ec_metrics = submodules_.echo_controller->GetMetrics();
+    capture_.stats.echo_return_loss = ec_metrics.echo_return_loss;
+    capture_.stats.echo_return_loss_enhancement =
+        ec_metrics.echo_return_loss_enhancement;
+    capture_.stats.delay_ms = ec_metrics.delay_ms;
+  }
+
+  // Pass stats for reporting.
+  stats_reporter_.UpdateStatistics(capture_.stats);
+
+  capture_.was_stream_delay_set = false;
+}
+
 int AudioProcessingImpl::AnalyzeReverseStream(
     const float* const* data,
     const StreamConfig& reverse_config) {
@@ -1543,8 +1739,43 @@ int AudioProcessingImpl::AnalyzeReverseStream(
   RETURN_ON_ERR(
       AudioFormatValidityToErrorCode(ValidateAudioFormat(reverse_config)));
 
-  MaybeInitializeRender(reverse_config, reverse_config);
-  return AnalyzeReverseStreamLocked(data, reverse_config, reverse_config);
+  MaybeInitializeRender(reverse_config, reverse_config,
+                        /*independent_render_references=*/false);
+  HandleRenderRuntimeSettings();
+
+  const StreamConfig chunk_config = ChunkConfig(reverse_config);
+  for (size_t chunk = 0; chunk < reverse_config.num_chunks(); ++chunk) {
+    RETURN_ON_ERR(AnalyzeReverseStreamLocked(
+        GetChunkChannels(data, chunk_config, chunk, &render_.chunk_src),
+        chunk_config, chunk_config));
+  }
+  return kNoError;
+}
+
+int AudioProcessingImpl::AnalyzeReverseReferences(
+    const float* const* references,
+    const StreamConfig& reference_config) {
+  TRACE_EVENT0("webrtc", "AudioProcessing::AnalyzeReverseReferences");
+  MutexLock lock(&mutex_render_);
+  DenormalDisabler denormal_disabler;
+  RTC_DCHECK(references);
+  for (size_t i = 0; i < reference_config.num_channels(); ++i) {
+    RTC_DCHECK(references[i]);
+  }
+  RETURN_ON_ERR(
+      AudioFormatValidityToErrorCode(ValidateAudioFormat(reference_config)));
+
+  MaybeInitializeRender(reference_config, reference_config,
+                        /*independent_render_references=*/true);
+  HandleRenderRuntimeSettings();
+
+  const StreamConfig chunk_config = ChunkConfig(reference_config);
+  for (size_t chunk = 0; chunk < reference_config.num_chunks(); ++chunk) {
+    RETURN_ON_ERR(AnalyzeReverseStreamLocked(
+        GetChunkChannels(references, chunk_config, chunk, &render_.chunk_src),
+        chunk_config, chunk_config));
+  }
+  return kNoError;
 }
 
 int AudioProcessingImpl::ProcessReverseStream(const float* const* src,
@@ -1557,21 +1788,36 @@ int AudioProcessingImpl::ProcessReverseStream(const float* const* src,
   RETURN_ON_ERR(
       HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
 
-  MaybeInitializeRender(input_config, output_config);
-
-  RETURN_ON_ERR(AnalyzeReverseStreamLocked(src, input_config, output_config));
+  MaybeInitializeRender(input_config, output_config,
+                        /*independent_render_references=*/false);
+  HandleRenderRuntimeSettings();
 
-  if (submodule_states_.RenderMultiBandProcessingActive() ||
-      submodule_states_.RenderFullBandProcessingActive()) {
-    render_.render_audio->CopyTo(formats_.api_format.reverse_output_stream(),
-                                 dest);
-  } else if (formats_.api_format.reverse_input_stream() !=
-             formats_.api_format.reverse_output_stream()) {
-    render_.render_converter->Convert(src, input_config.num_samples(), dest,
-                                      output_config.num_samples());
-  } else {
-    CopyAudioIfNeeded(src, input_config.num_frames(),
-                      input_config.num_channels(), dest);
+  src = StageInputIfNeeded(src, input_config, dest, output_config,
+                           &render_.staged_src, &render_.staged_src_channels);
+  const StreamConfig input_chunk_config = ChunkConfig(input_config);
+  const StreamConfig output_chunk_config = ChunkConfig(output_config);
+  for (size_t chunk = 0; chunk < input_config.num_chunks(); ++chunk) {
+    const float* const* chunk_src =
+        GetChunkChannels(src, input_chunk_config, chunk, &render_.chunk_src);
+    float* const* chunk_dest = GetChunkChannels(
+        dest, output_chunk_config, chunk, &render_.chunk_dest);
+
+    RETURN_ON_ERR(AnalyzeReverseStreamLocked(chunk_src, input_chunk_config,
+                                             output_chunk_config));
+
+    if (submodule_states_.RenderMultiBandProcessingActive() ||
+        submodule_states_.RenderFullBandProcessingActive()) {
+      render_.render_audio->CopyTo(formats_.api_format.reverse_output_stream(),
+                                   chunk_dest);
+    } else if (formats_.api_format.reverse_input_stream() !=
+               formats_.api_format.reverse_output_stream()) {
+      render_.render_converter->Convert(
+          chunk_src, input_chunk_config.num_samples(), chunk_dest,
+          output_chunk_config.num_samples());
+    } else {
+      CopyAudioIfNeeded(chunk_src, input_chunk_config.num_frames(),
+                        input_chunk_config.num_channels(), chunk_dest);
+    }
   }
 
   return kNoError;
@@ -1605,18 +1851,32 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
 
   RETURN_ON_ERR(
       HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
-  MaybeInitializeRender(input_config, output_config);
+  MaybeInitializeRender(input_config, output_config,
+                        /*independent_render_references=*/false);
+  HandleRenderRuntimeSettings();
 
-  if (aec_dump_) {
-    aec_dump_->WriteRenderStreamMessage(src, input_config.num_frames(),
-                                        input_config.num_channels());
-  }
+  const int16_t* const frame_src = StageInputIfNeeded(
+      src, input_config, dest, output_config, &render_.staged_src_s16);
+  const StreamConfig input_chunk_config = ChunkConfig(input_config);
+  const StreamConfig output_chunk_config = ChunkConfig(output_config);
+  for (size_t chunk = 0; chunk < input_config.num_chunks(); ++chunk) {
+    const int16_t* const chunk_src =
+        frame_src + chunk * input_chunk_config.num_samples();
+    int16_t* const chunk_dest =
+        dest + chunk * output_chunk_config.num_samples();
+
+    if (aec_dump_) {
+      aec_dump_->WriteRenderStreamMessage(chunk_src,
+                                          input_chunk_config.num_frames(),
+                                          input_chunk_config.num_channels());
+    }
 
-  render_.render_audio->CopyFrom(src, input_config);
-  RETURN_ON_ERR(ProcessRenderStreamLocked());
-  if (submodule_states_.RenderMultiBandProcessingActive() ||
-      submodule_states_.RenderFullBandProcessingActive()) {
-    render_.render_audio->CopyTo(output_config, dest);
+    render_.render_audio->CopyFrom(chunk_src, input_chunk_config);
+    RETURN_ON_ERR(ProcessRenderStreamLocked());
+    if (submodule_states_.RenderMultiBandProcessingActive() ||
+        submodule_states_.RenderFullBandProcessingActive()) {
+      render_.render_audio->CopyTo(output_chunk_config, chunk_dest);
+    }
   }
   return kNoError;
 }
@@ -1624,7 +1884,6 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
 int AudioProcessingImpl::ProcessRenderStreamLocked() {
   AudioBuffer* render_buffer = render_.render_audio.get();  // For brevity.
 
-  HandleRenderRuntimeSettings();
   DenormalDisabler denormal_disabler;
 
   if (submodules_.render_pre_processor) {
@@ -1702,6 +1961,23 @@ bool AudioProcessingImpl::GetLinearAecOutput(
   return false;
 }
 
+std::vector<uint8_t> AudioProcessingImpl::GetEchoControllerState() const {
+  MutexLock lock(&mutex_capture_);
+  if (!submodules_.echo_controller) {
+    return {};
+  }
+  return submodules_.echo_controller->GetState();
+}
+
+bool AudioProcessingImpl::SetEchoControllerState(
+    rtc::ArrayView<const uint8_t> state) {
+  MutexLock lock(&mutex_capture_);
+  if (!submodules_.echo_controller) {
+    return false;
+  }
+  return submodules_.echo_controller->SetState(state);
+}
+
 int AudioProcessingImpl::stream_delay_ms() const {
   // Used as callback from submodules, hence locking is not allowed.
   return capture_nonlocked_.stream_delay_ms;
@@ -1842,6 +2118,40 @@ AudioProcessing::Config AudioProcessingImpl::GetConfig() const {
   return config_;
 }
 
+AudioProcessing::MemoryUsage AudioProcessingImpl::GetMemoryUsage() const {
+  // Both locks are needed as the render queues are written on the render side
+  // and read on the capture side.
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  MemoryUsage usage;
+  usage.audio_buffers = HeapBytes(capture_.capture_audio) +
+                        HeapBytes(capture_.capture_fullband_audio) +
+                        HeapBytes(capture_.linear_aec_output) +
+                        HeapBytes(render_.render_audio) +
+                        HeapBytes(render_.render_converter);
+  usage.render_queues =
+      HeapBytes(aecm_render_signal_queue_) +
+      HeapBytes(aecm_render_queue_buffer_) +
+      HeapBytes(aecm_capture_queue_buffer_) +
+      HeapBytes(agc_render_signal_queue_) +
+      HeapBytes(agc_render_queue_buffer_) +
+      HeapBytes(agc_capture_queue_buffer_) +
+      HeapBytes(red_render_signal_queue_) +
+      HeapBytes(red_render_queue_buffer_) +
+      HeapBytes(red_capture_queue_buffer_);
+  usage.echo_controller = HeapBytes(submodules_.echo_controller);
+  usage.echo_control_mobile = HeapBytes(submodules_.echo_control_mobile);
+  usage.gain_control =
+      HeapBytes(submodules_.gain_control) + HeapBytes(submodules_.agc_manager);
+  usage.gain_controller2 = HeapBytes(submodules_.gain_controller2);
+  usage.noise_suppressor = HeapBytes(submodules_.noise_suppressor);
+  usage.high_pass_filter = HeapBytes(submodules_.high_pass_filter);
+  usage.other = sizeof(*this) + HeapBytes(submodules_.capture_levels_adjuster) +
+                HeapBytes(capture_.chunk_src) + HeapBytes(capture_.chunk_dest) +
+                HeapBytes(render_.chunk_src) + HeapBytes(render_.chunk_dest);
+  return usage;
+}
+
 bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
   return submodule_states_.Update(
       config_.high_pass_filter.enabled, !!submodules_.echo_control_mobile,
@@ -1894,6 +2204,22 @@ void AudioProcessingImpl::InitializeEchoController() {
       if (use_setup_specific_default_aec3_config_) {
         multichannel_config = EchoCanceller3::CreateDefaultMultichannelConfig();
       }
+      if (config_.pipeline.low_memory) {
+        AdjustAec3ConfigForLowMemory(config);
+        if (multichannel_config) {
+          AdjustAec3ConfigForLowMemory(*multichannel_config);
+        }
+      }
+      if (formats_.independent_render_references) {
+        // Both configs need to agree on the stereo detection, which is turned
+        // off for independent references.
+        config.multi_channel.independent_render_references = true;
+        if (multichannel_config) {
+          multichannel_config->multi_channel.independent_render_references =
+              true;
+          multichannel_config->multi_channel.detect_stereo_content = false;
+        }
+      }
       submodules_.echo_controller = std::make_unique<EchoCanceller3>(
           config, multichannel_config, proc_sample_rate_hz(),
           num_reverse_channels(), num_proc_channels());
@@ -1938,7 +2264,7 @@ void AudioProcessingImpl::InitializeEchoController() {
 
     aecm_render_signal_queue_.reset(
         new SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>(
-            kMaxNumFramesToBuffer, template_queue_element,
+            MaxNumFramesToBuffer(config_), template_queue_element,
             RenderQueueItemVerifier<int16_t>(max_element_size)));
 
     aecm_render_queue_buffer_.resize(max_element_size);
@@ -1970,9 +2296,18 @@ void AudioProcessingImpl::InitializeGainController1() {
   if (!config_.gain_controller1.enabled) {
     submodules_.agc_manager.reset();
     submodules_.gain_control.reset();
+    agc_render_signal_queue_.reset();
+    agc_render_queue_element_max_size_ = 0;
+    agc_render_queue_buffer_ = std::vector<int16_t>();
+    agc_capture_queue_buffer_ = std::vector<int16_t>();
     return;
   }
 
+  // The render queue is only allocated while AGC1 is enabled.
+  if (!agc_render_signal_queue_) {
+    AllocateGainController1RenderQueue();
+  }
+
   RTC_HISTOGRAM_BOOLEAN(
       "WebRTC.Audio.GainController.Analog.Enabled",
       config_.gain_controller1.analog_gain_controller.enabled);
@@ -97,6 +97,8 @@ class AudioProcessingImpl : public AudioProcessing {
                     float* const* dest) override;
   bool GetLinearAecOutput(
       rtc::ArrayView<std::array<float, 160>> linear_output) const override;
+  std::vector<uint8_t> GetEchoControllerState() const override;
+  bool SetEchoControllerState(rtc::ArrayView<const uint8_t> state) override;
   void set_output_will_be_muted(bool muted) override;
   void HandleCaptureOutputUsedSetting(bool capture_output_used)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
@@ -114,6 +116,8 @@ class AudioProcessingImpl : public AudioProcessing {
                            int16_t* const dest) override;
   int AnalyzeReverseStream(const float* const* data,
                            const StreamConfig& reverse_config) override;
+  int AnalyzeReverseReferences(const float* const* references,
+                               const StreamConfig& reference_config) override;
   int ProcessReverseStream(const float* const* src,
                            const StreamConfig& input_config,
                            const StreamConfig& output_config,
@@ -139,6 +143,8 @@ class AudioProcessingImpl : public AudioProcessing {
 
   AudioProcessing::Config GetConfig() const override;
 
+  MemoryUsage GetMemoryUsage() const override;
+
  protected:
   // Overridden in a mock.
   virtual void InitializeLocked()
@@ -233,7 +239,8 @@ class AudioProcessingImpl : public AudioProcessing {
   // Called by render: Holds the render lock when reading the format struct and
   // acquires both locks if reinitialization is required.
   void MaybeInitializeRender(const StreamConfig& input_config,
-                             const StreamConfig& output_config)
+                             const StreamConfig& output_config,
+                             bool independent_render_references)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
   // Called by capture: Acquires and releases the capture lock to read the
   // format struct and acquires both locks if reinitialization is needed.
@@ -253,12 +260,13 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
   void InitializeEchoController()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  void InitializeGainController1()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
 
   // Initializations of capture-only sub-modules, requiring the capture lock
   // already acquired.
   void InitializeHighPassFilter(bool forced_reset)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
-  void InitializeGainController1() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   // Initializes the `GainController2` sub-module. If the sub-module is enabled,
   // recreates it.
   void InitializeGainController2() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
@@ -287,14 +295,20 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  void AllocateGainController1RenderQueue()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
   void QueueBandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
   void QueueNonbandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
   // Capture-side exclusive methods possibly running APM in a multi-threaded
-  // manner that are called with the render lock already acquired.
+  // manner that are called with the render lock already acquired. Frames
+  // longer than 10 ms are processed chunk by chunk between a single call to
+  // PrepareCaptureFrameLocked() and to FinishCaptureFrameLocked().
+  void PrepareCaptureFrameLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   int ProcessCaptureStreamLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  void FinishCaptureFrameLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
 
   // Render-side exclusive methods possibly running APM in a multi-threaded
   // manner that are called with the render lock already acquired.
@@ -399,6 +413,9 @@ class AudioProcessingImpl : public AudioProcessing {
           render_processing_format(kSampleRate16kHz, 1) {}
     ProcessingConfig api_format;
     StreamConfig render_processing_format;
+    // Whether the render channels are independent references that must be
+    // kept separate.
+    bool independent_render_references = false;
   } formats_;
 
   // APM constants.
@@ -446,6 +463,14 @@ class AudioProcessingImpl : public AudioProcessing {
     // that audio is acquired. Unspecified when no input volume can be
     // recommended.
     std::optional<int> recommended_input_volume;
+    // Channel pointers into the current chunk of a frame longer than 10 ms.
+    std::vector<const float*> chunk_src;
+    std::vector<float*> chunk_dest;
+    // Copy of the input of a frame longer than 10 ms whose in-place processing
+    // would overwrite input chunks that are not yet read.
+    std::vector<float> staged_src;
+    std::vector<const float*> staged_src_channels;
+    std::vector<int16_t> staged_src_s16;
   } capture_ RTC_GUARDED_BY(mutex_capture_);
 
   struct ApmCaptureNonLockedState {
@@ -467,6 +492,14 @@ class AudioProcessingImpl : public AudioProcessing {
     ~ApmRenderState();
     std::unique_ptr<AudioConverter> render_converter;
     std::unique_ptr<AudioBuffer> render_audio;
+    // Channel pointers into the current chunk of a frame longer than 10 ms.
+    std::vector<const float*> chunk_src;
+    std::vector<float*> chunk_dest;
+    // Copy of the input of a frame longer than 10 ms whose in-place processing
+    // would overwrite input chunks that are not yet read.
+    std::vector<float> staged_src;
+    std::vector<const float*> staged_src_channels;
+    std::vector<int16_t> staged_src_s16;
   } render_ RTC_GUARDED_BY(mutex_render_);
 
   // Class for statistics reporting. The class is thread-safe and no lock is
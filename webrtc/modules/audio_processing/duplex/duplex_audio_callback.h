@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_AUDIO_CALLBACK_H_
+#define MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_AUDIO_CALLBACK_H_
+
+#include <stdint.h>
+
+#include "api/audio/audio_view.h"
+
+namespace webrtc {
+
+// Interface through which an audio device layer, whatever its API, passes the
+// audio it plays out and captures. The methods are called on the real-time
+// threads of the device and must not block. The audio can come in blocks of
+// any length, and the timestamps are in the rtc::TimeMicros() clock.
+class DuplexAudioCallback {
+ public:
+  virtual ~DuplexAudioCallback() = default;
+
+  // Called with audio about to be played out, `playout_time_us` being the time
+  // at which its first sample will be played out by the hardware.
+  virtual void OnRenderData(InterleavedView<const int16_t> audio,
+                            int64_t playout_time_us) = 0;
+
+  // Called with captured audio, `capture_time_us` being the time at which its
+  // first sample was captured by the hardware.
+  virtual void OnCaptureData(InterleavedView<const int16_t> audio,
+                             int64_t capture_time_us) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_AUDIO_CALLBACK_H_
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/duplex/duplex_engine.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// How long the processing thread waits for a capture frame before checking
+// whether it has been stopped.
+constexpr TimeDelta kMaxWaitTime = TimeDelta::Millis(100);
+
+}  // namespace
+
+DuplexEngine::Framer::Framer(const StreamConfig& config, size_t queue_size)
+    : num_channels_(config.num_channels()),
+      sample_rate_hz_(config.sample_rate_hz()),
+      queue_(queue_size, Frame{std::vector<int16_t>(config.num_samples())}),
+      frame_{std::vector<int16_t>(config.num_samples())} {}
+
+int DuplexEngine::Framer::Push(InterleavedView<const int16_t> audio,
+                               int64_t timestamp_us) {
+  RTC_DCHECK_EQ(audio.num_channels(), num_channels_);
+  const size_t frame_size = frame_.samples.size() / num_channels_;
+  int num_dropped = 0;
+  size_t offset = 0;
+  while (offset < audio.samples_per_channel()) {
+    if (num_buffered_ == 0) {
+      frame_.timestamp_us =
+          timestamp_us + DivideRoundToNearest(
+                             static_cast<int64_t>(offset) * 1000000,
+                             static_cast<int64_t>(sample_rate_hz_));
+    }
+    const size_t count = std::min(frame_size - num_buffered_,
+                                  audio.samples_per_channel() - offset);
+    std::memcpy(&frame_.samples[num_buffered_ * num_channels_],
+                &audio.data()[offset * num_channels_],
+                count * num_channels_ * sizeof(int16_t));
+    num_buffered_ += count;
+    offset += count;
+    if (num_buffered_ == frame_size) {
+      // A frame that does not fit is dropped, and its buffer reused.
+      if (!queue_.Insert(&frame_)) {
+        ++num_dropped;
+      }
+      num_buffered_ = 0;
+    }
+  }
+  return num_dropped;
+}
+
+DuplexEngine::DuplexEngine(const Config& config,
+                           rtc::scoped_refptr<AudioProcessing> audio_processing)
+    : config_(config),
+      apm_(std::move(audio_processing)),
+      capture_config_(config.sample_rate_hz, config.num_capture_channels),
+      render_config_(config.sample_rate_hz, config.num_render_channels),
+      render_framer_(render_config_, config.queue_size_frames),
+      capture_framer_(capture_config_, config.queue_size_frames),
+      output_queue_(config.queue_size_frames,
+                    Frame{std::vector<int16_t>(capture_config_.num_samples())}),
+      render_frame_{std::vector<int16_t>(render_config_.num_samples())},
+      capture_frame_{std::vector<int16_t>(capture_config_.num_samples())},
+      output_frame_{std::vector<int16_t>(capture_config_.num_samples())},
+      render_output_(render_config_.num_samples()),
+      read_frame_{std::vector<int16_t>(capture_config_.num_samples())} {
+  RTC_DCHECK(apm_);
+  RTC_DCHECK_GT(config.queue_size_frames, 0);
+  const int error = apm_->Initialize(ProcessingConfig{
+      {capture_config_, capture_config_, render_config_, render_config_}});
+  RTC_CHECK_EQ(error, AudioProcessing::kNoError);
+}
+
+DuplexEngine::~DuplexEngine() {
+  Stop();
+}
+
+void DuplexEngine::Start() {
+  if (!processing_thread_.empty()) {
+    return;
+  }
+  stop_requested_.store(false, std::memory_order_release);
+  processing_thread_ = rtc::PlatformThread::SpawnJoinable(
+      [this] { ProcessingLoop(); }, "DuplexEngine",
+      rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime));
+}
+
+void DuplexEngine::Stop() {
+  if (processing_thread_.empty()) {
+    return;
+  }
+  stop_requested_.store(true, std::memory_order_release);
+  frame_available_.Set();
+  processing_thread_.Finalize();
+}
+
+void DuplexEngine::OnRenderData(InterleavedView<const int16_t> audio,
+                                int64_t playout_time_us) {
+  const int num_dropped = render_framer_.Push(audio, playout_time_us);
+  if (num_dropped > 0) {
+    render_frames_dropped_.fetch_add(num_dropped, std::memory_order_relaxed);
+  }
+}
+
+void DuplexEngine::OnCaptureData(InterleavedView<const int16_t> audio,
+                                 int64_t capture_time_us) {
+  const int num_dropped = capture_framer_.Push(audio, capture_time_us);
+  if (num_dropped > 0) {
+    capture_frames_dropped_.fetch_add(num_dropped, std::memory_order_relaxed);
+  }
+  // The render frames are analyzed when the processing thread wakes up for a
+  // capture frame.
+  if (capture_framer_.queue().SizeAtLeast() > 0) {
+    frame_available_.Set();
+  }
+}
+
+bool DuplexEngine::ReadProcessedFrame(InterleavedView<int16_t> frame,
+                                      int64_t* capture_time_us) {
+  RTC_DCHECK_EQ(frame.size(), read_frame_.samples.size());
+  if (!output_queue_.Remove(&read_frame_)) {
+    return false;
+  }
+  std::copy(read_frame_.samples.begin(), read_frame_.samples.end(),
+            frame.data().begin());
+  if (capture_time_us) {
+    *capture_time_us = read_frame_.timestamp_us;
+  }
+  return true;
+}
+
+DuplexEngine::Stats DuplexEngine::GetStats() const {
+  Stats stats;
+  stats.render_frames_dropped =
+      render_frames_dropped_.load(std::memory_order_relaxed);
+  stats.capture_frames_dropped =
+      capture_frames_dropped_.load(std::memory_order_relaxed);
+  stats.output_frames_dropped =
+      output_frames_dropped_.load(std::memory_order_relaxed);
+  stats.render_errors = render_errors_.load(std::memory_order_relaxed);
+  stats.capture_errors = capture_errors_.load(std::memory_order_relaxed);
+  const int stream_delay_ms = stream_delay_ms_.load(std::memory_order_relaxed);
+  if (stream_delay_ms >= 0) {
+    stats.stream_delay_ms = stream_delay_ms;
+  }
+  return stats;
+}
+
+void DuplexEngine::ProcessingLoop() {
+  while (!stop_requested_.load(std::memory_order_acquire)) {
+    frame_available_.Wait(kMaxWaitTime);
+    ProcessQueuedFrames();
+  }
+}
+
+void DuplexEngine::ProcessQueuedFrames() {
+  // Each capture frame is processed after the render frames queued before it.
+  AnalyzeRenderFrames();
+  while (capture_framer_.queue().Remove(&capture_frame_)) {
+    ProcessCaptureFrame();
+    AnalyzeRenderFrames();
+  }
+}
+
+void DuplexEngine::AnalyzeRenderFrames() {
+  while (render_framer_.queue().Remove(&render_frame_)) {
+    render_delay_us_ = render_frame_.timestamp_us - rtc::TimeMicros();
+    const int error = apm_->ProcessReverseStream(
+        render_frame_.samples.data(), render_config_, render_config_,
+        render_output_.data());
+    if (error != AudioProcessing::kNoError) {
+      render_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void DuplexEngine::ProcessCaptureFrame() {
+  // Without render frames there is no echo to relate the capture to.
+  int delay_ms = 0;
+  if (render_delay_us_) {
+    const int64_t capture_delay_us =
+        rtc::TimeMicros() - capture_frame_.timestamp_us;
+    delay_ms = std::max<int64_t>(
+        0, DivideRoundToNearest(*render_delay_us_ + capture_delay_us,
+                                int64_t{1000}));
+    stream_delay_ms_.store(delay_ms, std::memory_order_relaxed);
+  }
+  // Values above the supported range are limited by AudioProcessing.
+  apm_->set_stream_delay_ms(delay_ms);
+
+  const int error = apm_->ProcessStream(capture_frame_.samples.data(),
+                                        capture_config_, capture_config_,
+                                        output_frame_.samples.data());
+  if (error != AudioProcessing::kNoError) {
+    capture_errors_.fetch_add(1, std::memory_order_relaxed);
+  }
+  output_frame_.timestamp_us = capture_frame_.timestamp_us;
+  if (!output_queue_.Insert(&output_frame_)) {
+    output_frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace webrtc
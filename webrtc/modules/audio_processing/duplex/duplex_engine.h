@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_ENGINE_H_
+#define MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include "api/audio/audio_processing.h"
+#include "api/audio/audio_view.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/duplex/duplex_audio_callback.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/swap_queue.h"
+
+namespace webrtc {
+
+// Runs AudioProcessing on the audio of a full-duplex device. The device
+// threads only cut their audio into timestamped 10 ms frames and pass them
+// through lock-free queues to a real-time processing thread, which analyzes
+// the render frames, processes the capture frames and queues the processed
+// frames for a reader.
+//
+// The render frames queued before a capture frame are analyzed before it is
+// processed, and the stream delay of each capture frame is computed from the
+// timestamps as
+//   delay = (t_render - t_analyze) + (t_process - t_capture)
+// for the last analyzed render frame, see AudioProcessing::set_stream_delay_ms.
+class DuplexEngine : public DuplexAudioCallback {
+ public:
+  struct Config {
+    int sample_rate_hz = 48000;
+    size_t num_capture_channels = 1;
+    size_t num_render_channels = 1;
+    // Capacity in 10 ms frames of each of the render, capture and output
+    // queues. Frames that do not fit are dropped and counted in the stats.
+    size_t queue_size_frames = 50;
+  };
+
+  struct Stats {
+    int64_t render_frames_dropped = 0;
+    int64_t capture_frames_dropped = 0;
+    int64_t output_frames_dropped = 0;
+    // Frames for which ProcessReverseStream() and ProcessStream() returned an
+    // error.
+    int64_t render_errors = 0;
+    int64_t capture_errors = 0;
+    // The stream delay of the last processed capture frame.
+    std::optional<int> stream_delay_ms;
+  };
+
+  DuplexEngine(const Config& config,
+               rtc::scoped_refptr<AudioProcessing> audio_processing);
+  ~DuplexEngine() override;
+
+  DuplexEngine(const DuplexEngine&) = delete;
+  DuplexEngine& operator=(const DuplexEngine&) = delete;
+
+  // Starts and stops the processing thread. Frames passed while it is stopped
+  // are queued, or dropped once the queues are full.
+  void Start();
+  void Stop();
+
+  // DuplexAudioCallback implementation. Each of them must be called from a
+  // single thread at a time.
+  void OnRenderData(InterleavedView<const int16_t> audio,
+                    int64_t playout_time_us) override;
+  void OnCaptureData(InterleavedView<const int16_t> audio,
+                     int64_t capture_time_us) override;
+
+  // Pops the next processed capture frame into `frame`, which must hold
+  // frame_size() samples per channel, and sets `capture_time_us` to the
+  // capture time of its first sample. Returns false if no frame is available.
+  // Must be called from a single thread at a time.
+  bool ReadProcessedFrame(InterleavedView<int16_t> frame,
+                          int64_t* capture_time_us);
+
+  Stats GetStats() const;
+
+  // Number of samples per channel of the 10 ms frames.
+  size_t frame_size() const { return capture_config_.num_frames(); }
+  const Config& config() const { return config_; }
+  AudioProcessing* audio_processing() const { return apm_.get(); }
+
+ private:
+  struct Frame {
+    std::vector<int16_t> samples;
+    int64_t timestamp_us = 0;
+  };
+
+  // Cuts blocks of any length into timestamped frames on a device thread.
+  class Framer {
+   public:
+    Framer(const StreamConfig& config, size_t queue_size);
+    // Returns the number of frames that were complete but did not fit in the
+    // queue.
+    int Push(InterleavedView<const int16_t> audio, int64_t timestamp_us);
+    SwapQueue<Frame>& queue() { return queue_; }
+
+   private:
+    const size_t num_channels_;
+    const int sample_rate_hz_;
+    SwapQueue<Frame> queue_;
+    Frame frame_;
+    size_t num_buffered_ = 0;
+  };
+
+  void ProcessingLoop();
+  void ProcessQueuedFrames();
+  void AnalyzeRenderFrames();
+  void ProcessCaptureFrame();
+
+  const Config config_;
+  const rtc::scoped_refptr<AudioProcessing> apm_;
+  const StreamConfig capture_config_;
+  const StreamConfig render_config_;
+
+  Framer render_framer_;
+  Framer capture_framer_;
+  SwapQueue<Frame> output_queue_;
+
+  // Only accessed by the processing thread.
+  Frame render_frame_;
+  Frame capture_frame_;
+  Frame output_frame_;
+  std::vector<int16_t> render_output_;
+  std::optional<int64_t> render_delay_us_;
+
+  // Only accessed by the reader.
+  Frame read_frame_;
+
+  rtc::Event frame_available_;
+  std::atomic<bool> stop_requested_{false};
+  rtc::PlatformThread processing_thread_;
+
+  std::atomic<int64_t> render_frames_dropped_{0};
+  std::atomic<int64_t> capture_frames_dropped_{0};
+  std::atomic<int64_t> output_frames_dropped_{0};
+  std::atomic<int64_t> render_errors_{0};
+  std::atomic<int64_t> capture_errors_{0};
+  std::atomic<int> stream_delay_ms_{-1};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_DUPLEX_DUPLEX_ENGINE_H_
@@ -18,6 +18,7 @@
 #include "modules/audio_processing/aecm/echo_control_mobile.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -98,6 +99,10 @@ class EchoControlMobileImpl::Canceller {
     RTC_DCHECK_EQ(AudioProcessing::kNoError, error);
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + WebRtcAecm_MemoryUsage(state_);
+  }
+
  private:
   void* state_;
 };
@@ -107,6 +112,11 @@ EchoControlMobileImpl::EchoControlMobileImpl()
 
 EchoControlMobileImpl::~EchoControlMobileImpl() {}
 
+size_t EchoControlMobileImpl::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(cancellers_) +
+         HeapBytes(stream_properties_) + HeapBytes(low_pass_reference_);
+}
+
 void EchoControlMobileImpl::ProcessRenderAudio(
     rtc::ArrayView<const int16_t> packed_render_audio) {
   RTC_DCHECK(stream_properties_);
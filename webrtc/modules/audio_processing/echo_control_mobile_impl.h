@@ -67,6 +67,9 @@ class EchoControlMobileImpl {
   static size_t NumCancellersRequired(size_t num_output_channels,
                                       size_t num_reverse_channels);
 
+  // Returns the size of the cancellers and of the render reference buffers.
+  size_t MemoryUsage() const;
+
  private:
   class Canceller;
   struct StreamProperties;
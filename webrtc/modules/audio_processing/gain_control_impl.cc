@@ -19,8 +19,18 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "system_wrappers/include/field_trial.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
 typedef void Handle;
@@ -39,28 +49,92 @@ int16_t MapSetting(GainControl::Mode mode) {
   return -1;
 }
 
-// Applies the sub-frame `gains` to all the bands in `out` and clamps the output
-// in the signed 16 bit range.
-void ApplyDigitalGain(const int32_t gains[11],
+bool UseFloatDigitalPath() {
+  return !field_trial::IsEnabled("WebRTC-Agc1FloatDigitalPathKillSwitch");
+}
+
+bool IsSimdAvailable() {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  return GetCPUInfo(kSSE2) != 0;
+#elif defined(WEBRTC_HAS_NEON)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Applies the sub-frame linear `gains` to all the bands in `out` and clamps
+// the output in the signed 16 bit range. The gain is linearly interpolated
+// within each sub-frame. The SIMD and the scalar code produce identical
+// results.
+void ApplyDigitalGain(const float gains[11],
+                      bool use_simd,
                       size_t num_bands,
                       float* const* out) {
-  constexpr float kScaling = 1.f / 65536.f;
   constexpr int kNumSubSections = 16;
   constexpr float kOneByNumSubSections = 1.f / kNumSubSections;
 
-  float gains_scaled[11];
-  for (int k = 0; k < 11; ++k) {
-    gains_scaled[k] = gains[k] * kScaling;
+  for (size_t b = 0; b < num_bands; ++b) {
+    for (int k = 0; k < 10; ++k) {
+      float* out_sub = &out[b][k * kNumSubSections];
+      const float gain = gains[k];
+      const float delta = (gains[k + 1] - gains[k]) * kOneByNumSubSections;
+      int n = 0;
+      if (use_simd) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+        const __m128 gain_v = _mm_set1_ps(gain);
+        const __m128 delta_v = _mm_set1_ps(delta);
+        const __m128 max_v = _mm_set1_ps(32767.f);
+        const __m128 min_v = _mm_set1_ps(-32768.f);
+        __m128 index = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+        const __m128 four = _mm_set1_ps(4.f);
+        for (; n < kNumSubSections; n += 4) {
+          const __m128 g = _mm_add_ps(gain_v, _mm_mul_ps(index, delta_v));
+          __m128 x = _mm_mul_ps(_mm_loadu_ps(&out_sub[n]), g);
+          x = _mm_min_ps(max_v, _mm_max_ps(min_v, x));
+          _mm_storeu_ps(&out_sub[n], x);
+          index = _mm_add_ps(index, four);
+        }
+#elif defined(WEBRTC_HAS_NEON)
+        const float32x4_t gain_v = vdupq_n_f32(gain);
+        const float32x4_t delta_v = vdupq_n_f32(delta);
+        const float32x4_t max_v = vdupq_n_f32(32767.f);
+        const float32x4_t min_v = vdupq_n_f32(-32768.f);
+        const float kIndex[4] = {0.f, 1.f, 2.f, 3.f};
+        float32x4_t index = vld1q_f32(kIndex);
+        const float32x4_t four = vdupq_n_f32(4.f);
+        for (; n < kNumSubSections; n += 4) {
+          const float32x4_t g = vaddq_f32(gain_v, vmulq_f32(index, delta_v));
+          float32x4_t x = vmulq_f32(vld1q_f32(&out_sub[n]), g);
+          x = vminq_f32(max_v, vmaxq_f32(min_v, x));
+          vst1q_f32(&out_sub[n], x);
+          index = vaddq_f32(index, four);
+        }
+#endif
+      }
+      for (; n < kNumSubSections; ++n) {
+        const float x = out_sub[n] * (gain + n * delta);
+        out_sub[n] = std::min(32767.f, std::max(-32768.f, x));
+      }
+    }
   }
+}
+
+// Applies the sub-frame linear `gains` as ApplyDigitalGain() does, but with
+// the gain ramp accumulated sample by sample as the fixed-point path always
+// has, so that the output of that path is unchanged.
+void ApplyDigitalGainAccumulated(const float gains[11],
+                                 size_t num_bands,
+                                 float* const* out) {
+  constexpr int kNumSubSections = 16;
+  constexpr float kOneByNumSubSections = 1.f / kNumSubSections;
 
   for (size_t b = 0; b < num_bands; ++b) {
     float* out_band = out[b];
     for (int k = 0, sample = 0; k < 10; ++k) {
-      const float delta =
-          (gains_scaled[k + 1] - gains_scaled[k]) * kOneByNumSubSections;
-      float gain = gains_scaled[k];
+      const float delta = (gains[k + 1] - gains[k]) * kOneByNumSubSections;
+      float gain = gains[k];
       for (int n = 0; n < kNumSubSections; ++n, ++sample) {
-        RTC_DCHECK_EQ(k * kNumSubSections + n, sample);
         out_band[sample] *= gain;
         out_band[sample] =
             std::min(32767.f, std::max(-32768.f, out_band[sample]));
@@ -85,7 +159,11 @@ struct GainControlImpl::MonoAgcState {
 
   MonoAgcState(const MonoAgcState&) = delete;
   MonoAgcState& operator=(const MonoAgcState&) = delete;
-  int32_t gains[11];
+  size_t MemoryUsage() const {
+    return sizeof(*this) + WebRtcAgc_MemoryUsage();
+  }
+  // Linear gains.
+  float gains[11];
   Handle* state;
 };
 
@@ -101,10 +179,16 @@ GainControlImpl::GainControlImpl()
       compression_gain_db_(9),
       analog_capture_level_(0),
       was_analog_level_set_(false),
-      stream_is_saturated_(false) {}
+      stream_is_saturated_(false),
+      use_float_digital_path_(UseFloatDigitalPath()),
+      use_simd_(IsSimdAvailable()) {}
 
 GainControlImpl::~GainControlImpl() = default;
 
+size_t GainControlImpl::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(mono_agcs_) + HeapBytes(capture_levels_);
+}
+
 void GainControlImpl::ProcessRenderAudio(
     rtc::ArrayView<const int16_t> packed_render_audio) {
   for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
@@ -147,20 +231,20 @@ int GainControlImpl::AnalyzeCaptureAudio(const AudioBuffer& audio) {
   RTC_DCHECK_EQ(audio.num_channels(), *num_proc_channels_);
   RTC_DCHECK_LE(*num_proc_channels_, mono_agcs_.size());
 
-  int16_t split_band_data[AudioBuffer::kMaxNumBands]
-                         [AudioBuffer::kMaxSplitFrameLength];
-  int16_t* split_bands[AudioBuffer::kMaxNumBands] = {
-      split_band_data[0], split_band_data[1], split_band_data[2]};
+  // The analysis only depends on the lowest band, so only that one is
+  // converted to 16 bit.
+  int16_t split_band_data[AudioBuffer::kMaxSplitFrameLength];
+  int16_t* split_bands[1] = {split_band_data};
 
   if (mode_ == kAdaptiveAnalog) {
     for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
       capture_levels_[ch] = analog_capture_level_;
 
-      audio.ExportSplitChannelData(ch, split_bands);
+      FloatS16ToS16(audio.split_bands_const(ch)[kBand0To8kHz],
+                    audio.num_frames_per_band(), split_band_data);
 
-      int err =
-          WebRtcAgc_AddMic(mono_agcs_[ch]->state, split_bands,
-                           audio.num_bands(), audio.num_frames_per_band());
+      int err = WebRtcAgc_AddMic(mono_agcs_[ch]->state, split_bands, 1,
+                                 audio.num_frames_per_band());
 
       if (err != AudioProcessing::kNoError) {
         return AudioProcessing::kUnspecifiedError;
@@ -170,12 +254,12 @@ int GainControlImpl::AnalyzeCaptureAudio(const AudioBuffer& audio) {
     for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
       int32_t capture_level_out = 0;
 
-      audio.ExportSplitChannelData(ch, split_bands);
+      FloatS16ToS16(audio.split_bands_const(ch)[kBand0To8kHz],
+                    audio.num_frames_per_band(), split_band_data);
 
-      int err =
-          WebRtcAgc_VirtualMic(mono_agcs_[ch]->state, split_bands,
-                               audio.num_bands(), audio.num_frames_per_band(),
-                               analog_capture_level_, &capture_level_out);
+      int err = WebRtcAgc_VirtualMic(
+          mono_agcs_[ch]->state, split_bands, 1, audio.num_frames_per_band(),
+          analog_capture_level_, &capture_level_out);
 
       capture_levels_[ch] = capture_level_out;
 
@@ -202,20 +286,33 @@ int GainControlImpl::ProcessCaptureAudio(AudioBuffer* audio,
   stream_is_saturated_ = false;
   bool error_reported = false;
   for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
-    int16_t split_band_data[AudioBuffer::kMaxNumBands]
-                           [AudioBuffer::kMaxSplitFrameLength];
-    int16_t* split_bands[AudioBuffer::kMaxNumBands] = {
-        split_band_data[0], split_band_data[1], split_band_data[2]};
-    audio->ExportSplitChannelData(ch, split_bands);
+    const float* split_band = audio->split_bands_const(ch)[kBand0To8kHz];
 
     // The call to stream_has_echo() is ok from a deadlock perspective
     // as the capture lock is allready held.
     int32_t new_capture_level = 0;
     uint8_t saturation_warning = 0;
-    int err_analyze = WebRtcAgc_Analyze(
-        mono_agcs_[ch]->state, split_bands, audio->num_bands(),
-        audio->num_frames_per_band(), capture_levels_[ch], &new_capture_level,
-        stream_has_echo, &saturation_warning, mono_agcs_[ch]->gains);
+    int err_analyze;
+    if (use_float_digital_path_) {
+      err_analyze = WebRtcAgc_AnalyzeFloat(
+          mono_agcs_[ch]->state, split_band, audio->num_frames_per_band(),
+          capture_levels_[ch], &new_capture_level, stream_has_echo,
+          &saturation_warning, mono_agcs_[ch]->gains);
+    } else {
+      // The digital gains only depend on the lowest band.
+      int16_t split_band_data[AudioBuffer::kMaxSplitFrameLength];
+      int16_t* split_bands[1] = {split_band_data};
+      FloatS16ToS16(split_band, audio->num_frames_per_band(), split_band_data);
+      int32_t gains[11];
+      err_analyze = WebRtcAgc_Analyze(
+          mono_agcs_[ch]->state, split_bands, 1, audio->num_frames_per_band(),
+          capture_levels_[ch], &new_capture_level, stream_has_echo,
+          &saturation_warning, gains);
+      constexpr float kScaling = 1.f / 65536.f;
+      for (int k = 0; k < 11; ++k) {
+        mono_agcs_[ch]->gains[k] = gains[k] * kScaling;
+      }
+    }
     capture_levels_[ch] = new_capture_level;
 
     error_reported = error_reported || err_analyze != AudioProcessing::kNoError;
@@ -232,8 +329,13 @@ int GainControlImpl::ProcessCaptureAudio(AudioBuffer* audio,
   }
 
   for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
-    ApplyDigitalGain(mono_agcs_[index_to_apply]->gains, audio->num_bands(),
-                     audio->split_bands(ch));
+    if (use_float_digital_path_) {
+      ApplyDigitalGain(mono_agcs_[index_to_apply]->gains, use_simd_,
+                       audio->num_bands(), audio->split_bands(ch));
+    } else {
+      ApplyDigitalGainAccumulated(mono_agcs_[index_to_apply]->gains,
+                                  audio->num_bands(), audio->split_bands(ch));
+    }
   }
 
   RTC_DCHECK_LT(0ul, *num_proc_channels_);
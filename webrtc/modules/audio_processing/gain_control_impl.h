@@ -55,6 +55,9 @@ class GainControlImpl : public GainControl {
   int enable_limiter(bool enable) override;
   int set_stream_analog_level(int level) override;
 
+  // Returns the size of the mono AGCs and of their state.
+  size_t MemoryUsage() const;
+
  private:
   struct MonoAgcState;
 
@@ -77,6 +80,10 @@ class GainControlImpl : public GainControl {
   int analog_capture_level_ = 0;
   bool was_analog_level_set_;
   bool stream_is_saturated_;
+  // Whether to compute the digital gains in floating point rather than with
+  // the legacy fixed-point code.
+  const bool use_float_digital_path_;
+  const bool use_simd_;
 
   std::vector<std::unique_ptr<MonoAgcState>> mono_agcs_;
   std::vector<int> capture_levels_;
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/heap_bytes.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -35,6 +36,11 @@ constexpr int kLogLimiterStatsPeriodMs = 30'000;
 constexpr int kFrameLengthMs = 10;
 constexpr int kLogLimiterStatsPeriodNumFrames =
     kLogLimiterStatsPeriodMs / kFrameLengthMs;
+constexpr int kMaxAnalysisPeriodFrames = 10;
+
+// When the analysis is decimated, it runs on bursts of consecutive frames
+// since the VAD does not detect speech reliably when fed isolated frames.
+constexpr int kAnalysisBurstFrames = 4;
 
 // Detects the available CPU features and applies any kill-switches.
 AvailableCpuFeatures GetAllowedCpuFeatures() {
@@ -64,7 +70,7 @@ struct SpeechLevel {
 };
 
 // Computes the audio levels for the first channel in `frame`.
-AudioLevels ComputeAudioLevels(DeinterleavedView<float> frame,
+AudioLevels ComputeAudioLevels(DeinterleavedView<const float> frame,
                                ApmDataDumper& data_dumper) {
   float peak = 0.0f;
   float rms = 0.0f;
@@ -97,7 +103,10 @@ GainController2::GainController2(
           /*initial_gain_factor=*/DbToRatio(config.fixed_digital.gain_db)),
       limiter_(&data_dumper_,
                SampleRateToDefaultChannelSize(sample_rate_hz),
-               /*histogram_name_prefix=*/"Agc2"),
+               /*histogram_name_prefix=*/"Agc2",
+               cpu_features_),
+      analysis_period_frames_(config.analysis_period_frames),
+      analysis_frame_counter_(0),
       calls_since_last_limiter_log_(0) {
   RTC_DCHECK(Validate(config));
   data_dumper_.InitiateNewSetOfRecordings();
@@ -170,6 +179,66 @@ void GainController2::Analyze(int applied_input_volume,
 void GainController2::Process(std::optional<float> speech_probability,
                               bool input_volume_changed,
                               AudioBuffer* audio) {
+  DeinterleavedView<float> float_frame = audio->view();
+  const std::optional<AdaptiveDigitalGainController::FrameInfo> info =
+      AnalyzeFrame(speech_probability, input_volume_changed, float_frame);
+  if (info.has_value()) {
+    adaptive_digital_controller_->Process(*info, float_frame);
+  }
+
+  // TODO(bugs.webrtc.org/7494): Pass `audio_levels` to remove duplicated
+  // computation in `limiter_`.
+  fixed_gain_applier_.ApplyGain(float_frame);
+
+  limiter_.Process(float_frame);
+
+  MaybeLogLimiterStats();
+}
+
+GainController2::FrameGains GainController2::ComputeGains(
+    std::optional<float> speech_probability,
+    bool input_volume_changed,
+    DeinterleavedView<const float> audio) {
+  const std::optional<AdaptiveDigitalGainController::FrameInfo> info =
+      AnalyzeFrame(speech_probability, input_volume_changed, audio);
+  AdaptiveDigitalGainController::GainRamp adaptive_gain = {1.f, 1.f};
+  if (info.has_value()) {
+    adaptive_gain = adaptive_digital_controller_->ComputeGain(*info);
+  }
+  const float fixed_gain = fixed_gain_applier_.GetGainFactor();
+
+  // Gain before the limiter at the start of each sub-frame and at the end of
+  // the frame.
+  std::array<float, kSubFramesInFrame + 1> gains_before_limiter;
+  for (int k = 0; k <= kSubFramesInFrame; ++k) {
+    const float adaptive =
+        adaptive_gain.start + (adaptive_gain.end - adaptive_gain.start) *
+                                  k / static_cast<float>(kSubFramesInFrame);
+    gains_before_limiter[k] = adaptive * fixed_gain;
+  }
+
+  // The limiter analyzes the signal after the gains, of which the peaks are
+  // bounded using the largest gain within each sub-frame.
+  std::array<float, kSubFramesInFrame> sub_frame_peaks =
+      limiter_.ComputeSubFramePeaks(audio);
+  for (int k = 0; k < kSubFramesInFrame; ++k) {
+    sub_frame_peaks[k] *=
+        std::max(gains_before_limiter[k], gains_before_limiter[k + 1]);
+  }
+  FrameGains gains = limiter_.ComputeGains(sub_frame_peaks);
+  for (int k = 0; k < kSubFramesInFrame; ++k) {
+    gains[k].start *= gains_before_limiter[k];
+    gains[k].end *= gains_before_limiter[k + 1];
+  }
+
+  MaybeLogLimiterStats();
+  return gains;
+}
+
+std::optional<AdaptiveDigitalGainController::FrameInfo>
+GainController2::AnalyzeFrame(std::optional<float> speech_probability,
+                              bool input_volume_changed,
+                              DeinterleavedView<const float> float_frame) {
   recommended_input_volume_ = std::nullopt;
 
   data_dumper_.DumpRaw("agc2_applied_input_volume_changed",
@@ -182,7 +251,14 @@ void GainController2::Process(std::optional<float> speech_probability,
       saturation_protector_->Reset();
   }
 
-  DeinterleavedView<float> float_frame = audio->view();
+  // Analyze the signal in one of every `analysis_period_frames_` bursts of
+  // `kAnalysisBurstFrames` frames; the estimators below are updated every
+  // frame with the latest results.
+  const bool analyze_signal = analysis_frame_counter_ < kAnalysisBurstFrames;
+  if (++analysis_frame_counter_ ==
+      analysis_period_frames_ * kAnalysisBurstFrames) {
+    analysis_frame_counter_ = 0;
+  }
 
   // Compute speech probability.
   if (vad_) {
@@ -190,7 +266,10 @@ void GainController2::Process(std::optional<float> speech_probability,
     // because APM should not run the same VAD twice (as an APM sub-module and
     // internally in AGC2).
     RTC_DCHECK(!speech_probability.has_value());
-    speech_probability = vad_->Analyze(float_frame);
+    if (analyze_signal) {
+      last_analysis_.speech_probability = vad_->Analyze(float_frame);
+    }
+    speech_probability = last_analysis_.speech_probability;
   }
   if (speech_probability.has_value()) {
     RTC_DCHECK_GE(*speech_probability, 0.0f);
@@ -202,18 +281,24 @@ void GainController2::Process(std::optional<float> speech_probability,
     data_dumper_.DumpRaw("agc2_speech_probability", *speech_probability);
 
   // Compute audio, noise and speech levels.
-  AudioLevels audio_levels = ComputeAudioLevels(float_frame, data_dumper_);
-  std::optional<float> noise_rms_dbfs;
-  if (noise_level_estimator_) {
-    // TODO(bugs.webrtc.org/7494): Pass `audio_levels` to remove duplicated
-    // computation in `noise_level_estimator_`.
-    noise_rms_dbfs = noise_level_estimator_->Analyze(float_frame);
+  if (analyze_signal) {
+    const AudioLevels audio_levels =
+        ComputeAudioLevels(float_frame, data_dumper_);
+    last_analysis_.peak_dbfs = audio_levels.peak_dbfs;
+    last_analysis_.rms_dbfs = audio_levels.rms_dbfs;
+    if (noise_level_estimator_) {
+      // TODO(bugs.webrtc.org/7494): Pass `audio_levels` to remove duplicated
+      // computation in `noise_level_estimator_`.
+      last_analysis_.noise_rms_dbfs =
+          noise_level_estimator_->Analyze(float_frame);
+    }
   }
   std::optional<SpeechLevel> speech_level;
   if (speech_level_estimator_) {
     RTC_DCHECK(speech_probability.has_value());
-    speech_level_estimator_->Update(
-        audio_levels.rms_dbfs, audio_levels.peak_dbfs, *speech_probability);
+    speech_level_estimator_->Update(last_analysis_.rms_dbfs,
+                                    last_analysis_.peak_dbfs,
+                                    *speech_probability);
     speech_level =
         SpeechLevel{.is_confident = speech_level_estimator_->is_confident(),
                     .rms_dbfs = speech_level_estimator_->level_dbfs()};
@@ -237,30 +322,32 @@ void GainController2::Process(std::optional<float> speech_probability,
     RTC_DCHECK(saturation_protector_);
     RTC_DCHECK(speech_probability.has_value());
     RTC_DCHECK(speech_level.has_value());
-    saturation_protector_->Analyze(*speech_probability, audio_levels.peak_dbfs,
+    saturation_protector_->Analyze(*speech_probability,
+                                   last_analysis_.peak_dbfs,
                                    speech_level->rms_dbfs);
     float headroom_db = saturation_protector_->HeadroomDb();
     data_dumper_.DumpRaw("agc2_headroom_db", headroom_db);
     float limiter_envelope_dbfs = FloatS16ToDbfs(limiter_.LastAudioLevel());
     data_dumper_.DumpRaw("agc2_limiter_envelope_dbfs", limiter_envelope_dbfs);
-    RTC_DCHECK(noise_rms_dbfs.has_value());
-    adaptive_digital_controller_->Process(
-        /*info=*/{.speech_probability = *speech_probability,
-                  .speech_level_dbfs = speech_level->rms_dbfs,
-                  .speech_level_reliable = speech_level->is_confident,
-                  .noise_rms_dbfs = *noise_rms_dbfs,
-                  .headroom_db = headroom_db,
-                  .limiter_envelope_dbfs = limiter_envelope_dbfs},
-        float_frame);
+    RTC_DCHECK(last_analysis_.noise_rms_dbfs.has_value());
+    return AdaptiveDigitalGainController::FrameInfo{
+        .speech_probability = *speech_probability,
+        .speech_level_dbfs = speech_level->rms_dbfs,
+        .speech_level_reliable = speech_level->is_confident,
+        .noise_rms_dbfs = *last_analysis_.noise_rms_dbfs,
+        .headroom_db = headroom_db,
+        .limiter_envelope_dbfs = limiter_envelope_dbfs};
   }
+  return std::nullopt;
+}
 
-  // TODO(bugs.webrtc.org/7494): Pass `audio_levels` to remove duplicated
-  // computation in `limiter_`.
-  fixed_gain_applier_.ApplyGain(float_frame);
-
-  limiter_.Process(float_frame);
+size_t GainController2::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(vad_) + HeapBytes(speech_level_estimator_) +
+         HeapBytes(input_volume_controller_) +
+         HeapBytes(adaptive_digital_controller_);
+}
 
-  // Periodically log limiter stats.
+void GainController2::MaybeLogLimiterStats() {
   if (++calls_since_last_limiter_log_ == kLogLimiterStatsPeriodNumFrames) {
     calls_since_last_limiter_log_ = 0;
     InterpolatedGainCurve::Stats stats = limiter_.GetGainCurveStats();
@@ -280,7 +367,9 @@ bool GainController2::Validate(
          adaptive.headroom_db >= 0.0f && adaptive.max_gain_db > 0.0f &&
          adaptive.initial_gain_db >= 0.0f &&
          adaptive.max_gain_change_db_per_second > 0.0f &&
-         adaptive.max_output_noise_level_dbfs <= 0.0f;
+         adaptive.max_output_noise_level_dbfs <= 0.0f &&
+         config.analysis_period_frames >= 1 &&
+         config.analysis_period_frames <= kMaxAnalysisPeriodFrames;
 }
 
 }  // namespace webrtc
@@ -11,12 +11,14 @@
 #ifndef MODULES_AUDIO_PROCESSING_GAIN_CONTROLLER2_H_
 #define MODULES_AUDIO_PROCESSING_GAIN_CONTROLLER2_H_
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <string>
 
 #include "api/audio/audio_processing.h"
 #include "modules/audio_processing/agc2/adaptive_digital_gain_controller.h"
+#include "modules/audio_processing/agc2/agc2_common.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/gain_applier.h"
 #include "modules/audio_processing/agc2/input_volume_controller.h"
@@ -73,6 +75,23 @@ class GainController2 {
                bool input_volume_changed,
                AudioBuffer* audio);
 
+  // Gain of each of the `kSubFramesInFrame` sub-frames of a 10 ms frame. The
+  // gain of the j-th of the n samples of a sub-frame is
+  // `start + (end - start) * j / n`.
+  using SubframeGain = Limiter::SubframeGain;
+  using FrameGains = Limiter::FrameGains;
+
+  // Analysis-only alternative to `Process()`, for callers that apply the gain
+  // themselves (e.g., while mixing). Updates the state as `Process()` does for
+  // `audio` but leaves it untouched, and returns the combined adaptive digital,
+  // fixed digital and limiter gains. Hard-clipping is left to the caller.
+  // While the adaptive digital gain changes, the limiter input level is
+  // slightly overestimated. An instance should be used either with
+  // `Process()` or with `ComputeGains()`.
+  FrameGains ComputeGains(std::optional<float> speech_probability,
+                          bool input_volume_changed,
+                          DeinterleavedView<const float> audio);
+
   static bool Validate(const AudioProcessing::Config::GainController2& config);
 
   AvailableCpuFeatures GetCpuFeatures() const { return cpu_features_; }
@@ -81,7 +100,27 @@ class GainController2 {
     return recommended_input_volume_;
   }
 
+  // Returns the size of the controller, including its VAD and estimators.
+  size_t MemoryUsage() const;
+
  private:
+  // Runs the analysis shared by `Process()` and `ComputeGains()`. Returns the
+  // input of the adaptive digital controller if the controller is enabled.
+  std::optional<AdaptiveDigitalGainController::FrameInfo> AnalyzeFrame(
+      std::optional<float> speech_probability,
+      bool input_volume_changed,
+      DeinterleavedView<const float> float_frame);
+  void MaybeLogLimiterStats();
+
+  // Results of the signal analysis, which are reused until the next analyzed
+  // frame.
+  struct SignalAnalysis {
+    std::optional<float> speech_probability;
+    float peak_dbfs = kMinLevelDbfs;
+    float rms_dbfs = kMinLevelDbfs;
+    std::optional<float> noise_rms_dbfs;
+  };
+
   static std::atomic<int> instance_count_;
   const AvailableCpuFeatures cpu_features_;
   ApmDataDumper data_dumper_;
@@ -96,6 +135,10 @@ class GainController2 {
   std::unique_ptr<AdaptiveDigitalGainController> adaptive_digital_controller_;
   Limiter limiter_;
 
+  const int analysis_period_frames_;
+  int analysis_frame_counter_;
+  SignalAnalysis last_analysis_;
+
   int calls_since_last_limiter_log_;
 
   // TODO(bugs.webrtc.org/7494): Remove intermediate storing at this level once
@@ -53,63 +53,48 @@ const CascadedBiQuadFilter::BiQuadCoefficients& ChooseCoefficients(
 }  // namespace
 
 HighPassFilter::HighPassFilter(int sample_rate_hz, size_t num_channels)
-    : sample_rate_hz_(sample_rate_hz) {
-  filters_.resize(num_channels);
-  const auto& coefficients = ChooseCoefficients(sample_rate_hz_);
-  for (size_t k = 0; k < filters_.size(); ++k) {
-    filters_[k].reset(
-        new CascadedBiQuadFilter(coefficients, kNumberOfHighPassBiQuads));
-  }
-}
+    : sample_rate_hz_(sample_rate_hz),
+      filter_(ChooseCoefficients(sample_rate_hz_),
+              kNumberOfHighPassBiQuads,
+              num_channels),
+      channel_pointers_(num_channels) {}
 
 HighPassFilter::~HighPassFilter() = default;
 
 void HighPassFilter::Process(AudioBuffer* audio, bool use_split_band_data) {
   RTC_DCHECK(audio);
-  RTC_DCHECK_EQ(filters_.size(), audio->num_channels());
+  RTC_DCHECK_EQ(filter_.num_channels(), audio->num_channels());
   if (use_split_band_data) {
     for (size_t k = 0; k < audio->num_channels(); ++k) {
-      rtc::ArrayView<float> channel_data = rtc::ArrayView<float>(
-          audio->split_bands(k)[0], audio->num_frames_per_band());
-      filters_[k]->Process(channel_data);
+      channel_pointers_[k] = audio->split_bands(k)[0];
     }
+    filter_.Process(channel_pointers_, audio->num_frames_per_band());
   } else {
-    for (size_t k = 0; k < audio->num_channels(); ++k) {
-      rtc::ArrayView<float> channel_data =
-          rtc::ArrayView<float>(&audio->channels()[k][0], audio->num_frames());
-      filters_[k]->Process(channel_data);
-    }
+    filter_.Process(rtc::ArrayView<float* const>(audio->channels(),
+                                                 audio->num_channels()),
+                    audio->num_frames());
   }
 }
 
 void HighPassFilter::Process(std::vector<std::vector<float>>* audio) {
-  RTC_DCHECK_EQ(filters_.size(), audio->size());
+  RTC_DCHECK_EQ(filter_.num_channels(), audio->size());
+  if (audio->empty()) {
+    return;
+  }
   for (size_t k = 0; k < audio->size(); ++k) {
-    filters_[k]->Process((*audio)[k]);
+    RTC_DCHECK_EQ((*audio)[0].size(), (*audio)[k].size());
+    channel_pointers_[k] = (*audio)[k].data();
   }
+  filter_.Process(channel_pointers_, (*audio)[0].size());
 }
 
 void HighPassFilter::Reset() {
-  for (size_t k = 0; k < filters_.size(); ++k) {
-    filters_[k]->Reset();
-  }
+  filter_.Reset();
 }
 
 void HighPassFilter::Reset(size_t num_channels) {
-  const size_t old_num_channels = filters_.size();
-  filters_.resize(num_channels);
-  if (filters_.size() < old_num_channels) {
-    Reset();
-  } else {
-    for (size_t k = 0; k < old_num_channels; ++k) {
-      filters_[k]->Reset();
-    }
-    const auto& coefficients = ChooseCoefficients(sample_rate_hz_);
-    for (size_t k = old_num_channels; k < filters_.size(); ++k) {
-      filters_[k].reset(
-          new CascadedBiQuadFilter(coefficients, kNumberOfHighPassBiQuads));
-    }
-  }
+  filter_.Reset(num_channels);
+  channel_pointers_.resize(num_channels);
 }
 
 }  // namespace webrtc
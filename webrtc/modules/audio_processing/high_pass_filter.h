@@ -11,11 +11,11 @@
 #ifndef MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
 #define MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
 
-#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
-#include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "modules/audio_processing/utility/multi_channel_cascaded_biquad_filter.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -34,11 +34,16 @@ class HighPassFilter {
   void Reset(size_t num_channels);
 
   int sample_rate_hz() const { return sample_rate_hz_; }
-  size_t num_channels() const { return filters_.size(); }
+  size_t num_channels() const { return filter_.num_channels(); }
+
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(filter_) + HeapBytes(channel_pointers_);
+  }
 
  private:
   const int sample_rate_hz_;
-  std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters_;
+  MultiChannelCascadedBiQuadFilter filter_;
+  std::vector<float*> channel_pointers_;
 };
 }  // namespace webrtc
 
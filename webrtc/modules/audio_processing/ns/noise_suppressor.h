@@ -22,6 +22,7 @@
 #include "modules/audio_processing/ns/ns_fft.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -49,6 +50,14 @@ class NoiseSuppressor {
     capture_output_used_ = capture_output_used;
   }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(fft_) +
+           HeapBytes(filter_bank_states_heap_) +
+           HeapBytes(upper_band_gains_heap_) +
+           HeapBytes(energies_before_filtering_heap_) +
+           HeapBytes(gain_adjustments_heap_) + HeapBytes(channels_);
+  }
+
  private:
   const size_t num_bands_;
   const size_t num_channels_;
@@ -68,6 +77,10 @@ class NoiseSuppressor {
     std::array<float, kOverlapSize> process_analysis_memory;
     std::array<float, kOverlapSize> process_synthesis_memory;
     std::vector<std::array<float, kOverlapSize>> process_delay_memory;
+
+    size_t MemoryUsage() const {
+      return sizeof(*this) + HeapBytes(process_delay_memory);
+    }
   };
 
   struct FilterBankState {
@@ -10,25 +10,31 @@
 
 #include "modules/audio_processing/ns/ns_fft.h"
 
-#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
-NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
-  // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
-  // initialization)
-  bit_reversal_state_[0] = 0.f;
-  std::array<float, kFftSize> tmp_buffer;
-  tmp_buffer.fill(0.f);
-  WebRtc_rdft(kFftSize, 1, tmp_buffer.data(), bit_reversal_state_.data(),
-              tables_.data());
+namespace {
+
+RealFft::Backend SelectBackend() {
+  return Pffft::IsSimdEnabled() &&
+                 !field_trial::IsEnabled("WebRTC-NsPffftKillSwitch")
+             ? RealFft::Backend::kPffft
+             : RealFft::Backend::kOoura;
 }
 
+}  // namespace
+
+NrFft::NrFft() : NrFft(SelectBackend()) {}
+
+NrFft::NrFft(RealFft::Backend backend)
+    : fft_(RealFft::Create(kFftSize, backend)) {}
+
 void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
                 rtc::ArrayView<float, kFftSize> real,
                 rtc::ArrayView<float, kFftSize> imag) {
-  WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
-              tables_.data());
+  fft_->Forward(time_data);
 
   imag[0] = 0;
   real[0] = time_data[0];
@@ -51,8 +57,7 @@ void NrFft::Ifft(rtc::ArrayView<const float> real,
     time_data[2 * i] = real[i];
     time_data[2 * i + 1] = imag[i];
   }
-  WebRtc_rdft(kFftSize, -1, time_data.data(), bit_reversal_state_.data(),
-              tables_.data());
+  fft_->Inverse(time_data);
 
   // Scale the output
   constexpr float kScaling = 2.f / kFftSize;
@@ -11,17 +11,22 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 
-#include <vector>
+#include <memory>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
+#include "modules/audio_processing/utility/real_fft.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
 // Wrapper class providing 256 point FFT functionality.
 class NrFft {
  public:
+  // Uses the PFFFT backend when it is SIMD optimized, unless disabled via the
+  // WebRTC-NsPffftKillSwitch field trial, and the Ooura backend otherwise.
   NrFft();
+  explicit NrFft(RealFft::Backend backend);
   NrFft(const NrFft&) = delete;
   NrFft& operator=(const NrFft&) = delete;
 
@@ -35,9 +40,10 @@ class NrFft {
             rtc::ArrayView<const float> imag,
             rtc::ArrayView<float> time_data);
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(fft_); }
+
  private:
-  std::vector<size_t> bit_reversal_state_;
-  std::vector<float> tables_;
+  const std::unique_ptr<RealFft> fft_;
 };
 
 }  // namespace webrtc
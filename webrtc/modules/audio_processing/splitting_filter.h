@@ -17,6 +17,7 @@
 
 #include "common_audio/channel_buffer.h"
 #include "modules/audio_processing/three_band_filter_bank.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -50,6 +51,12 @@ class SplittingFilter {
   void Analysis(const ChannelBuffer<float>* data, ChannelBuffer<float>* bands);
   void Synthesis(const ChannelBuffer<float>* bands, ChannelBuffer<float>* data);
 
+  // Returns the size of the filter and of its states.
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(two_bands_states_) +
+           HeapBytes(three_band_filter_banks_);
+  }
+
  private:
   // Two-band analysis and synthesis work for 640 samples or less.
   void TwoBandsAnalysis(const ChannelBuffer<float>* data,
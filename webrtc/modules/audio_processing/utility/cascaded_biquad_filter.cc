@@ -9,11 +9,41 @@
  */
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+constexpr size_t kNumPipelinedBiQuads = 4;
+
+#if (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)) || \
+    defined(WEBRTC_HAS_NEON)
+// Copies the states x[0], x[1], y[0] and y[1], stored lane by lane, back to
+// the pipelined biquads.
+void StorePipelineStates(const float states[4][kNumPipelinedBiQuads],
+                         CascadedBiQuadFilter::BiQuad* biquads) {
+  for (size_t k = 0; k < kNumPipelinedBiQuads; ++k) {
+    biquads[k].x[0] = states[0][k];
+    biquads[k].x[1] = states[1][k];
+    biquads[k].y[0] = states[2][k];
+    biquads[k].y[1] = states[3][k];
+  }
+}
+#endif
+
+}  // namespace
 
 CascadedBiQuadFilter::BiQuadParam::BiQuadParam(std::complex<float> zero,
                                                std::complex<float> pole,
@@ -73,19 +103,28 @@ CascadedBiQuadFilter::~CascadedBiQuadFilter() = default;
 
 void CascadedBiQuadFilter::Process(rtc::ArrayView<const float> x,
                                    rtc::ArrayView<float> y) {
-  if (biquads_.size() > 0) {
-    ApplyBiQuad(x, y, &biquads_[0]);
-    for (size_t k = 1; k < biquads_.size(); ++k) {
-      ApplyBiQuad(y, y, &biquads_[k]);
-    }
-  } else {
+  if (biquads_.empty()) {
     std::copy(x.begin(), x.end(), y.begin());
+    return;
+  }
+
+  rtc::ArrayView<const float> input = x;
+  size_t k = 0;
+  while (k < biquads_.size()) {
+    if (k + kNumPipelinedBiQuads <= biquads_.size()) {
+      ApplyBiQuadPipeline(input, y, &biquads_[k]);
+      k += kNumPipelinedBiQuads;
+    } else {
+      ApplyBiQuad(input, y, &biquads_[k]);
+      ++k;
+    }
+    input = y;
   }
 }
 
 void CascadedBiQuadFilter::Process(rtc::ArrayView<float> y) {
-  for (auto& biquad : biquads_) {
-    ApplyBiQuad(y, y, &biquad);
+  if (!biquads_.empty()) {
+    Process(y, y);
   }
 }
 
@@ -123,4 +162,160 @@ void CascadedBiQuadFilter::ApplyBiQuad(rtc::ArrayView<const float> x,
   biquad->y[1] = m_y_1;
 }
 
+// Lane k of the SIMD registers holds biquad k, which in step t works on sample
+// t - k. The output of each biquad is passed on to the next lane for the next
+// step. During the first and last three steps, the lanes without a valid
+// sample keep their states. The operations are the same, and in the same
+// order, as in ApplyBiQuad, which makes the output bit-exact.
+void CascadedBiQuadFilter::ApplyBiQuadPipeline(
+    rtc::ArrayView<const float> x,
+    rtc::ArrayView<float> y,
+    CascadedBiQuadFilter::BiQuad* biquads) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  const BiQuad* b = biquads;
+  const size_t num_samples = x.size();
+  const size_t num_steps = num_samples + kNumPipelinedBiQuads - 1;
+  const __m128 c_a_0 =
+      _mm_setr_ps(b[0].coefficients.a[0], b[1].coefficients.a[0],
+                  b[2].coefficients.a[0], b[3].coefficients.a[0]);
+  const __m128 c_a_1 =
+      _mm_setr_ps(b[0].coefficients.a[1], b[1].coefficients.a[1],
+                  b[2].coefficients.a[1], b[3].coefficients.a[1]);
+  const __m128 c_b_0 =
+      _mm_setr_ps(b[0].coefficients.b[0], b[1].coefficients.b[0],
+                  b[2].coefficients.b[0], b[3].coefficients.b[0]);
+  const __m128 c_b_1 =
+      _mm_setr_ps(b[0].coefficients.b[1], b[1].coefficients.b[1],
+                  b[2].coefficients.b[1], b[3].coefficients.b[1]);
+  const __m128 c_b_2 =
+      _mm_setr_ps(b[0].coefficients.b[2], b[1].coefficients.b[2],
+                  b[2].coefficients.b[2], b[3].coefficients.b[2]);
+  __m128 m_x_0 = _mm_setr_ps(b[0].x[0], b[1].x[0], b[2].x[0], b[3].x[0]);
+  __m128 m_x_1 = _mm_setr_ps(b[0].x[1], b[1].x[1], b[2].x[1], b[3].x[1]);
+  __m128 m_y_0 = _mm_setr_ps(b[0].y[0], b[1].y[0], b[2].y[0], b[3].y[0]);
+  __m128 m_y_1 = _mm_setr_ps(b[0].y[1], b[1].y[1], b[2].y[1], b[3].y[1]);
+  const __m128 lane_index = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+
+  __m128 tmp = _mm_setzero_ps();
+  for (size_t t = 0; t < num_steps; ++t) {
+    tmp = _mm_move_ss(tmp, _mm_set_ss(t < num_samples ? x[t] : 0.f));
+    __m128 out = _mm_mul_ps(c_b_0, tmp);
+    out = _mm_add_ps(out, _mm_mul_ps(c_b_1, m_x_0));
+    out = _mm_add_ps(out, _mm_mul_ps(c_b_2, m_x_1));
+    out = _mm_sub_ps(out, _mm_mul_ps(c_a_0, m_y_0));
+    out = _mm_sub_ps(out, _mm_mul_ps(c_a_1, m_y_1));
+
+    if (t + 1 < kNumPipelinedBiQuads || t >= num_samples) {
+      // Lane k is active if t - num_samples < k <= t.
+      const float step = static_cast<float>(t);
+      const float min_lane = step - static_cast<float>(num_samples);
+      const __m128 active =
+          _mm_and_ps(_mm_cmple_ps(lane_index, _mm_set1_ps(step)),
+                     _mm_cmpgt_ps(lane_index, _mm_set1_ps(min_lane)));
+      const auto select = [&active](__m128 on, __m128 off) {
+        return _mm_or_ps(_mm_and_ps(active, on), _mm_andnot_ps(active, off));
+      };
+      m_x_1 = select(m_x_0, m_x_1);
+      m_x_0 = select(tmp, m_x_0);
+      m_y_1 = select(m_y_0, m_y_1);
+      m_y_0 = select(out, m_y_0);
+    } else {
+      m_x_1 = m_x_0;
+      m_x_0 = tmp;
+      m_y_1 = m_y_0;
+      m_y_0 = out;
+    }
+
+    if (t + 1 >= kNumPipelinedBiQuads) {
+      y[t + 1 - kNumPipelinedBiQuads] =
+          _mm_cvtss_f32(_mm_shuffle_ps(out, out, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    tmp = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(out), 4));
+  }
+
+  float states[4][kNumPipelinedBiQuads];
+  _mm_storeu_ps(states[0], m_x_0);
+  _mm_storeu_ps(states[1], m_x_1);
+  _mm_storeu_ps(states[2], m_y_0);
+  _mm_storeu_ps(states[3], m_y_1);
+  StorePipelineStates(states, biquads);
+#elif defined(WEBRTC_HAS_NEON)
+  const BiQuad* b = biquads;
+  const size_t num_samples = x.size();
+  const size_t num_steps = num_samples + kNumPipelinedBiQuads - 1;
+  const float a_0[4] = {b[0].coefficients.a[0], b[1].coefficients.a[0],
+                        b[2].coefficients.a[0], b[3].coefficients.a[0]};
+  const float a_1[4] = {b[0].coefficients.a[1], b[1].coefficients.a[1],
+                        b[2].coefficients.a[1], b[3].coefficients.a[1]};
+  const float b_0[4] = {b[0].coefficients.b[0], b[1].coefficients.b[0],
+                        b[2].coefficients.b[0], b[3].coefficients.b[0]};
+  const float b_1[4] = {b[0].coefficients.b[1], b[1].coefficients.b[1],
+                        b[2].coefficients.b[1], b[3].coefficients.b[1]};
+  const float b_2[4] = {b[0].coefficients.b[2], b[1].coefficients.b[2],
+                        b[2].coefficients.b[2], b[3].coefficients.b[2]};
+  const float x_0[4] = {b[0].x[0], b[1].x[0], b[2].x[0], b[3].x[0]};
+  const float x_1[4] = {b[0].x[1], b[1].x[1], b[2].x[1], b[3].x[1]};
+  const float y_0[4] = {b[0].y[0], b[1].y[0], b[2].y[0], b[3].y[0]};
+  const float y_1[4] = {b[0].y[1], b[1].y[1], b[2].y[1], b[3].y[1]};
+  const float index[4] = {0.f, 1.f, 2.f, 3.f};
+  const float32x4_t c_a_0 = vld1q_f32(a_0);
+  const float32x4_t c_a_1 = vld1q_f32(a_1);
+  const float32x4_t c_b_0 = vld1q_f32(b_0);
+  const float32x4_t c_b_1 = vld1q_f32(b_1);
+  const float32x4_t c_b_2 = vld1q_f32(b_2);
+  float32x4_t m_x_0 = vld1q_f32(x_0);
+  float32x4_t m_x_1 = vld1q_f32(x_1);
+  float32x4_t m_y_0 = vld1q_f32(y_0);
+  float32x4_t m_y_1 = vld1q_f32(y_1);
+  const float32x4_t lane_index = vld1q_f32(index);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+
+  float32x4_t tmp = zero;
+  for (size_t t = 0; t < num_steps; ++t) {
+    tmp = vsetq_lane_f32(t < num_samples ? x[t] : 0.f, tmp, 0);
+    float32x4_t out = vmulq_f32(c_b_0, tmp);
+    out = vaddq_f32(out, vmulq_f32(c_b_1, m_x_0));
+    out = vaddq_f32(out, vmulq_f32(c_b_2, m_x_1));
+    out = vsubq_f32(out, vmulq_f32(c_a_0, m_y_0));
+    out = vsubq_f32(out, vmulq_f32(c_a_1, m_y_1));
+
+    if (t + 1 < kNumPipelinedBiQuads || t >= num_samples) {
+      // Lane k is active if t - num_samples < k <= t.
+      const float step = static_cast<float>(t);
+      const float min_lane = step - static_cast<float>(num_samples);
+      const uint32x4_t active =
+          vandq_u32(vcleq_f32(lane_index, vdupq_n_f32(step)),
+                    vcgtq_f32(lane_index, vdupq_n_f32(min_lane)));
+      m_x_1 = vbslq_f32(active, m_x_0, m_x_1);
+      m_x_0 = vbslq_f32(active, tmp, m_x_0);
+      m_y_1 = vbslq_f32(active, m_y_0, m_y_1);
+      m_y_0 = vbslq_f32(active, out, m_y_0);
+    } else {
+      m_x_1 = m_x_0;
+      m_x_0 = tmp;
+      m_y_1 = m_y_0;
+      m_y_0 = out;
+    }
+
+    if (t + 1 >= kNumPipelinedBiQuads) {
+      y[t + 1 - kNumPipelinedBiQuads] = vgetq_lane_f32(out, 3);
+    }
+    tmp = vextq_f32(zero, out, 3);
+  }
+
+  float states[4][kNumPipelinedBiQuads];
+  vst1q_f32(states[0], m_x_0);
+  vst1q_f32(states[1], m_x_1);
+  vst1q_f32(states[2], m_y_0);
+  vst1q_f32(states[3], m_y_1);
+  StorePipelineStates(states, biquads);
+#else
+  // Without SIMD, the biquads are applied one after the other.
+  for (size_t k = 0; k < kNumPipelinedBiQuads; ++k) {
+    ApplyBiQuad(k == 0 ? x : rtc::ArrayView<const float>(y), y, &biquads[k]);
+  }
+#endif
+}
+
 }  // namespace webrtc
@@ -17,11 +17,14 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
 // Applies a number of biquads in a cascaded manner. The filter implementation
-// is direct form 1.
+// is direct form 1. Where SIMD is available, groups of four consecutive
+// biquads are run as a pipeline in the SIMD lanes, with each biquad working on
+// the sample that the previous one produced in the step before.
 class CascadedBiQuadFilter {
  public:
   struct BiQuadParam {
@@ -67,10 +70,16 @@ class CascadedBiQuadFilter {
   // Resets the filter to its initial state.
   void Reset();
 
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(biquads_); }
+
  private:
   void ApplyBiQuad(rtc::ArrayView<const float> x,
                    rtc::ArrayView<float> y,
                    CascadedBiQuadFilter::BiQuad* biquad);
+  // Applies four consecutive biquads, starting with `biquads[0]`.
+  void ApplyBiQuadPipeline(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y,
+                           CascadedBiQuadFilter::BiQuad* biquads);
 
   std::vector<BiQuad> biquads_;
 };
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/multi_channel_cascaded_biquad_filter.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumLanes = 4;
+
+// Number of frames that are interleaved and filtered in one pass.
+constexpr size_t kChunkSize = 32;
+
+// Pointers to the states of the first channel of a group, for one biquad.
+struct GroupState {
+  float* x0;
+  float* x1;
+  float* y0;
+  float* y1;
+};
+
+// Applies one biquad in an in-place manner on `num_frames` frames of
+// `kNumVectors` * 4 interleaved channels. The operations are done in the same
+// order as in CascadedBiQuadFilter, which makes the output bit-exact.
+template <int kNumVectors>
+void FilterInterleaved(const CascadedBiQuadFilter::BiQuadCoefficients& c,
+                       const GroupState& state,
+                       size_t num_frames,
+                       float* data) {
+  constexpr int kGroupSize = kNumLanes * kNumVectors;
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  const __m128 c_b_0 = _mm_set1_ps(c.b[0]);
+  const __m128 c_b_1 = _mm_set1_ps(c.b[1]);
+  const __m128 c_b_2 = _mm_set1_ps(c.b[2]);
+  const __m128 c_a_0 = _mm_set1_ps(c.a[0]);
+  const __m128 c_a_1 = _mm_set1_ps(c.a[1]);
+  __m128 m_x_0[kNumVectors];
+  __m128 m_x_1[kNumVectors];
+  __m128 m_y_0[kNumVectors];
+  __m128 m_y_1[kNumVectors];
+  for (int v = 0; v < kNumVectors; ++v) {
+    m_x_0[v] = _mm_loadu_ps(&state.x0[kNumLanes * v]);
+    m_x_1[v] = _mm_loadu_ps(&state.x1[kNumLanes * v]);
+    m_y_0[v] = _mm_loadu_ps(&state.y0[kNumLanes * v]);
+    m_y_1[v] = _mm_loadu_ps(&state.y1[kNumLanes * v]);
+  }
+  for (size_t k = 0; k < num_frames; ++k) {
+    float* frame = &data[k * kGroupSize];
+    for (int v = 0; v < kNumVectors; ++v) {
+      const __m128 tmp = _mm_load_ps(&frame[kNumLanes * v]);
+      __m128 y = _mm_mul_ps(c_b_0, tmp);
+      y = _mm_add_ps(y, _mm_mul_ps(c_b_1, m_x_0[v]));
+      y = _mm_add_ps(y, _mm_mul_ps(c_b_2, m_x_1[v]));
+      y = _mm_sub_ps(y, _mm_mul_ps(c_a_0, m_y_0[v]));
+      y = _mm_sub_ps(y, _mm_mul_ps(c_a_1, m_y_1[v]));
+      _mm_store_ps(&frame[kNumLanes * v], y);
+      m_x_1[v] = m_x_0[v];
+      m_x_0[v] = tmp;
+      m_y_1[v] = m_y_0[v];
+      m_y_0[v] = y;
+    }
+  }
+  for (int v = 0; v < kNumVectors; ++v) {
+    _mm_storeu_ps(&state.x0[kNumLanes * v], m_x_0[v]);
+    _mm_storeu_ps(&state.x1[kNumLanes * v], m_x_1[v]);
+    _mm_storeu_ps(&state.y0[kNumLanes * v], m_y_0[v]);
+    _mm_storeu_ps(&state.y1[kNumLanes * v], m_y_1[v]);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  const float32x4_t c_b_0 = vdupq_n_f32(c.b[0]);
+  const float32x4_t c_b_1 = vdupq_n_f32(c.b[1]);
+  const float32x4_t c_b_2 = vdupq_n_f32(c.b[2]);
+  const float32x4_t c_a_0 = vdupq_n_f32(c.a[0]);
+  const float32x4_t c_a_1 = vdupq_n_f32(c.a[1]);
+  float32x4_t m_x_0[kNumVectors];
+  float32x4_t m_x_1[kNumVectors];
+  float32x4_t m_y_0[kNumVectors];
+  float32x4_t m_y_1[kNumVectors];
+  for (int v = 0; v < kNumVectors; ++v) {
+    m_x_0[v] = vld1q_f32(&state.x0[kNumLanes * v]);
+    m_x_1[v] = vld1q_f32(&state.x1[kNumLanes * v]);
+    m_y_0[v] = vld1q_f32(&state.y0[kNumLanes * v]);
+    m_y_1[v] = vld1q_f32(&state.y1[kNumLanes * v]);
+  }
+  for (size_t k = 0; k < num_frames; ++k) {
+    float* frame = &data[k * kGroupSize];
+    for (int v = 0; v < kNumVectors; ++v) {
+      const float32x4_t tmp = vld1q_f32(&frame[kNumLanes * v]);
+      float32x4_t y = vmulq_f32(c_b_0, tmp);
+      y = vaddq_f32(y, vmulq_f32(c_b_1, m_x_0[v]));
+      y = vaddq_f32(y, vmulq_f32(c_b_2, m_x_1[v]));
+      y = vsubq_f32(y, vmulq_f32(c_a_0, m_y_0[v]));
+      y = vsubq_f32(y, vmulq_f32(c_a_1, m_y_1[v]));
+      vst1q_f32(&frame[kNumLanes * v], y);
+      m_x_1[v] = m_x_0[v];
+      m_x_0[v] = tmp;
+      m_y_1[v] = m_y_0[v];
+      m_y_0[v] = y;
+    }
+  }
+  for (int v = 0; v < kNumVectors; ++v) {
+    vst1q_f32(&state.x0[kNumLanes * v], m_x_0[v]);
+    vst1q_f32(&state.x1[kNumLanes * v], m_x_1[v]);
+    vst1q_f32(&state.y0[kNumLanes * v], m_y_0[v]);
+    vst1q_f32(&state.y1[kNumLanes * v], m_y_1[v]);
+  }
+#else
+  for (size_t k = 0; k < num_frames; ++k) {
+    float* frame = &data[k * kGroupSize];
+    for (int ch = 0; ch < kGroupSize; ++ch) {
+      const float tmp = frame[ch];
+      frame[ch] = c.b[0] * tmp + c.b[1] * state.x0[ch] +
+                  c.b[2] * state.x1[ch] - c.a[0] * state.y0[ch] -
+                  c.a[1] * state.y1[ch];
+      state.x1[ch] = state.x0[ch];
+      state.x0[ch] = tmp;
+      state.y1[ch] = state.y0[ch];
+      state.y0[ch] = frame[ch];
+    }
+  }
+#endif
+}
+
+}  // namespace
+
+MultiChannelCascadedBiQuadFilter::MultiChannelCascadedBiQuadFilter(
+    const CascadedBiQuadFilter::BiQuadCoefficients& coefficients,
+    size_t num_biquads,
+    size_t num_channels)
+    : coefficients_(coefficients), num_biquads_(num_biquads) {
+  Reset(num_channels);
+}
+
+MultiChannelCascadedBiQuadFilter::~MultiChannelCascadedBiQuadFilter() =
+    default;
+
+void MultiChannelCascadedBiQuadFilter::Process(
+    rtc::ArrayView<float* const> channels,
+    size_t num_frames) {
+  RTC_DCHECK_EQ(channels.size(), num_channels_);
+  size_t ch = 0;
+  for (; ch + 4 * kNumLanes <= num_channels_; ch += 4 * kNumLanes) {
+    ProcessGroup<4>(channels, ch, num_frames);
+  }
+  for (; ch + 2 * kNumLanes <= num_channels_; ch += 2 * kNumLanes) {
+    ProcessGroup<2>(channels, ch, num_frames);
+  }
+  for (; ch + kNumLanes <= num_channels_; ch += kNumLanes) {
+    ProcessGroup<1>(channels, ch, num_frames);
+  }
+  for (; ch < num_channels_; ++ch) {
+    ProcessChannel(channels[ch], ch, num_frames);
+  }
+}
+
+void MultiChannelCascadedBiQuadFilter::Reset() {
+  std::fill(states_.begin(), states_.end(), 0.f);
+}
+
+void MultiChannelCascadedBiQuadFilter::Reset(size_t num_channels) {
+  num_channels_ = num_channels;
+  states_.assign(num_biquads_ * 4 * num_channels_, 0.f);
+}
+
+template <int kNumVectors>
+void MultiChannelCascadedBiQuadFilter::ProcessGroup(
+    rtc::ArrayView<float* const> channels,
+    size_t first_channel,
+    size_t num_frames) {
+  constexpr size_t kGroupSize = kNumLanes * kNumVectors;
+  alignas(16) float interleaved[kChunkSize * kGroupSize];
+
+  for (size_t start = 0; start < num_frames; start += kChunkSize) {
+    const size_t chunk_size = std::min(kChunkSize, num_frames - start);
+    for (size_t ch = 0; ch < kGroupSize; ++ch) {
+      const float* x = channels[first_channel + ch] + start;
+      for (size_t k = 0; k < chunk_size; ++k) {
+        interleaved[k * kGroupSize + ch] = x[k];
+      }
+    }
+
+    for (size_t biquad = 0; biquad < num_biquads_; ++biquad) {
+      const GroupState state = {State(biquad, 0, first_channel),
+                                State(biquad, 1, first_channel),
+                                State(biquad, 2, first_channel),
+                                State(biquad, 3, first_channel)};
+      FilterInterleaved<kNumVectors>(coefficients_, state, chunk_size,
+                                     interleaved);
+    }
+
+    for (size_t ch = 0; ch < kGroupSize; ++ch) {
+      float* y = channels[first_channel + ch] + start;
+      for (size_t k = 0; k < chunk_size; ++k) {
+        y[k] = interleaved[k * kGroupSize + ch];
+      }
+    }
+  }
+}
+
+void MultiChannelCascadedBiQuadFilter::ProcessChannel(float* channel,
+                                                      size_t channel_index,
+                                                      size_t num_frames) {
+  const CascadedBiQuadFilter::BiQuadCoefficients& c = coefficients_;
+  for (size_t biquad = 0; biquad < num_biquads_; ++biquad) {
+    float* m_x_0 = State(biquad, 0, channel_index);
+    float* m_x_1 = State(biquad, 1, channel_index);
+    float* m_y_0 = State(biquad, 2, channel_index);
+    float* m_y_1 = State(biquad, 3, channel_index);
+    float x0 = *m_x_0;
+    float x1 = *m_x_1;
+    float y0 = *m_y_0;
+    float y1 = *m_y_1;
+    for (size_t k = 0; k < num_frames; ++k) {
+      const float tmp = channel[k];
+      channel[k] =
+          c.b[0] * tmp + c.b[1] * x0 + c.b[2] * x1 - c.a[0] * y0 - c.a[1] * y1;
+      x1 = x0;
+      x0 = tmp;
+      y1 = y0;
+      y0 = channel[k];
+    }
+    *m_x_0 = x0;
+    *m_x_1 = x1;
+    *m_y_0 = y0;
+    *m_y_1 = y1;
+  }
+}
+
+float* MultiChannelCascadedBiQuadFilter::State(size_t biquad,
+                                               size_t state,
+                                               size_t channel) {
+  return &states_[(biquad * 4 + state) * num_channels_ + channel];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_CASCADED_BIQUAD_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_CASCADED_BIQUAD_FILTER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "rtc_base/memory/heap_bytes.h"
+
+namespace webrtc {
+
+// Applies the same cascaded biquads independently to a number of channels.
+// The filter states of groups of up to 16 channels are kept in SIMD lanes and
+// the channels of a group are filtered in lock-step, which avoids the serial
+// dependency of the recursion within each channel. The output is identical to
+// that of one CascadedBiQuadFilter per channel.
+class MultiChannelCascadedBiQuadFilter {
+ public:
+  MultiChannelCascadedBiQuadFilter(
+      const CascadedBiQuadFilter::BiQuadCoefficients& coefficients,
+      size_t num_biquads,
+      size_t num_channels);
+  ~MultiChannelCascadedBiQuadFilter();
+  MultiChannelCascadedBiQuadFilter(const MultiChannelCascadedBiQuadFilter&) =
+      delete;
+  MultiChannelCascadedBiQuadFilter& operator=(
+      const MultiChannelCascadedBiQuadFilter&) = delete;
+
+  // Applies the biquads in an in-place manner on the first `num_frames`
+  // samples of each of the channels.
+  void Process(rtc::ArrayView<float* const> channels, size_t num_frames);
+  // Resets the filter to its initial state.
+  void Reset();
+  // Resets the filter to its initial state and changes the number of channels.
+  void Reset(size_t num_channels);
+
+  size_t num_channels() const { return num_channels_; }
+
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(states_); }
+
+ private:
+  template <int kNumVectors>
+  void ProcessGroup(rtc::ArrayView<float* const> channels,
+                    size_t first_channel,
+                    size_t num_frames);
+  void ProcessChannel(float* channel, size_t channel_index, size_t num_frames);
+  float* State(size_t biquad, size_t state, size_t channel);
+
+  const CascadedBiQuadFilter::BiQuadCoefficients coefficients_;
+  const size_t num_biquads_;
+  size_t num_channels_;
+  // The states x[0], x[1], y[0] and y[1] of each biquad, with the values for
+  // all channels stored contiguously.
+  std::vector<float> states_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_CASCADED_BIQUAD_FILTER_H_
@@ -10,7 +10,10 @@
 
 #include "modules/audio_processing/utility/pffft_wrapper.h"
 
+#include <utility>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/process_wide_cache.h"
 #include "third_party/pffft/src/pffft.h"
 
 namespace webrtc {
@@ -45,9 +48,7 @@ rtc::ArrayView<float> Pffft::FloatBuffer::GetView() {
 Pffft::Pffft(size_t fft_size, FftType fft_type)
     : fft_size_(fft_size),
       fft_type_(fft_type),
-      pffft_status_(pffft_new_setup(
-          fft_size_,
-          fft_type == Pffft::FftType::kReal ? PFFFT_REAL : PFFFT_COMPLEX)),
+      pffft_status_(GetSharedSetup(fft_size_, fft_type_)),
       scratch_buffer_(
           AllocatePffftBuffer(GetBufferSize(fft_size_, fft_type_))) {
   RTC_DCHECK(pffft_status_);
@@ -55,10 +56,13 @@ Pffft::Pffft(size_t fft_size, FftType fft_type)
 }
 
 Pffft::~Pffft() {
-  pffft_destroy_setup(pffft_status_);
   pffft_aligned_free(scratch_buffer_);
 }
 
+size_t Pffft::MemoryUsage() const {
+  return sizeof(*this) + GetBufferSize(fft_size_, fft_type_) * sizeof(float);
+}
+
 bool Pffft::IsValidFftSize(size_t fft_size, FftType fft_type) {
   if (fft_size == 0) {
     return false;
@@ -83,6 +87,15 @@ bool Pffft::IsSimdEnabled() {
   return pffft_simd_size() > 1;
 }
 
+PFFFT_Setup* Pffft::GetSharedSetup(size_t fft_size, FftType fft_type) {
+  static auto* const setups =
+      new ProcessWideCache<std::pair<size_t, FftType>, PFFFT_Setup*>();
+  return setups->GetOrCreate({fft_size, fft_type}, [&] {
+    return pffft_new_setup(
+        fft_size, fft_type == FftType::kReal ? PFFFT_REAL : PFFFT_COMPLEX);
+  });
+}
+
 std::unique_ptr<Pffft::FloatBuffer> Pffft::CreateBuffer() const {
   // Cannot use make_unique from absl because Pffft is the only friend of
   // Pffft::FloatBuffer.
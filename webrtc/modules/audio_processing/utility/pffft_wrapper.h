@@ -21,7 +21,8 @@ struct PFFFT_Setup;
 namespace webrtc {
 
 // Pretty-Fast Fast Fourier Transform (PFFFT) wrapper class.
-// Not thread safe.
+// Not thread safe. The PFFFT setups are immutable and shared by all the
+// instances with the same FFT size and type.
 class Pffft {
  public:
   enum class FftType { kReal, kComplex };
@@ -37,6 +38,10 @@ class Pffft {
     rtc::ArrayView<const float> GetConstView() const;
     rtc::ArrayView<float> GetView();
 
+    size_t MemoryUsage() const {
+      return sizeof(*this) + size_ * sizeof(float);
+    }
+
    private:
     friend class Pffft;
     FloatBuffer(size_t fft_size, FftType fft_type);
@@ -64,9 +69,18 @@ class Pffft {
   // Returns true if SIMD code optimizations are being used.
   static bool IsSimdEnabled();
 
+  // Returns the setup for `fft_size` and `fft_type`. The setups are only read
+  // by the transforms, hence they are created once and shared process-wide,
+  // also with the PFFFT backend of RealFft.
+  static PFFFT_Setup* GetSharedSetup(size_t fft_size, FftType fft_type);
+
   // Creates a buffer of the right size.
   std::unique_ptr<FloatBuffer> CreateBuffer() const;
 
+  // Returns the size of the wrapper, including the scratch buffer but not the
+  // shared setup.
+  size_t MemoryUsage() const;
+
   // TODO(https://crbug.com/webrtc/9577): Overload with rtc::ArrayView args.
   // Computes the forward fast Fourier transform.
   void ForwardTransform(const FloatBuffer& in, FloatBuffer* out, bool ordered);
@@ -85,7 +99,7 @@ class Pffft {
  private:
   const size_t fft_size_;
   const FftType fft_type_;
-  PFFFT_Setup* pffft_status_;
+  PFFFT_Setup* const pffft_status_;
   float* const scratch_buffer_;
 };
 
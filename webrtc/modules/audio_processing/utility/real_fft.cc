@@ -0,0 +1,244 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/real_fft.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
+#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/process_wide_cache.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "third_party/pffft/src/pffft.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kOoura128FftSize = 128;
+
+bool IsPowerOfTwo(size_t n) {
+  return n != 0 && (n & (n - 1)) == 0;
+}
+
+bool IsSse2Available() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return GetCPUInfo(kSSE2) != 0;
+#else
+  return false;
+#endif
+}
+
+// Bit reversal and twiddle factor tables for WebRtc_rdft().
+struct OouraTables {
+  explicit OouraTables(size_t fft_size)
+      : bit_reversal_state(fft_size / 2), twiddles(fft_size / 2) {
+    // Setting bit_reversal_state[0] to 0 makes WebRtc_rdft() initialize the
+    // tables, after which they are only read.
+    bit_reversal_state[0] = 0;
+    std::vector<float> tmp(fft_size, 0.f);
+    WebRtc_rdft(fft_size, 1, tmp.data(), bit_reversal_state.data(),
+                twiddles.data());
+  }
+
+  std::vector<size_t> bit_reversal_state;
+  std::vector<float> twiddles;
+};
+
+// The immutable per-size FFT plans are shared process-wide. The PFFFT setups
+// are those of Pffft.
+const OouraTables* GetSharedOouraTables(size_t fft_size) {
+  static auto* const tables = new ProcessWideCache<size_t, OouraTables>();
+  return &tables->GetOrCreate(fft_size,
+                              [&] { return OouraTables(fft_size); });
+}
+
+const OouraFft* GetSharedOoura128() {
+  static const OouraFft* const ooura_fft = new OouraFft(IsSse2Available());
+  return ooura_fft;
+}
+
+// Ooura backend using the SIMD optimized 128 point implementation when
+// possible and the generic power-of-two WebRtc_rdft() otherwise.
+class OouraRealFft : public RealFft {
+ public:
+  explicit OouraRealFft(size_t fft_size)
+      : fft_size_(fft_size),
+        ooura_128_(fft_size == kOoura128FftSize ? GetSharedOoura128()
+                                                : nullptr),
+        tables_(ooura_128_ ? nullptr : GetSharedOouraTables(fft_size)) {}
+
+  size_t fft_size() const override { return fft_size_; }
+  Backend backend() const override { return Backend::kOoura; }
+  size_t MemoryUsage() const override { return sizeof(*this); }
+
+  void Forward(rtc::ArrayView<float> x) const override {
+    RTC_DCHECK_EQ(fft_size_, x.size());
+    Transform(1, x.data());
+  }
+
+  void Inverse(rtc::ArrayView<float> x) const override {
+    RTC_DCHECK_EQ(fft_size_, x.size());
+    Transform(-1, x.data());
+  }
+
+  void ForwardBatch(rtc::ArrayView<float* const> x) const override {
+    for (float* x_k : x) {
+      Transform(1, x_k);
+    }
+  }
+
+  void InverseBatch(rtc::ArrayView<float* const> x) const override {
+    for (float* x_k : x) {
+      Transform(-1, x_k);
+    }
+  }
+
+ private:
+  void Transform(int sign, float* x) const {
+    RTC_DCHECK(x);
+    if (ooura_128_) {
+      sign > 0 ? ooura_128_->Fft(x) : ooura_128_->InverseFft(x);
+      return;
+    }
+    // WebRtc_rdft() only reads the tables once they have been initialized.
+    WebRtc_rdft(fft_size_, sign, x,
+                const_cast<size_t*>(tables_->bit_reversal_state.data()),
+                const_cast<float*>(tables_->twiddles.data()));
+  }
+
+  const size_t fft_size_;
+  const OouraFft* const ooura_128_;
+  const OouraTables* const tables_;
+};
+
+// PFFFT backend. The ordered PFFFT output has the same packing as Ooura but
+// the opposite sign of the imaginary parts and an inverse transform scaled by
+// N instead of N / 2, which is compensated for when copying the data to and
+// from the aligned work buffer.
+class PffftRealFft : public RealFft {
+ public:
+  explicit PffftRealFft(size_t fft_size)
+      : fft_size_(fft_size),
+        setup_(Pffft::GetSharedSetup(fft_size, Pffft::FftType::kReal)),
+        work_(static_cast<float*>(
+            pffft_aligned_malloc(fft_size * sizeof(float)))),
+        scratch_(static_cast<float*>(
+            pffft_aligned_malloc(fft_size * sizeof(float)))) {
+    RTC_DCHECK(work_);
+    RTC_DCHECK(scratch_);
+  }
+
+  ~PffftRealFft() override {
+    pffft_aligned_free(work_);
+    pffft_aligned_free(scratch_);
+  }
+
+  size_t fft_size() const override { return fft_size_; }
+  Backend backend() const override { return Backend::kPffft; }
+  size_t MemoryUsage() const override {
+    return sizeof(*this) + 2 * fft_size_ * sizeof(float);
+  }
+
+  void Forward(rtc::ArrayView<float> x) const override {
+    RTC_DCHECK_EQ(fft_size_, x.size());
+    Forward(x.data());
+  }
+
+  void Inverse(rtc::ArrayView<float> x) const override {
+    RTC_DCHECK_EQ(fft_size_, x.size());
+    Inverse(x.data());
+  }
+
+  void ForwardBatch(rtc::ArrayView<float* const> x) const override {
+    for (float* x_k : x) {
+      Forward(x_k);
+    }
+  }
+
+  void InverseBatch(rtc::ArrayView<float* const> x) const override {
+    for (float* x_k : x) {
+      Inverse(x_k);
+    }
+  }
+
+ private:
+  void Forward(float* x) const {
+    RTC_DCHECK(x);
+    std::copy(x, x + fft_size_, work_);
+    pffft_transform_ordered(setup_, work_, work_, scratch_, PFFFT_FORWARD);
+    x[0] = work_[0];
+    x[1] = work_[1];
+    for (size_t k = 2; k < fft_size_; k += 2) {
+      x[k] = work_[k];
+      x[k + 1] = -work_[k + 1];
+    }
+  }
+
+  void Inverse(float* x) const {
+    RTC_DCHECK(x);
+    work_[0] = 0.5f * x[0];
+    work_[1] = 0.5f * x[1];
+    for (size_t k = 2; k < fft_size_; k += 2) {
+      work_[k] = 0.5f * x[k];
+      work_[k + 1] = -0.5f * x[k + 1];
+    }
+    pffft_transform_ordered(setup_, work_, work_, scratch_, PFFFT_BACKWARD);
+    std::copy(work_, work_ + fft_size_, x);
+  }
+
+  const size_t fft_size_;
+  PFFFT_Setup* const setup_;
+  float* const work_;
+  float* const scratch_;
+};
+
+}  // namespace
+
+bool RealFft::IsSupported(size_t fft_size, Backend backend) {
+  switch (backend) {
+    case Backend::kOoura:
+      return fft_size >= 4 && IsPowerOfTwo(fft_size);
+    case Backend::kPffft:
+      // The real PFFFT transform requires N = (2^a)*(3^b)*(5^c) with a >= 5.
+      // Only powers of two are used here in order to match the Ooura layout.
+      return fft_size >= 32 && IsPowerOfTwo(fft_size);
+  }
+  return false;
+}
+
+std::unique_ptr<RealFft> RealFft::Create(size_t fft_size, Backend backend) {
+  RTC_CHECK(IsSupported(fft_size, backend));
+  switch (backend) {
+    case Backend::kOoura:
+      return std::make_unique<OouraRealFft>(fft_size);
+    case Backend::kPffft:
+      return std::make_unique<PffftRealFft>(fft_size);
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+void RealFft::ForwardBatch(rtc::ArrayView<float* const> x) const {
+  for (float* x_k : x) {
+    Forward(rtc::ArrayView<float>(x_k, fft_size()));
+  }
+}
+
+void RealFft::InverseBatch(rtc::ArrayView<float* const> x) const {
+  for (float* x_k : x) {
+    Inverse(rtc::ArrayView<float>(x_k, fft_size()));
+  }
+}
+
+}  // namespace webrtc
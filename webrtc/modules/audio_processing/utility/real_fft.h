@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_REAL_FFT_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_REAL_FFT_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Real valued FFT with interchangeable backends.
+//
+// All backends use the packed in-place layout of the Ooura routines: after a
+// forward transform, x[0] holds the DC bin, x[1] the Nyquist bin and
+// x[2 * k], x[2 * k + 1] the real and imaginary parts of bin k, with the sign
+// convention of OouraFft (i.e., the imaginary parts are those of
+// sum_n x[n] * exp(+j * 2 * pi * n * k / N)). The inverse transform takes the
+// same layout and returns the time-domain signal scaled by N / 2.
+//
+// The backend specific plans (twiddle factors, bit reversal tables, PFFFT
+// setups) are immutable and cached process-wide per FFT size, so creating
+// many instances of the same size is cheap. Instances are not thread safe.
+class RealFft {
+ public:
+  enum class Backend { kOoura, kPffft };
+
+  // Returns true if `fft_size` is supported by `backend`.
+  static bool IsSupported(size_t fft_size, Backend backend);
+
+  // Creates an FFT of size `fft_size`, which must be supported by `backend`.
+  static std::unique_ptr<RealFft> Create(size_t fft_size, Backend backend);
+
+  virtual ~RealFft() = default;
+
+  virtual size_t fft_size() const = 0;
+  virtual Backend backend() const = 0;
+
+  // Returns the size of the instance, excluding the shared plans.
+  virtual size_t MemoryUsage() const = 0;
+
+  // Computes the forward transform of `x` in place.
+  virtual void Forward(rtc::ArrayView<float> x) const = 0;
+  // Computes the inverse transform of `x` in place.
+  virtual void Inverse(rtc::ArrayView<float> x) const = 0;
+
+  // Batched versions of the transforms above, each element of `x` pointing to
+  // an `fft_size()` long buffer. Allows transforming all the channels or
+  // blocks of a frame with a single call.
+  virtual void ForwardBatch(rtc::ArrayView<float* const> x) const;
+  virtual void InverseBatch(rtc::ArrayView<float* const> x) const;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_REAL_FFT_H_
@@ -16,6 +16,7 @@
 #include "modules/audio_processing/vad/noise_gmm_tables.h"
 #include "modules/audio_processing/vad/vad_circular_buffer.h"
 #include "modules/audio_processing/vad/voice_gmm_tables.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -108,6 +109,10 @@ int PitchBasedVad::VoicingProbability(const AudioFeatures& features,
   return 0;
 }
 
+size_t PitchBasedVad::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(circular_buffer_);
+}
+
 int PitchBasedVad::UpdatePrior(double p) {
   circular_buffer_->Insert(p);
   if (circular_buffer_->RemoveTransient(kTransientWidthThreshold,
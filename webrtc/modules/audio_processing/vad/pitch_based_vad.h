@@ -37,6 +37,8 @@ class PitchBasedVad {
   //               with the given values. The result are returned in `p`.
   int VoicingProbability(const AudioFeatures& features, double* p_combined);
 
+  size_t MemoryUsage() const;
+
  private:
   int UpdatePrior(double p);
 
@@ -26,6 +26,10 @@ StandaloneVad::~StandaloneVad() {
   WebRtcVad_Free(vad_);
 }
 
+size_t StandaloneVad::MemoryUsage() const {
+  return sizeof(*this) + WebRtcVad_MemoryUsage();
+}
+
 StandaloneVad* StandaloneVad::Create() {
   VadInst* vad = WebRtcVad_Create();
   if (!vad)
@@ -52,6 +52,9 @@ class StandaloneVad {
   // Get the agressiveness of the current VAD.
   int mode() const { return mode_; }
 
+  // Returns the size of the VAD, including the underlying VAD instance.
+  size_t MemoryUsage() const;
+
  private:
   explicit StandaloneVad(VadInst* vad);
 
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/vad/pole_zero_filter.h"
 #include "modules/audio_processing/vad/vad_audio_proc_internal.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 extern "C" {
 #include "modules/audio_coding/codecs/isac/main/source/filter_functions.h"
 #include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
@@ -69,6 +70,11 @@ VadAudioProc::VadAudioProc()
 
 VadAudioProc::~VadAudioProc() {}
 
+size_t VadAudioProc::MemoryUsage() const {
+  return sizeof(*this) + HeapBytes(pitch_analysis_handle_) +
+         HeapBytes(pre_filter_handle_) + HeapBytes(high_pass_filter_);
+}
+
 void VadAudioProc::ResetBuffer() {
   memcpy(audio_buffer_, &audio_buffer_[kNumSamplesToProcess],
          sizeof(audio_buffer_[0]) * kNumPastSignalSamples);
@@ -37,6 +37,9 @@ class VadAudioProc {
 
   static constexpr size_t kDftSize = 512;
 
+  // Returns the size of the feature extractor, including its analysis state.
+  size_t MemoryUsage() const;
+
  private:
   void PitchAnalysis(double* pitch_gains, double* pitch_lags_hz, size_t length);
   void SubframeCorrelation(double* corr,
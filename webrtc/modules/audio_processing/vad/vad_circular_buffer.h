@@ -43,6 +43,11 @@ class VadCircularBuffer {
   // transient and set to zero.
   int RemoveTransient(int width_threshold, double val_threshold);
 
+  // Returns the size of the buffer, including its samples.
+  size_t MemoryUsage() const {
+    return sizeof(*this) + buffer_size_ * sizeof(double);
+  }
+
  private:
   explicit VadCircularBuffer(int buffer_size);
   // Get previous values. |index = 0| corresponds to the most recent
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/vad/pitch_based_vad.h"
 #include "modules/audio_processing/vad/standalone_vad.h"
 #include "modules/audio_processing/vad/vad_audio_proc.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -52,6 +53,12 @@ class VoiceActivityDetector {
   // implementation, although it has a few chunks of delay.
   float last_voice_probability() const { return last_voice_probability_; }
 
+  size_t MemoryUsage() const {
+    return sizeof(*this) + HeapBytes(chunkwise_voice_probabilities_) +
+           HeapBytes(chunkwise_rms_) + HeapBytes(audio_processing_) +
+           HeapBytes(standalone_vad_) + HeapBytes(pitch_based_vad_);
+  }
+
  private:
   // TODO(aluebs): Change these to float.
   std::vector<double> chunkwise_voice_probabilities_;
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_HEAP_BYTES_H_
+#define RTC_BASE_MEMORY_HEAP_BYTES_H_
+
+// Helpers for the memory accounting of objects. A class that owns heap memory
+// reports its footprint, i.e., its own size plus the heap memory it owns, with
+// a `size_t MemoryUsage() const` method, which is typically written as
+//
+//   return sizeof(*this) + HeapBytes(member_a) + HeapBytes(member_b);
+//
+// The allocator overhead is not included. Objects of classes without a
+// MemoryUsage() method are assumed to own no heap memory.
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace webrtc {
+namespace heap_bytes_impl {
+
+template <typename T, typename = void>
+struct HasMemoryUsage : std::false_type {};
+
+template <typename T>
+struct HasMemoryUsage<
+    T,
+    std::void_t<decltype(std::declval<const T&>().MemoryUsage())>>
+    : std::true_type {};
+
+}  // namespace heap_bytes_impl
+
+// Returns the heap memory owned by `x`, not counting `x` itself.
+template <typename T>
+size_t HeapBytes(const T& x);
+template <typename T, typename A>
+size_t HeapBytes(const std::vector<T, A>& x);
+template <typename A>
+size_t HeapBytes(const std::vector<bool, A>& x);
+template <typename T, size_t N>
+size_t HeapBytes(const std::array<T, N>& x);
+template <typename T, typename D>
+size_t HeapBytes(const std::unique_ptr<T, D>& x);
+template <typename T>
+size_t HeapBytes(const std::optional<T>& x);
+
+// Returns the footprint of `x`, i.e., its size plus the heap memory it owns.
+// The footprint of polymorphic objects is that reported by their MemoryUsage()
+// method, which should then be virtual.
+template <typename T>
+size_t MemoryUsageOf(const T& x) {
+  if constexpr (heap_bytes_impl::HasMemoryUsage<T>::value) {
+    return x.MemoryUsage();
+  } else {
+    return sizeof(T) + HeapBytes(x);
+  }
+}
+
+template <typename T>
+size_t HeapBytes(const T& x) {
+  if constexpr (heap_bytes_impl::HasMemoryUsage<T>::value) {
+    return x.MemoryUsage() - sizeof(T);
+  } else {
+    return 0;
+  }
+}
+
+template <typename T, typename A>
+size_t HeapBytes(const std::vector<T, A>& x) {
+  size_t bytes = x.capacity() * sizeof(T);
+  if constexpr (!std::is_trivially_destructible_v<T> ||
+                heap_bytes_impl::HasMemoryUsage<T>::value) {
+    for (const T& element : x) {
+      bytes += HeapBytes(element);
+    }
+  }
+  return bytes;
+}
+
+template <typename A>
+size_t HeapBytes(const std::vector<bool, A>& x) {
+  return (x.capacity() + 7) / 8;
+}
+
+template <typename T, size_t N>
+size_t HeapBytes(const std::array<T, N>& x) {
+  size_t bytes = 0;
+  if constexpr (!std::is_trivially_destructible_v<T> ||
+                heap_bytes_impl::HasMemoryUsage<T>::value) {
+    for (const T& element : x) {
+      bytes += HeapBytes(element);
+    }
+  }
+  return bytes;
+}
+
+template <typename T, typename D>
+size_t HeapBytes(const std::unique_ptr<T, D>& x) {
+  static_assert(!std::is_array_v<T>,
+                "The size of an array must be accounted for by its owner");
+  return x ? MemoryUsageOf(*x) : 0;
+}
+
+template <typename T>
+size_t HeapBytes(const std::optional<T>& x) {
+  return x ? HeapBytes(*x) : 0;
+}
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_HEAP_BYTES_H_
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_PROCESS_WIDE_CACHE_H_
+#define RTC_BASE_MEMORY_PROCESS_WIDE_CACHE_H_
+
+#include <map>
+#include <utility>
+
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Thread-safe map of immutable values, such as FFT setups or filter tables,
+// that are computed on first use and then shared by all the objects needing
+// them. A cache is meant to be a leaked function-local static, i.e.,
+//
+//   static auto* const cache = new ProcessWideCache<Key, Value>();
+//   const Value& value = cache->GetOrCreate(key, [&] { return ...; });
+//
+// Neither the cache nor its values are ever destroyed, since the values may be
+// used until the process exits. Values that own memory not freed by their
+// destructor, e.g., raw pointers, are hence fine too.
+template <typename Key, typename Value>
+class ProcessWideCache {
+ public:
+  ProcessWideCache() = default;
+  ProcessWideCache(const ProcessWideCache&) = delete;
+  ProcessWideCache& operator=(const ProcessWideCache&) = delete;
+
+  // Returns the value for `key`, which `create()` computes if it is not cached
+  // yet. The returned reference stays valid for the lifetime of the process.
+  template <typename Factory>
+  const Value& GetOrCreate(const Key& key, Factory create) {
+    MutexLock lock(&mutex_);
+    auto it = values_.find(key);
+    if (it == values_.end()) {
+      it = values_.emplace(key, create()).first;
+    }
+    return it->second;
+  }
+
+ private:
+  Mutex mutex_;
+  std::map<Key, Value> values_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_PROCESS_WIDE_CACHE_H_
@@ -19,6 +19,7 @@
 
 #include "absl/base/attributes.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/heap_bytes.h"
 
 namespace webrtc {
 
@@ -212,6 +213,10 @@ class SwapQueue {
     return std::atomic_load_explicit(&num_elements_, std::memory_order_acquire);
   }
 
+  // Returns the size of the queue, including the memory owned by its slots.
+  // Must not be called concurrently with Insert() or Remove().
+  size_t MemoryUsage() const { return sizeof(*this) + HeapBytes(queue_); }
+
  private:
   // Verify that the queue slots complies with the ItemVerifier test. This
   // function is not thread-safe and can only be used in the constructors.